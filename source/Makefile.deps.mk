@@ -218,6 +218,7 @@ HAVE_QT5BREW    = $(shell test -e /usr/local/opt/qt5/bin/uic && echo true)
 HAVE_QT6        = $(shell $(PKG_CONFIG) --exists Qt6Core Qt6Gui Qt6Widgets && echo true)
 HAVE_QT6BREW    = $(shell test -e /opt/homebrew/opt/qt6/share/qt/libexec/uic && echo true)
 HAVE_SNDFILE    = $(shell $(PKG_CONFIG) --exists sndfile && echo true)
+HAVE_ZLIB       = $(shell $(PKG_CONFIG) --exists zlib && echo true)
 
 ifeq ($(HAVE_FLUIDSYNTH),true)
 HAVE_FLUIDSYNTH_INSTPATCH = $(shell $(PKG_CONFIG) --atleast-version=2.1.0 fluidsynth && \
@@ -436,6 +437,11 @@ LIBLO_FLAGS = $(shell $(PKG_CONFIG) --cflags liblo)
 LIBLO_LIBS  = $(shell $(PKG_CONFIG) --libs liblo)
 endif
 
+ifeq ($(HAVE_ZLIB),true)
+ZLIB_FLAGS = $(shell $(PKG_CONFIG) --cflags zlib)
+ZLIB_LIBS  = $(shell $(PKG_CONFIG) --libs zlib)
+endif
+
 ifeq ($(HAVE_FFMPEG),true)
 FFMPEG_FLAGS = $(shell $(PKG_CONFIG) --cflags libavcodec libavformat libavutil)
 FFMPEG_LIBS  = $(shell $(PKG_CONFIG) --libs libavcodec libavformat libavutil)
@@ -681,6 +687,7 @@ STATIC_CARLA_PLUGIN_LIBS += $(MAGIC_LIBS)
 STATIC_CARLA_PLUGIN_LIBS += $(RTMEMPOOL_LIBS)
 STATIC_CARLA_PLUGIN_LIBS += $(WATER_LIBS)
 STATIC_CARLA_PLUGIN_LIBS += $(YSFX_LIBS)
+STATIC_CARLA_PLUGIN_LIBS += $(ZLIB_LIBS)
 
 ifeq ($(EXTERNAL_PLUGINS),true)
 ifneq ($(DEBUG),true)
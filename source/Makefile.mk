@@ -238,6 +238,10 @@ ifeq ($(HAVE_YSFX),true)
 BASE_FLAGS += -DHAVE_YSFX
 endif
 
+ifeq ($(HAVE_ZLIB),true)
+BASE_FLAGS += -DHAVE_ZLIB
+endif
+
 ifeq ($(USING_RTAUDIO),true)
 BASE_FLAGS += -DUSING_RTAUDIO
 endif
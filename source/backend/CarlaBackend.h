@@ -287,6 +287,14 @@ static constexpr const uint PLUGIN_OPTION_SEND_PROGRAM_CHANGES = 0x200;
  */
 static constexpr const uint PLUGIN_OPTION_SKIP_SENDING_NOTES = 0x400;
 
+/*!
+ * When forcing a mono effect as stereo, process both channels through the same plugin instance.
+ * The plugin is run once per channel, so this is only meant for plugins without internal DSP state.
+ * Not available for LV2 plugins with event inputs, as their events would be delivered twice.
+ * @see PLUGIN_OPTION_FORCE_STEREO
+ */
+static constexpr const uint PLUGIN_OPTION_FORCE_STEREO_SHARED = 0x800;
+
 /*!
  * Special flag to indicate that plugin options are not yet set.
  * This flag exists because 0x0 as an option value is a valid one, so we need something else to indicate "null-ness".
@@ -1264,7 +1272,23 @@ typedef enum {
      * @a value1   New width
      * @a value2   New height
      */
-    ENGINE_CALLBACK_EMBED_UI_RESIZED = 48
+    ENGINE_CALLBACK_EMBED_UI_RESIZED = 48,
+
+    /*!
+     * An asynchronous project save is in progress.
+     * @a valuef   Progress, from 0.0 to 1.0
+     * @a valueStr Project filename
+     * @see carla_save_project_async()
+     */
+    ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS = 49,
+
+    /*!
+     * An asynchronous project save has finished.
+     * @a value1   1 if the file was written successfully, 0 otherwise
+     * @a valueStr Project filename
+     * @see carla_save_project_async()
+     */
+    ENGINE_CALLBACK_PROJECT_SAVE_FINISHED = 50
 
 } EngineCallbackOpcode;
 
@@ -1555,7 +1579,56 @@ typedef enum {
     /*!
      * Treat loaded plugins as standalone (that is, there is no host UI to manage them)
      */
-    ENGINE_OPTION_PLUGINS_ARE_STANDALONE = 35
+    ENGINE_OPTION_PLUGINS_ARE_STANDALONE = 35,
+
+    /*!
+     * Number of frames of each SFZ sample to keep in memory, with the rest streamed from disk during playback.
+     * Default is 0, which loads samples entirely into memory.
+     */
+    ENGINE_OPTION_SFZ_STREAMING_PRELOAD = 36,
+
+    /*!
+     * Interval in seconds between autosaves of the current project, 0 to disable.
+     * Only plugins that changed since the previous autosave are written, into a journal next to the project.
+     * @see carla_restore_project_autosave()
+     */
+    ENGINE_OPTION_AUTOSAVE_INTERVAL = 37,
+
+    /*!
+     * Minimum size in frames of the sub-blocks used for sample accurate events, 1 for full accuracy.
+     * Events that would split the audio block of a plugin are quantized to this granularity.
+     * Does not apply to plugins with fixed buffers, nor to formats with timestamped parameter changes (VST3 and CLAP).
+     * Default is 32.
+     */
+    ENGINE_OPTION_MIN_SUB_BLOCK_SIZE = 38,
+
+    /*!
+     * Use 64-bit double-precision audio buffers between plugins.
+     * Plugins that support it (VST3 and CLAP) process doubles directly, others are converted at their edges.
+     * Only applies to rack mode, the patchbay graph always uses 32-bit buffers.
+     * Cannot be changed while the engine is running.
+     * Default is false.
+     */
+    ENGINE_OPTION_DOUBLE_PRECISION = 39,
+
+    /*!
+     * Audio file written by the "Offline" driver, as 32-bit float WAV.
+     * Rendering starts when the transport is played and runs as fast as possible, the transport stops once done.
+     * The "Offline" driver only supports rack mode, see ENGINE_PROCESS_MODE_CONTINUOUS_RACK.
+     */
+    ENGINE_OPTION_OFFLINE_RENDER_FILE = 40,
+
+    /*!
+     * Optional Standard MIDI File used as MIDI input of the "Offline" driver.
+     * Control changes in it are also applied to plugin parameters mapped to them.
+     */
+    ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE = 41,
+
+    /*!
+     * Length of the "Offline" driver render in milliseconds.
+     * Default is 0, which renders until the end of the MIDI file.
+     */
+    ENGINE_OPTION_OFFLINE_RENDER_LENGTH = 42
 
 } EngineOption;
 
@@ -7,13 +7,17 @@
 #include "CarlaBackend.h"
 #include "CarlaPlugin.hpp"
 
+class CarlaXmlStreamReader;
+
 namespace water {
 class MemoryOutputStream;
-class XmlDocument;
 }
 
 CARLA_BACKEND_START_NAMESPACE
 
+class CarlaBinaryProjectReader;
+class CarlaBinaryProjectWriter;
+
 // -----------------------------------------------------------------------
 
 /*!
@@ -235,12 +239,20 @@ struct CARLA_API EngineOptions {
 
     uint maxParameters;
     uint uiBridgesTimeout;
+    uint sfzStreamingPreload;
+    uint autosaveInterval;
+    uint minSubBlockSize;
+    bool doublePrecision;
     uint audioBufferSize;
     uint audioSampleRate;
     bool audioTripleBuffer;
     const char* audioDriver;
     const char* audioDevice;
 
+    const char* offlineRenderFile;
+    const char* offlineRenderMidiFile;
+    uint offlineRenderLength;
+
 #ifndef BUILD_BRIDGE
     bool oscEnabled;
     int oscPortTCP;
@@ -788,6 +800,12 @@ protected:
 
 // -----------------------------------------------------------------------
 
+/*!
+ * Parallel task function, called once for each task index.
+ * @see CarlaEngine::runParallelTasks()
+ */
+typedef void (*ParallelTaskFunc)(void* ptr, uint32_t taskIndex);
+
 /*!
  * Carla Engine.
  * @note This is a virtual class for all available engine types available in Carla.
@@ -1058,6 +1076,14 @@ public:
      */
     bool saveProject(const char* filename, bool setAsCurrentProject);
 
+    /*!
+     * Save current project to a file, without waiting for the file to be written.
+     * Plugin states are retrieved right away, while the rest happens in a separate thread.
+     * Progress and completion are reported during idle(),
+     * see ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS and ENGINE_CALLBACK_PROJECT_SAVE_FINISHED.
+     */
+    bool saveProjectAsync(const char* filename, bool setAsCurrentProject);
+
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     /*!
      * Get the currently set project folder.
@@ -1075,6 +1101,12 @@ public:
      * Clear the currently set project filename.
      */
     void clearCurrentProjectFilename() noexcept;
+
+    /*!
+     * Load the latest autosave of a project, and set the project as current.
+     * @see ENGINE_OPTION_AUTOSAVE_INTERVAL
+     */
+    bool restoreProjectAutosave(const char* filename);
 #endif
 
     // -------------------------------------------------------------------
@@ -1105,6 +1137,12 @@ public:
      */
     const EngineOptions& getOptions() const noexcept;
 
+    /*!
+     * Check if the engine passes 64-bit audio buffers between plugins.
+     * @see ENGINE_OPTION_DOUBLE_PRECISION
+     */
+    bool usesDoublePrecision() const noexcept;
+
     /*!
      * Get the current Time information (read-only).
      */
@@ -1129,6 +1167,13 @@ public:
      */
     float getOutputPeak(uint pluginId, bool isLeft) const noexcept;
 
+    /*!
+     * Get a plugin's DSP load statistics over the last second of processed audio.
+     * Loads are a percentage of the audio block duration, @a p99Load is the load 99% of the blocks stay under.
+     * Returns false if the plugin did not process any audio during that time.
+     */
+    bool getPluginProcessTime(uint pluginId, float& meanLoad, float& p99Load, float& maxLoad, uint32_t& blockCount) const noexcept;
+
     // -------------------------------------------------------------------
     // Callback
 
@@ -1257,6 +1302,24 @@ public:
      */
     bool wasActionCanceled() const noexcept;
 
+    /*!
+     * Start the engine worker threads used by runParallelTasks(), if not running yet.
+     * Must be called from the main thread, typically when loading a plugin that can process in parallel.
+     */
+    void startThreadPool();
+
+    /*!
+     * Run @a numTasks tasks in parallel, using the engine worker threads together with the calling one.
+     * Blocks until all tasks are done, must only be called from the audio thread.
+     * Returns false if the worker threads are not available or busy, in which case no task was run.
+     */
+    bool runParallelTasks(ParallelTaskFunc func, void* ptr, uint32_t numTasks) noexcept;
+
+    /*!
+     * Check if the calling thread is one of the engine worker threads.
+     */
+    bool isThreadPoolWorker() const noexcept;
+
     // -------------------------------------------------------------------
     // Options
 
@@ -1283,6 +1346,13 @@ public:
      * Get OSC UDP server path.
      */
     const char* getOscServerPathUDP() const noexcept;
+
+    /*!
+     * Get statistics about parameter changes received over OSC and applied in the audio thread.
+     * Latencies are in microseconds, from receiving a change to applying it.
+     * Returns false if OSC is not available.
+     */
+    bool getOscParameterStats(uint32_t& applied, uint32_t& dropped, uint32_t& lastLatency, uint32_t& maxLatency) const noexcept;
 #endif
 
     // -------------------------------------------------------------------
@@ -1297,8 +1367,11 @@ protected:
     /*!
      * Some internal classes read directly from pData or call protected functions.
      */
+    friend class CarlaEngineAutosave;
     friend class CarlaEngineEventPort;
+    friend class CarlaEngineFlightRecorder;
     friend class CarlaEngineOsc;
+    friend class CarlaEngineProjectSaver;
     friend class CarlaEngineRunner;
     friend class CarlaPluginInstance;
     friend class EngineInternalGraph;
@@ -1335,16 +1408,25 @@ protected:
      */
     void setPluginPeaksRT(uint pluginId, float const inPeaks[2], float const outPeaks[2]) noexcept;
 
+    /*!
+     * Add the time a plugin took to process a block of audio.
+     * @note RT call
+     */
+    void setPluginProcessTimeRT(uint pluginId, uint64_t timeNs, uint32_t frames) noexcept;
+
 public:
     /*!
      * Common save project function for main engine and plugin.
+     * If @a binaryWriter is set, plugin chunks are stored in it instead of the document.
      */
-    void saveProjectInternal(water::MemoryOutputStream& outStrm) const;
+    void saveProjectInternal(water::MemoryOutputStream& outStrm, CarlaBinaryProjectWriter* binaryWriter = nullptr) const;
 
     /*!
      * Common load project function for main engine and plugin.
+     * @a binaryReader is required for documents coming from a binary project file.
      */
-    bool loadProjectInternal(water::XmlDocument& xmlDoc, bool alwaysLoadConnections);
+    bool loadProjectInternal(CarlaXmlStreamReader& xmlReader, bool alwaysLoadConnections,
+                             CarlaBinaryProjectReader* binaryReader = nullptr);
 
 protected:
     // -------------------------------------------------------------------
@@ -40,6 +40,9 @@ CarlaEngine* newJack();
 // Dummy
 CarlaEngine* newDummy();
 
+// Offline
+CarlaEngine* newOffline();
+
 // Bridge
 CarlaEngine* newBridge(const char* audioPoolBaseName,
                        const char* rtClientBaseName,
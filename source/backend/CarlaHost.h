@@ -148,6 +148,78 @@ typedef struct _CarlaPortCountInfo {
 
 } CarlaPortCountInfo;
 
+/*!
+ * Plugin DSP load statistics, over the last second of processed audio.
+ * Loads are a percentage of the audio block duration.
+ * @see carla_get_plugin_process_time_info()
+ */
+typedef struct _CarlaPluginProcessTimeInfo {
+    /*!
+     * Average load.
+     */
+    float meanLoad;
+
+    /*!
+     * Load that 99% of the processed blocks stay under.
+     */
+    float p99Load;
+
+    /*!
+     * Highest load.
+     */
+    float maxLoad;
+
+    /*!
+     * Number of processed blocks these values are based on.
+     */
+    uint32_t blockCount;
+
+} CarlaPluginProcessTimeInfo;
+
+/*!
+ * Statistics about parameter changes received over OSC, since the engine started.
+ * @see carla_get_osc_parameter_stats()
+ */
+typedef struct _CarlaOscParameterStats {
+    /*!
+     * Number of changes applied in the audio thread.
+     */
+    uint32_t applied;
+
+    /*!
+     * Number of changes dropped, because their plugin or parameter no longer exists or stayed busy for too long.
+     */
+    uint32_t dropped;
+
+    /*!
+     * Time between receiving the last applied change and applying it, in microseconds.
+     */
+    uint32_t lastLatency;
+
+    /*!
+     * Highest time between receiving a change and applying it, in microseconds.
+     */
+    uint32_t maxLatency;
+
+} CarlaOscParameterStats;
+
+/*!
+ * Usage of the sample data shared by all SFZ plugins in this process.
+ * @see carla_get_sfzero_sample_store_info()
+ */
+typedef struct _CarlaSFZeroSampleStoreInfo {
+    /*!
+     * Number of samples currently kept in memory.
+     */
+    uint32_t sampleCount;
+
+    /*!
+     * Memory used by those samples, in bytes.
+     */
+    uint64_t memoryUsage;
+
+} CarlaSFZeroSampleStoreInfo;
+
 /*!
  * Parameter information.
  * @see carla_get_parameter_info()
@@ -511,6 +583,28 @@ CARLA_API_EXPORT bool carla_load_project(CarlaHostHandle handle, const char* fil
  */
 CARLA_API_EXPORT bool carla_save_project(CarlaHostHandle handle, const char* filename);
 
+/*!
+ * Save current project to a file, in the background.
+ * Plugin states are retrieved before returning, writing the file happens in a separate thread.
+ * Progress and result are reported via engine callbacks while calling carla_engine_idle().
+ * @see ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS
+ * @see ENGINE_CALLBACK_PROJECT_SAVE_FINISHED
+ */
+CARLA_API_EXPORT bool carla_save_project_async(CarlaHostHandle handle, const char* filename);
+
+/*!
+ * Load the latest autosave of a project file, as if the project itself was loaded.
+ * The project must have been previously saved with ENGINE_OPTION_AUTOSAVE_INTERVAL enabled.
+ */
+CARLA_API_EXPORT bool carla_restore_project_autosave(CarlaHostHandle handle, const char* filename);
+
+/*!
+ * Convert a project file between the XML (*.carxp) and binary (*.carxb) formats.
+ * The direction of the conversion is detected from the contents of @a sourceFilename.
+ * @note Does not require an initialized engine.
+ */
+CARLA_API_EXPORT bool carla_convert_project_file(const char* sourceFilename, const char* targetFilename);
+
 #ifndef BUILD_BRIDGE
 /*!
   * Get the currently set project folder.
@@ -879,6 +973,35 @@ CARLA_API_EXPORT float carla_get_default_parameter_value(CarlaHostHandle handle,
  */
 CARLA_API_EXPORT float carla_get_current_parameter_value(CarlaHostHandle handle, uint pluginId, uint32_t parameterId);
 
+/*!
+ * Get all of a plugin's current parameter values at once.
+ * @param pluginId Plugin
+ * @param values   Array to write the values into
+ * @param maxCount Size of @a values
+ * @return Number of values written
+ */
+CARLA_API_EXPORT uint32_t carla_get_parameter_values(CarlaHostHandle handle, uint pluginId,
+                                                     float* values, uint32_t maxCount);
+
+/*!
+ * Get a plugin's parameter values that changed since a previous call.
+ * @a sequence must be 0 on the first call, in which case all parameters are reported.
+ * It is then updated so it can be passed again on the next call.
+ * If the arrays are too small, the oldest changes are written first and @a sequence is set to the last one written,
+ *  so the rest is returned on the next call.
+ * Arrays should still be big enough for all parameters of the plugin, as changes happening at once
+ *  (like all values on the first call) are missed if they do not fit at all.
+ * Output parameters are reported as well.
+ * @param pluginId Plugin
+ * @param sequence Sequence number from the previous call, updated on return
+ * @param indexes  Array to write the changed parameter indexes into
+ * @param values   Array to write the changed parameter values into
+ * @param maxCount Size of @a indexes and @a values
+ * @return Number of changed parameters written
+ */
+CARLA_API_EXPORT uint32_t carla_get_parameter_value_changes(CarlaHostHandle handle, uint pluginId, uint64_t* sequence,
+                                                            uint32_t* indexes, float* values, uint32_t maxCount);
+
 /*!
  * Get a plugin's internal parameter value.
  * @param pluginId    Plugin
@@ -900,6 +1023,14 @@ CARLA_API_EXPORT uint32_t carla_get_plugin_latency(CarlaHostHandle handle, uint
  */
 CARLA_API_EXPORT const float* carla_get_peak_values(CarlaHostHandle handle, uint pluginId);
 
+/*!
+ * Get the peak values of all plugins at once, 4 per plugin (same layout as carla_get_peak_values).
+ * @param peaks          Array to write the values into, must hold 4 * @a maxPluginCount values
+ * @param maxPluginCount Maximum number of plugins to get peaks for
+ * @return Number of plugins written
+ */
+CARLA_API_EXPORT uint carla_get_all_peak_values(CarlaHostHandle handle, float* peaks, uint maxPluginCount);
+
 /*!
  * Get a plugin's input peak value.
  * @param pluginId Plugin
@@ -914,6 +1045,13 @@ CARLA_API_EXPORT float carla_get_input_peak_value(CarlaHostHandle handle, uint p
  */
 CARLA_API_EXPORT float carla_get_output_peak_value(CarlaHostHandle handle, uint pluginId, bool isLeft);
 
+/*!
+ * Get a plugin's DSP load statistics, as measured by the engine around each process call.
+ * Values are zero if the plugin did not process any audio during the last second.
+ * @param pluginId Plugin
+ */
+CARLA_API_EXPORT const CarlaPluginProcessTimeInfo* carla_get_plugin_process_time_info(CarlaHostHandle handle, uint pluginId);
+
 /*!
  * Render a plugin's inline display.
  * @param pluginId Plugin
@@ -1140,6 +1278,19 @@ CARLA_API_EXPORT const char* carla_get_host_osc_url_tcp(CarlaHostHandle handle);
  */
 CARLA_API_EXPORT const char* carla_get_host_osc_url_udp(CarlaHostHandle handle);
 
+/*!
+ * Get statistics about parameter changes received over OSC.
+ * Values are zero if OSC is not available.
+ */
+CARLA_API_EXPORT const CarlaOscParameterStats* carla_get_osc_parameter_stats(CarlaHostHandle handle);
+
+/*!
+ * Get the usage of the sample data shared by all SFZ plugins.
+ * Samples are shared by the whole process, not only this engine.
+ * Values are zero if SFZ support is not available.
+ */
+CARLA_API_EXPORT const CarlaSFZeroSampleStoreInfo* carla_get_sfzero_sample_store_info(CarlaHostHandle handle);
+
 /*!
  * Initialize NSM (that is, announce ourselves to it).
  * Must be called as early as possible in the program's lifecycle.
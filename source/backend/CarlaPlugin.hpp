@@ -116,6 +116,13 @@ public:
      */
     bool isEnabled() const noexcept;
 
+    /*!
+     * Get the plugin's state revision.
+     * This value changes every time parameters, programs or custom data are modified.
+     * Changes in chunk data are only tracked for plugins that notify them (CLAP mark-dirty, VST2 display updates).
+     */
+    uint32_t getStateRevision() const noexcept;
+
     /*!
      * Get the plugin's internal name.
      * This name is unique within all plugins in an engine.
@@ -287,6 +294,18 @@ public:
      */
     virtual float getParameterValue(uint32_t parameterId) const noexcept;
 
+    /*!
+     * Get the parameter values that changed since @a sequence, writing their indexes and values into the given arrays.
+     * Use 0 as @a sequence on the first call, it is updated to the current one so it can be used on the next call.
+     * Values are compared against the ones from the previous call, so output parameters are included too.
+     * If the arrays are too small, the oldest changes are written first and @a sequence is set to the last one written,
+     *  so the rest is returned on the next call. Arrays should still be big enough for all parameters,
+     *  as changes that happened at once are only split when they do not fit at all, losing the rest of them.
+     * Returns the number of values written.
+     * @note Must be called from the main thread.
+     */
+    uint32_t getParameterValueChanges(uint64_t& sequence, uint32_t* indexes, float* values, uint32_t maxCount) noexcept;
+
     /*!
      * Get the scalepoint @a scalePointId value of the parameter @a parameterId.
      */
@@ -708,6 +727,18 @@ public:
     virtual void process(const float* const* audioIn, float** audioOut,
                          const float* const* cvIn, float** cvOut, uint32_t frames) = 0;
 
+    /*!
+     * Check if the plugin can process 64-bit audio directly, see processDouble().
+     * Only possible for plugins without CV ports, while the engine uses double-precision buffers.
+     */
+    virtual bool canProcessDouble() const noexcept;
+
+    /*!
+     * Plugin process call, 64-bit version.
+     * Only called when canProcessDouble() returns true.
+     */
+    virtual void processDouble(const double* const* audioIn, double** audioOut, uint32_t frames);
+
     /*!
      * Tell the plugin the current buffer size changed.
      */
@@ -11,6 +11,8 @@
 #include "CarlaPlugin.hpp"
 
 #include "CarlaBackendUtils.hpp"
+#include "CarlaBinaryProjectUtils.hpp"
+#include "CarlaMathUtils.hpp"
 #include "ThreadSafeFFTW.hpp"
 
 #include "extra/Base64.hpp"
@@ -282,6 +284,10 @@ static void carla_engine_init_common(const CarlaHostStandalone& standalone, Carl
     engine->setOption(CB::ENGINE_OPTION_MAX_PARAMETERS,        static_cast<int>(standalone.engineOptions.maxParameters),    nullptr);
     engine->setOption(CB::ENGINE_OPTION_RESET_XRUNS,           standalone.engineOptions.resetXruns          ? 1 : 0,        nullptr);
     engine->setOption(CB::ENGINE_OPTION_UI_BRIDGES_TIMEOUT,    static_cast<int>(standalone.engineOptions.uiBridgesTimeout), nullptr);
+    engine->setOption(CB::ENGINE_OPTION_SFZ_STREAMING_PRELOAD, static_cast<int>(standalone.engineOptions.sfzStreamingPreload), nullptr);
+    engine->setOption(CB::ENGINE_OPTION_AUTOSAVE_INTERVAL,     static_cast<int>(standalone.engineOptions.autosaveInterval), nullptr);
+    engine->setOption(CB::ENGINE_OPTION_MIN_SUB_BLOCK_SIZE,    static_cast<int>(standalone.engineOptions.minSubBlockSize),  nullptr);
+    engine->setOption(CB::ENGINE_OPTION_DOUBLE_PRECISION,      standalone.engineOptions.doublePrecision     ? 1 : 0,        nullptr);
     engine->setOption(CB::ENGINE_OPTION_AUDIO_BUFFER_SIZE,     static_cast<int>(standalone.engineOptions.audioBufferSize),  nullptr);
     engine->setOption(CB::ENGINE_OPTION_AUDIO_SAMPLE_RATE,     static_cast<int>(standalone.engineOptions.audioSampleRate),  nullptr);
     engine->setOption(CB::ENGINE_OPTION_AUDIO_TRIPLE_BUFFER,   standalone.engineOptions.audioTripleBuffer   ? 1 : 0,        nullptr);
@@ -292,6 +298,10 @@ static void carla_engine_init_common(const CarlaHostStandalone& standalone, Carl
     if (standalone.engineOptions.audioDevice != nullptr)
         engine->setOption(CB::ENGINE_OPTION_AUDIO_DEVICE,      0, standalone.engineOptions.audioDevice);
 
+    engine->setOption(CB::ENGINE_OPTION_OFFLINE_RENDER_FILE,      0, standalone.engineOptions.offlineRenderFile);
+    engine->setOption(CB::ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE, 0, standalone.engineOptions.offlineRenderMidiFile);
+    engine->setOption(CB::ENGINE_OPTION_OFFLINE_RENDER_LENGTH,    static_cast<int>(standalone.engineOptions.offlineRenderLength), nullptr);
+
     engine->setOption(CB::ENGINE_OPTION_OSC_ENABLED,  standalone.engineOptions.oscEnabled, nullptr);
     engine->setOption(CB::ENGINE_OPTION_OSC_PORT_TCP, standalone.engineOptions.oscPortTCP, nullptr);
     engine->setOption(CB::ENGINE_OPTION_OSC_PORT_UDP, standalone.engineOptions.oscPortUDP, nullptr);
@@ -975,6 +985,49 @@ void carla_set_engine_option(CarlaHostHandle handle, EngineOption option, int va
             CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
             shandle.engineOptions.pluginsAreStandalone = (value != 0);
             break;
+
+        case CB::ENGINE_OPTION_SFZ_STREAMING_PRELOAD:
+            CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+            shandle.engineOptions.sfzStreamingPreload = static_cast<uint>(value);
+            break;
+
+        case CB::ENGINE_OPTION_AUTOSAVE_INTERVAL:
+            CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+            shandle.engineOptions.autosaveInterval = static_cast<uint>(value);
+            break;
+
+        case CB::ENGINE_OPTION_MIN_SUB_BLOCK_SIZE:
+            CARLA_SAFE_ASSERT_RETURN(value >= 1,);
+            shandle.engineOptions.minSubBlockSize = static_cast<uint>(value);
+            break;
+
+        case CB::ENGINE_OPTION_DOUBLE_PRECISION:
+            CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+            shandle.engineOptions.doublePrecision = (value != 0);
+            break;
+
+        case CB::ENGINE_OPTION_OFFLINE_RENDER_FILE:
+            if (shandle.engineOptions.offlineRenderFile != nullptr)
+                delete[] shandle.engineOptions.offlineRenderFile;
+
+            shandle.engineOptions.offlineRenderFile = valueStr != nullptr && valueStr[0] != '\0'
+                                                    ? carla_strdup_safe(valueStr)
+                                                    : nullptr;
+            break;
+
+        case CB::ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE:
+            if (shandle.engineOptions.offlineRenderMidiFile != nullptr)
+                delete[] shandle.engineOptions.offlineRenderMidiFile;
+
+            shandle.engineOptions.offlineRenderMidiFile = valueStr != nullptr && valueStr[0] != '\0'
+                                                        ? carla_strdup_safe(valueStr)
+                                                        : nullptr;
+            break;
+
+        case CB::ENGINE_OPTION_OFFLINE_RENDER_LENGTH:
+            CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+            shandle.engineOptions.offlineRenderLength = static_cast<uint>(value);
+            break;
         }
     }
 
@@ -1030,6 +1083,36 @@ bool carla_save_project(CarlaHostHandle handle, const char* filename)
     return handle->engine->saveProject(filename, true);
 }
 
+bool carla_save_project_async(CarlaHostHandle handle, const char* filename)
+{
+    CARLA_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+    CARLA_SAFE_ASSERT_WITH_LAST_ERROR_RETURN(handle->engine != nullptr, "Engine is not initialized", false);
+
+    carla_debug("carla_save_project_async(%p, \"%s\")", handle, filename);
+
+    return handle->engine->saveProjectAsync(filename, true);
+}
+
+bool carla_restore_project_autosave(CarlaHostHandle handle, const char* filename)
+{
+    CARLA_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+    CARLA_SAFE_ASSERT_WITH_LAST_ERROR_RETURN(handle->engine != nullptr, "Engine is not initialized", false);
+
+    carla_debug("carla_restore_project_autosave(%p, \"%s\")", handle, filename);
+
+    return handle->engine->restoreProjectAutosave(filename);
+}
+
+bool carla_convert_project_file(const char* sourceFilename, const char* targetFilename)
+{
+    CARLA_SAFE_ASSERT_RETURN(sourceFilename != nullptr && sourceFilename[0] != '\0', false);
+    CARLA_SAFE_ASSERT_RETURN(targetFilename != nullptr && targetFilename[0] != '\0', false);
+
+    carla_debug("carla_convert_project_file(\"%s\", \"%s\")", sourceFilename, targetFilename);
+
+    return CARLA_BACKEND_NAMESPACE::convertProjectFile(water::File(sourceFilename), water::File(targetFilename));
+}
+
 #ifndef BUILD_BRIDGE
 const char* carla_get_current_project_folder(CarlaHostHandle handle)
 {
@@ -1941,6 +2024,36 @@ float carla_get_current_parameter_value(CarlaHostHandle handle, uint pluginId, u
     return 0.0f;
 }
 
+uint32_t carla_get_parameter_values(CarlaHostHandle handle, uint pluginId, float* values, uint32_t maxCount)
+{
+    CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, 0);
+    CARLA_SAFE_ASSERT_RETURN(values != nullptr, 0);
+
+    if (const CarlaPluginPtr plugin = handle->engine->getPlugin(pluginId))
+    {
+        const uint32_t count = std::min(plugin->getParameterCount(), maxCount);
+
+        for (uint32_t i=0; i < count; ++i)
+            values[i] = plugin->getParameterValue(i);
+
+        return count;
+    }
+
+    return 0;
+}
+
+uint32_t carla_get_parameter_value_changes(CarlaHostHandle handle, uint pluginId, uint64_t* sequence,
+                                           uint32_t* indexes, float* values, uint32_t maxCount)
+{
+    CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, 0);
+    CARLA_SAFE_ASSERT_RETURN(sequence != nullptr, 0);
+
+    if (const CarlaPluginPtr plugin = handle->engine->getPlugin(pluginId))
+        return plugin->getParameterValueChanges(*sequence, indexes, values, maxCount);
+
+    return 0;
+}
+
 float carla_get_internal_parameter_value(CarlaHostHandle handle, uint pluginId, int32_t parameterId)
 {
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
@@ -1977,6 +2090,19 @@ const float* carla_get_peak_values(CarlaHostHandle handle, uint pluginId)
     return handle->engine->getPeaks(pluginId);
 }
 
+uint carla_get_all_peak_values(CarlaHostHandle handle, float* peaks, uint maxPluginCount)
+{
+    CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, 0);
+    CARLA_SAFE_ASSERT_RETURN(peaks != nullptr, 0);
+
+    const uint count = std::min(handle->engine->getCurrentPluginCount(), maxPluginCount);
+
+    for (uint i=0; i < count; ++i)
+        carla_copyFloats(peaks + i * 4, handle->engine->getPeaks(i), 4);
+
+    return count;
+}
+
 float carla_get_input_peak_value(CarlaHostHandle handle, uint pluginId, bool isLeft)
 {
     CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, 0.0f);
@@ -1991,6 +2117,18 @@ float carla_get_output_peak_value(CarlaHostHandle handle, uint pluginId, bool is
     return handle->engine->getOutputPeak(pluginId, isLeft);
 }
 
+const CarlaPluginProcessTimeInfo* carla_get_plugin_process_time_info(CarlaHostHandle handle, uint pluginId)
+{
+    static CarlaPluginProcessTimeInfo retInfo;
+    carla_zeroStruct(retInfo);
+
+    CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, &retInfo);
+
+    handle->engine->getPluginProcessTime(pluginId, retInfo.meanLoad, retInfo.p99Load, retInfo.maxLoad, retInfo.blockCount);
+
+    return &retInfo;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 CARLA_BACKEND_START_NAMESPACE
@@ -2003,6 +2141,9 @@ const void* carla_render_inline_display_internal(const CarlaPluginPtr& plugin, u
 #ifndef CARLA_PLUGIN_ONLY_BRIDGE
 // defined in CarlaPluginLV2.cpp
 const void* carla_render_inline_display_lv2(const CarlaPluginPtr& plugin, uint32_t width, uint32_t height);
+
+// defined in CarlaPluginSFZero.cpp
+void carla_get_sfzero_sample_store_usage(uint32_t& sampleCount, uint64_t& memoryUsage);
 #endif
 
 CARLA_BACKEND_END_NAMESPACE
@@ -2381,6 +2522,39 @@ const char* carla_get_host_osc_url_udp(CarlaHostHandle handle)
 #endif
 }
 
+const CarlaOscParameterStats* carla_get_osc_parameter_stats(CarlaHostHandle handle)
+{
+    static CarlaOscParameterStats retStats;
+    carla_zeroStruct(retStats);
+
+#if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+    CARLA_SAFE_ASSERT_RETURN(handle->engine != nullptr, &retStats);
+
+    handle->engine->getOscParameterStats(retStats.applied, retStats.dropped, retStats.lastLatency, retStats.maxLatency);
+#else
+    // unused
+    (void)handle;
+#endif
+
+    return &retStats;
+}
+
+const CarlaSFZeroSampleStoreInfo* carla_get_sfzero_sample_store_info(CarlaHostHandle handle)
+{
+    static CarlaSFZeroSampleStoreInfo retInfo;
+    carla_zeroStruct(retInfo);
+
+#ifndef CARLA_PLUGIN_ONLY_BRIDGE
+    // shared by the whole process
+    CB::carla_get_sfzero_sample_store_usage(retInfo.sampleCount, retInfo.memoryUsage);
+#endif
+
+    // unused
+    (void)handle;
+
+    return &retInfo;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 #ifndef CARLA_PLUGIN_BUILD
@@ -2393,6 +2567,8 @@ const char* carla_get_host_osc_url_udp(CarlaHostHandle handle)
 # include "CarlaPipeUtils.cpp"
 # include "CarlaProcessUtils.cpp"
 # include "CarlaStateUtils.cpp"
+# include "CarlaBinaryProjectUtils.cpp"
+# include "CarlaXmlStreamUtils.cpp"
 # include "utils/Information.cpp"
 # include "utils/Windows.cpp"
 #endif /* CARLA_PLUGIN_BUILD */
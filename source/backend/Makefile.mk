@@ -26,6 +26,7 @@ endif
 
 BUILD_CXX_FLAGS += -I. -I.. -I$(CWD) -I$(CWD)/includes -I$(CWD)/modules -I$(CWD)/utils
 BUILD_CXX_FLAGS += $(LIBLO_FLAGS)
+BUILD_CXX_FLAGS += $(ZLIB_FLAGS)
 
 # ---------------------------------------------------------------------------------------------------------------------
 
@@ -14,6 +14,8 @@
 #include "CarlaPlugin.hpp"
 
 #include "CarlaBackendUtils.hpp"
+#include "CarlaBinaryProjectUtils.hpp"
+#include "CarlaXmlStreamUtils.hpp"
 #include "CarlaBinaryUtils.hpp"
 #include "CarlaEngineUtils.hpp"
 #include "CarlaMathUtils.hpp"
@@ -27,7 +29,7 @@
 
 #include "water/files/File.h"
 #include "water/streams/MemoryOutputStream.h"
-#include "water/xml/XmlDocument.h"
+#include "water/text/StringArray.h"
 #include "water/xml/XmlElement.h"
 
 #ifdef CARLA_OS_MAC
@@ -47,7 +49,6 @@ using water::CharPointer_UTF8;
 using water::File;
 using water::MemoryOutputStream;
 using water::StringArray;
-using water::XmlDocument;
 using water::XmlElement;
 
 // #define SFZ_FILES_USING_SFIZZ
@@ -269,6 +270,11 @@ CarlaEngine* CarlaEngine::newDriverByName(const char* const driverName)
         return newDummy();
 #endif
 
+#if !(defined(BUILD_BRIDGE) || defined(CARLA_OS_WASM) || defined(CARLA_PLUGIN_BUILD) || defined(STATIC_PLUGIN_TARGET))
+    if (std::strcmp(driverName, "Offline") == 0)
+        return newOffline();
+#endif
+
 #ifdef USING_RTAUDIO
     // -------------------------------------------------------------------
     // common
@@ -413,6 +419,11 @@ void CarlaEngine::idle() noexcept
     pData->osc.idle();
 #endif
 
+    pData->projectSaver.idle();
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    pData->autosave.idle();
+    pData->flightRecorder.idle();
+#endif
     pData->deletePluginsAsNeeded();
 }
 
@@ -805,12 +816,18 @@ bool CarlaEngine::addPlugin(const BinaryType btype,
     EnginePluginData& pluginData(pData->plugins[id]);
     pluginData.plugin = plugin;
     carla_zeroFloats(pluginData.peaks, 4);
+    pluginData.processTime.reset();
 
    #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (oldPlugin.get() != nullptr)
     {
         CARLA_SAFE_ASSERT(! pData->loadingProject);
 
+       #if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+        // changes queued for the old plugin must not reach its replacement
+        pData->oscParameters.invalidate();
+       #endif
+
         const ScopedRunnerStopper srs(this);
 
         if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
@@ -910,6 +927,7 @@ bool CarlaEngine::removePlugin(const uint id)
     pData->curPluginCount = 0;
     pData->plugins[0].plugin.reset();
     carla_zeroStruct(pData->plugins[0].peaks);
+    pData->plugins[0].processTime.reset();
 #endif
 
     plugin->prepareForDeletion();
@@ -961,6 +979,7 @@ bool CarlaEngine::removeAllPlugins()
 
         pluginData.plugin.reset();
         carla_zeroStruct(pluginData.peaks);
+        pluginData.processTime.reset();
 
         callback(true, true, ENGINE_CALLBACK_PLUGIN_REMOVED, id, 0, 0, 0, 0.0f, nullptr);
         callback(true, false, ENGINE_CALLBACK_IDLE, 0, 0, 0, 0, 0.0f, nullptr);
@@ -1230,7 +1249,7 @@ bool CarlaEngine::loadFile(const char* const filename)
     // -------------------------------------------------------------------
     // NOTE: please keep in sync with carla_get_supported_file_extensions!!
 
-    if (extension == "carxp" || extension == "carxs")
+    if (extension == "carxp" || extension == "carxs" || extension == kCarlaBinaryProjectExtension)
         return loadProject(filename, false);
 
     // -------------------------------------------------------------------
@@ -1393,31 +1412,28 @@ bool CarlaEngine::loadProject(const char* const filename, const bool setAsCurren
     const File file(filename);
     CARLA_SAFE_ASSERT_RETURN_ERR(file.existsAsFile(), "Requested file does not exist or is not a readable file");
 
-    if (setAsCurrentProject)
-    {
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
-        if (pData->currentProjectFilename != filename)
-        {
-            pData->currentProjectFilename = filename;
+    if (setAsCurrentProject)
+        pData->setCurrentProject(filename);
+#endif
 
-            bool found;
-            const size_t r = pData->currentProjectFilename.rfind(CARLA_OS_SEP, &found);
+    if (isBinaryProjectFile(file))
+    {
+        CarlaBinaryProjectReader reader;
+        water::String document;
 
-            if (found)
-            {
-                pData->currentProjectFolder = filename;
-                pData->currentProjectFolder[r] = '\0';
-            }
-            else
-            {
-                pData->currentProjectFolder.clear();
-            }
+        if (! reader.open(file) || ! reader.readDocument(document))
+        {
+            setLastError("Failed to read binary project file");
+            return false;
         }
-#endif
+
+        CarlaXmlStreamReader xmlReader(document.toRawUTF8(), document.getNumBytesAsUTF8());
+        return loadProjectInternal(xmlReader, !setAsCurrentProject, &reader);
     }
 
-    XmlDocument xml(file);
-    return loadProjectInternal(xml, !setAsCurrentProject);
+    CarlaXmlStreamReader xmlReader(file);
+    return loadProjectInternal(xmlReader, !setAsCurrentProject);
 }
 
 bool CarlaEngine::saveProject(const char* const filename, const bool setAsCurrentProject)
@@ -1425,38 +1441,79 @@ bool CarlaEngine::saveProject(const char* const filename, const bool setAsCurren
     CARLA_SAFE_ASSERT_RETURN_ERR(filename != nullptr && filename[0] != '\0', "Invalid filename");
     carla_debug("CarlaEngine::saveProject(\"%s\")", filename);
 
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (setAsCurrentProject)
+        pData->setCurrentProject(filename);
+#endif
+
+    // do not let a previous async save overwrite this one
+    pData->projectSaver.wait();
+
+    MemoryOutputStream out;
+    File file(filename);
+    bool ok;
+
+    if (file.hasFileExtension(kCarlaBinaryProjectExtension))
     {
+        CarlaBinaryProjectWriter writer;
+        saveProjectInternal(out, &writer);
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
-        if (pData->currentProjectFilename != filename)
-        {
-            pData->currentProjectFilename = filename;
+        if (setAsCurrentProject)
+            pData->autosave.markSaved();
+#endif
+        ok = writer.writeToFile(file, out.getData(), out.getDataSize());
+    }
+    else
+    {
+        saveProjectInternal(out);
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+        if (setAsCurrentProject)
+            pData->autosave.markSaved();
+#endif
+        ok = file.replaceWithData(out.getData(), out.getDataSize());
+    }
 
-            bool found;
-            const size_t r = pData->currentProjectFilename.rfind(CARLA_OS_SEP, &found);
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    if (setAsCurrentProject)
+        pData->autosave.finishSaved(ok);
+#endif
 
-            if (found)
-            {
-                pData->currentProjectFolder = filename;
-                pData->currentProjectFolder[r] = '\0';
-            }
-            else
-            {
-                pData->currentProjectFolder.clear();
-            }
-        }
+    if (ok)
+        return true;
+
+    setLastError("Failed to write file");
+    return false;
+}
+
+bool CarlaEngine::saveProjectAsync(const char* const filename, const bool setAsCurrentProject)
+{
+    CARLA_SAFE_ASSERT_RETURN_ERR(filename != nullptr && filename[0] != '\0', "Invalid filename");
+    CARLA_SAFE_ASSERT_RETURN_ERR(! pData->projectSaver.isBusy(), "A project save is still in progress, please wait for it to finish");
+    carla_debug("CarlaEngine::saveProjectAsync(\"%s\")", filename);
+
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    if (setAsCurrentProject)
+        pData->setCurrentProject(filename);
 #endif
-    }
 
-    MemoryOutputStream out;
-    saveProjectInternal(out);
+    const bool binary = File(filename).hasFileExtension(kCarlaBinaryProjectExtension);
 
-    File file(filename);
+    // only copy plugin chunks here, encoding and compression are done by the saver thread
+    CarlaBinaryProjectWriter* const writer = new CarlaBinaryProjectWriter(binary);
 
-    if (file.replaceWithData(out.getData(), out.getDataSize()))
+    MemoryOutputStream out;
+    saveProjectInternal(out, writer);
+
+    if (pData->projectSaver.start(filename, out, writer, binary, setAsCurrentProject))
+    {
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+        if (setAsCurrentProject)
+            pData->autosave.markSaved();
+#endif
         return true;
+    }
 
-    setLastError("Failed to write file");
+    setLastError("Failed to start project save");
     return false;
 }
 
@@ -1477,6 +1534,15 @@ void CarlaEngine::clearCurrentProjectFilename() noexcept
     pData->currentProjectFilename.clear();
     pData->currentProjectFolder.clear();
 }
+
+bool CarlaEngine::restoreProjectAutosave(const char* const filename)
+{
+    CARLA_SAFE_ASSERT_RETURN_ERR(pData->isIdling == 0, "An operation is still being processed, please wait for it to finish");
+    CARLA_SAFE_ASSERT_RETURN_ERR(filename != nullptr && filename[0] != '\0', "Invalid filename");
+    carla_debug("CarlaEngine::restoreProjectAutosave(\"%s\")", filename);
+
+    return CarlaEngineAutosave::restore(this, filename);
+}
 #endif
 
 // -----------------------------------------------------------------------
@@ -1507,6 +1573,12 @@ const EngineOptions& CarlaEngine::getOptions() const noexcept
     return pData->options;
 }
 
+bool CarlaEngine::usesDoublePrecision() const noexcept
+{
+    // only the rack graph has double-precision buffers
+    return pData->options.doublePrecision && pData->options.processMode == ENGINE_PROCESS_MODE_CONTINUOUS_RACK;
+}
+
 EngineTimeInfo CarlaEngine::getTimeInfo() const noexcept
 {
     return pData->timeInfo;
@@ -1572,6 +1644,20 @@ float CarlaEngine::getOutputPeak(const uint pluginId, const bool isLeft) const n
     return pData->plugins[pluginId].peaks[isLeft ? 2 : 3];
 }
 
+// -----------------------------------------------------------------------
+// Information (process time)
+
+bool CarlaEngine::getPluginProcessTime(const uint pluginId,
+                                       float& meanLoad, float& p99Load, float& maxLoad, uint32_t& blockCount) const noexcept
+{
+    meanLoad = p99Load = maxLoad = 0.0f;
+    blockCount = 0;
+
+    CARLA_SAFE_ASSERT_RETURN(pluginId < pData->curPluginCount, false);
+
+    return pData->plugins[pluginId].processTime.getLoads(meanLoad, p99Load, maxLoad, blockCount);
+}
+
 // -----------------------------------------------------------------------
 // Callback
 
@@ -1664,6 +1750,7 @@ void CarlaEngine::callback(const bool sendHost, const bool sendOSC,
                 CarlaPluginPtr plugin = pData->plugins[pluginId].plugin;
                 CARLA_SAFE_ASSERT_BREAK(plugin != nullptr);
 
+                pData->osc.resetUDP();
                 pData->osc.sendPluginInfo(plugin);
                 pData->osc.sendPluginPortCount(plugin);
                 pData->osc.sendPluginDataCount(plugin);
@@ -1696,6 +1783,10 @@ void CarlaEngine::callback(const bool sendHost, const bool sendOSC,
                 break;
             }
 
+            case ENGINE_CALLBACK_PLUGIN_REMOVED:
+                pData->osc.resetUDP();
+                break;
+
             case ENGINE_CALLBACK_IDLE:
                 return;
 
@@ -1824,6 +1915,23 @@ bool CarlaEngine::wasActionCanceled() const noexcept
     return pData->actionCanceled;
 }
 
+void CarlaEngine::startThreadPool()
+{
+    carla_debug("CarlaEngine::startThreadPool()");
+
+    pData->threadPool.start();
+}
+
+bool CarlaEngine::runParallelTasks(const ParallelTaskFunc func, void* const ptr, const uint32_t numTasks) noexcept
+{
+    return pData->threadPool.run(func, ptr, numTasks);
+}
+
+bool CarlaEngine::isThreadPoolWorker() const noexcept
+{
+    return pData->threadPool.isWorkerThread();
+}
+
 // -----------------------------------------------------------------------
 // Global options
 
@@ -1837,8 +1945,11 @@ void CarlaEngine::setOption(const EngineOption option, const int value, const ch
         {
         case ENGINE_OPTION_PROCESS_MODE:
         case ENGINE_OPTION_AUDIO_TRIPLE_BUFFER:
+        case ENGINE_OPTION_DOUBLE_PRECISION:
         case ENGINE_OPTION_AUDIO_DRIVER:
         case ENGINE_OPTION_AUDIO_DEVICE:
+        case ENGINE_OPTION_OFFLINE_RENDER_FILE:
+        case ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE:
             return carla_stderr("CarlaEngine::setOption(%i:%s, %i, \"%s\") - Cannot set this option while engine is running!",
                                 option, EngineOption2Str(option), value, valueStr);
         default:
@@ -2197,6 +2308,49 @@ void CarlaEngine::setOption(const EngineOption option, const int value, const ch
         CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
         pData->options.pluginsAreStandalone = (value != 0);
         break;
+
+    case ENGINE_OPTION_SFZ_STREAMING_PRELOAD:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        pData->options.sfzStreamingPreload = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_AUTOSAVE_INTERVAL:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        pData->options.autosaveInterval = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_MIN_SUB_BLOCK_SIZE:
+        CARLA_SAFE_ASSERT_RETURN(value >= 1,);
+        pData->options.minSubBlockSize = static_cast<uint>(value);
+        break;
+
+    case ENGINE_OPTION_DOUBLE_PRECISION:
+        CARLA_SAFE_ASSERT_RETURN(value == 0 || value == 1,);
+        pData->options.doublePrecision = (value != 0);
+        break;
+
+    case ENGINE_OPTION_OFFLINE_RENDER_FILE:
+        if (pData->options.offlineRenderFile != nullptr)
+            delete[] pData->options.offlineRenderFile;
+
+        pData->options.offlineRenderFile = valueStr != nullptr && valueStr[0] != '\0'
+                                         ? carla_strdup_safe(valueStr)
+                                         : nullptr;
+        break;
+
+    case ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE:
+        if (pData->options.offlineRenderMidiFile != nullptr)
+            delete[] pData->options.offlineRenderMidiFile;
+
+        pData->options.offlineRenderMidiFile = valueStr != nullptr && valueStr[0] != '\0'
+                                             ? carla_strdup_safe(valueStr)
+                                             : nullptr;
+        break;
+
+    case ENGINE_OPTION_OFFLINE_RENDER_LENGTH:
+        CARLA_SAFE_ASSERT_RETURN(value >= 0,);
+        pData->options.offlineRenderLength = static_cast<uint>(value);
+        break;
     }
 }
 
@@ -2230,6 +2384,18 @@ const char* CarlaEngine::getOscServerPathUDP() const noexcept
     return nullptr;
 # endif
 }
+
+bool CarlaEngine::getOscParameterStats(uint32_t& applied, uint32_t& dropped,
+                                       uint32_t& lastLatency, uint32_t& maxLatency) const noexcept
+{
+# ifdef HAVE_LIBLO
+    pData->oscParameters.getStats(applied, dropped, lastLatency, maxLatency);
+    return true;
+# else
+    applied = dropped = lastLatency = maxLatency = 0;
+    return false;
+# endif
+}
 #endif
 
 // -----------------------------------------------------------------------
@@ -2323,7 +2489,15 @@ void CarlaEngine::setPluginPeaksRT(const uint pluginId, float const inPeaks[2],
     pluginData.peaks[3] = outPeaks[1];
 }
 
-void CarlaEngine::saveProjectInternal(water::MemoryOutputStream& outStream) const
+void CarlaEngine::setPluginProcessTimeRT(const uint pluginId, const uint64_t timeNs, const uint32_t frames) noexcept
+{
+    pData->plugins[pluginId].processTime.addRT(timeNs, frames, pData->sampleRate);
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    pData->flightRecorder.addPluginTimeRT(pluginId, timeNs);
+#endif
+}
+
+void CarlaEngine::saveProjectInternal(water::MemoryOutputStream& outStream, CarlaBinaryProjectWriter* const binaryWriter) const
 {
     // send initial prepareForSave first, giving time for bridges to act
     for (uint i=0; i < pData->curPluginCount; ++i)
@@ -2407,7 +2581,7 @@ void CarlaEngine::saveProjectInternal(water::MemoryOutputStream& outStream) cons
             if (plugin->isEnabled())
             {
                 MemoryOutputStream outPlugin(4096), streamPlugin;
-                plugin->getStateSave(false).dumpToMemoryStream(streamPlugin);
+                plugin->getStateSave(false).dumpToMemoryStream(streamPlugin, binaryWriter);
 
                 outPlugin << "\n";
 
@@ -2651,11 +2825,12 @@ static water::String findBinaryInCustomPath(const char* const searchPath, const
     return {};
 }
 
-bool CarlaEngine::loadProjectInternal(water::XmlDocument& xmlDoc, const bool alwaysLoadConnections)
+bool CarlaEngine::loadProjectInternal(CarlaXmlStreamReader& xmlReader, const bool alwaysLoadConnections,
+                                      CarlaBinaryProjectReader* const binaryReader)
 {
-    carla_debug("CarlaEngine::loadProjectInternal(%p, %s) - START", &xmlDoc, bool2str(alwaysLoadConnections));
+    carla_debug("CarlaEngine::loadProjectInternal(%p, %s) - START", &xmlReader, bool2str(alwaysLoadConnections));
 
-    ScopedPointer<XmlElement> xmlElement(xmlDoc.getDocumentElement(true));
+    ScopedPointer<XmlElement> xmlElement(xmlReader.readRootElement());
     CARLA_SAFE_ASSERT_RETURN_ERR(xmlElement != nullptr, "Failed to parse project file");
 
     const water::String& xmlType(xmlElement->getTagName());
@@ -2686,9 +2861,13 @@ bool CarlaEngine::loadProjectInternal(water::XmlDocument& xmlDoc, const bool alw
     const CarlaScopedValueSetter<bool> csvs(pData->loadingProject, true, false);
 #endif
 
-    // completely load file
-    xmlElement = xmlDoc.getDocumentElement(false);
-    CARLA_SAFE_ASSERT_RETURN_ERR(xmlElement != nullptr, "Failed to completely parse project file");
+    // presets are small, load them completely
+    // projects are read one element at a time instead, see below
+    if (isPreset && ! xmlReader.readAllElements(*xmlElement))
+    {
+        setLastError("Failed to completely parse project file");
+        return false;
+    }
 
     if (pData->aboutToClose)
         return true;
@@ -2707,172 +2886,196 @@ bool CarlaEngine::loadProjectInternal(water::XmlDocument& xmlDoc, const bool alw
 #endif
     const bool isPlugin = getType() == kEngineTypePlugin;
 
-    // load engine settings first of all
-    if (XmlElement* const elem = isPreset ? nullptr : xmlElement->getChildByName("EngineSettings"))
+    // presets contain a single plugin state in the root element, handled only once
+    XmlElement* presetElem = isPreset ? xmlElement.get() : nullptr;
+
+    // read all other elements one by one, in the same order as saved
+    // this way plugins are created while the rest of the file is still being parsed
+    for (;;)
     {
-        for (XmlElement* settElem = elem->getFirstChildElement(); settElem != nullptr; settElem = settElem->getNextElement())
-        {
-            const water::String& tag(settElem->getTagName());
-            const water::String  text(settElem->getAllSubText().trim());
+        ScopedPointer<XmlElement> elemPtr(isPreset ? nullptr : xmlReader.readNextElement());
+        XmlElement* const elem = isPreset ? presetElem : elemPtr.get();
 
-            /** some settings might be incorrect or require extra work,
-                so we call setOption rather than modifying them direly */
+        if (elem == nullptr)
+            break;
 
-            int option = -1;
-            int value  = 0;
-            const char* valueStr = nullptr;
+        presetElem = nullptr;
 
-            /**/ if (tag == "ForceStereo")
-            {
-                option = ENGINE_OPTION_FORCE_STEREO;
-                value  = text == "true" ? 1 : 0;
-            }
-            else if (tag == "PreferPluginBridges")
-            {
-                option = ENGINE_OPTION_PREFER_PLUGIN_BRIDGES;
-                value  = text == "true" ? 1 : 0;
-            }
-            else if (tag == "PreferUiBridges")
-            {
-                option = ENGINE_OPTION_PREFER_UI_BRIDGES;
-                value  = text == "true" ? 1 : 0;
-            }
-            else if (tag == "UIsAlwaysOnTop")
-            {
-                option = ENGINE_OPTION_UIS_ALWAYS_ON_TOP;
-                value  = text == "true" ? 1 : 0;
-            }
-            else if (tag == "MaxParameters")
-            {
-                option = ENGINE_OPTION_MAX_PARAMETERS;
-                value  = text.getIntValue();
-            }
-            else if (tag == "UIBridgesTimeout")
-            {
-                option = ENGINE_OPTION_UI_BRIDGES_TIMEOUT;
-                value  = text.getIntValue();
-            }
-            else if (isPlugin)
+        const water::String& tagName(elem->getTagName());
+
+        // load engine settings first of all
+        if (tagName == "EngineSettings" && ! isPreset)
+        {
+            for (XmlElement* settElem = elem->getFirstChildElement(); settElem != nullptr; settElem = settElem->getNextElement())
             {
-                /**/ if (tag == "LADSPA_PATH")
-                {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_LADSPA;
-                    valueStr = text.toRawUTF8();
-                }
-                else if (tag == "DSSI_PATH")
-                {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_DSSI;
-                    valueStr = text.toRawUTF8();
-                }
-                else if (tag == "LV2_PATH")
+                const water::String& tag(settElem->getTagName());
+                const water::String  text(settElem->getAllSubText().trim());
+
+                /** some settings might be incorrect or require extra work,
+                    so we call setOption rather than modifying them direly */
+
+                int option = -1;
+                int value  = 0;
+                const char* valueStr = nullptr;
+
+                /**/ if (tag == "ForceStereo")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_LV2;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_FORCE_STEREO;
+                    value  = text == "true" ? 1 : 0;
                 }
-                else if (tag == "VST2_PATH")
+                else if (tag == "PreferPluginBridges")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_VST2;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_PREFER_PLUGIN_BRIDGES;
+                    value  = text == "true" ? 1 : 0;
                 }
-                else if (tag.equalsIgnoreCase("VST3_PATH"))
+                else if (tag == "PreferUiBridges")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_VST3;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_PREFER_UI_BRIDGES;
+                    value  = text == "true" ? 1 : 0;
                 }
-                else if (tag == "SF2_PATH")
+                else if (tag == "UIsAlwaysOnTop")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_SF2;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_UIS_ALWAYS_ON_TOP;
+                    value  = text == "true" ? 1 : 0;
                 }
-                else if (tag == "SFZ_PATH")
+                else if (tag == "MaxParameters")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_SFZ;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_MAX_PARAMETERS;
+                    value  = text.getIntValue();
                 }
-                else if (tag == "JSFX_PATH")
+                else if (tag == "UIBridgesTimeout")
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_JSFX;
-                    valueStr = text.toRawUTF8();
+                    option = ENGINE_OPTION_UI_BRIDGES_TIMEOUT;
+                    value  = text.getIntValue();
                 }
-                else if (tag == "CLAP_PATH")
+                else if (isPlugin)
                 {
-                    option   = ENGINE_OPTION_PLUGIN_PATH;
-                    value    = PLUGIN_CLAP;
-                    valueStr = text.toRawUTF8();
+                    /**/ if (tag == "LADSPA_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_LADSPA;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "DSSI_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_DSSI;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "LV2_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_LV2;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "VST2_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_VST2;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag.equalsIgnoreCase("VST3_PATH"))
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_VST3;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "SF2_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_SF2;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "SFZ_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_SFZ;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "JSFX_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_JSFX;
+                        valueStr = text.toRawUTF8();
+                    }
+                    else if (tag == "CLAP_PATH")
+                    {
+                        option   = ENGINE_OPTION_PLUGIN_PATH;
+                        value    = PLUGIN_CLAP;
+                        valueStr = text.toRawUTF8();
+                    }
                 }
-            }
 
-            if (option == -1)
-            {
-                // check old stuff, unhandled now
-                if (tag == "GIG_PATH")
-                    continue;
-                // ignored tags
-                if (tag == "LADSPA_PATH" || tag == "DSSI_PATH" || tag == "LV2_PATH" || tag == "VST2_PATH")
-                    continue;
-                if (tag == "VST3_PATH" || tag == "AU_PATH")
-                    continue;
-                if (tag == "SF2_PATH" || tag == "SFZ_PATH" || tag == "JSFX_PATH" || tag == "CLAP_PATH")
+                if (option == -1)
+                {
+                    // check old stuff, unhandled now
+                    if (tag == "GIG_PATH")
+                        continue;
+                    // ignored tags
+                    if (tag == "LADSPA_PATH" || tag == "DSSI_PATH" || tag == "LV2_PATH" || tag == "VST2_PATH")
+                        continue;
+                    if (tag == "VST3_PATH" || tag == "AU_PATH")
+                        continue;
+                    if (tag == "SF2_PATH" || tag == "SFZ_PATH" || tag == "JSFX_PATH" || tag == "CLAP_PATH")
+                        continue;
+
+                    // hmm something is wrong..
+                    carla_stderr2("CarlaEngine::loadProjectInternal() - Unhandled option '%s'", tag.toRawUTF8());
                     continue;
+                }
 
-                // hmm something is wrong..
-                carla_stderr2("CarlaEngine::loadProjectInternal() - Unhandled option '%s'", tag.toRawUTF8());
-                continue;
+                setOption(static_cast<EngineOption>(option), value, valueStr);
             }
 
-            setOption(static_cast<EngineOption>(option), value, valueStr);
-        }
+            if (pData->aboutToClose)
+                return true;
 
-        if (pData->aboutToClose)
-            return true;
+            if (pData->actionCanceled)
+            {
+                setLastError("Project load canceled");
+                return false;
+            }
 
-        if (pData->actionCanceled)
-        {
-            setLastError("Project load canceled");
-            return false;
+            continue;
         }
-    }
 
-    // now setup transport
-    if (XmlElement* const elem = (isPreset || isPlugin) ? nullptr : xmlElement->getChildByName("Transport"))
-    {
-        if (XmlElement* const bpmElem = elem->getChildByName("BeatsPerMinute"))
+        // now setup transport
+        if (tagName == "Transport" && ! (isPreset || isPlugin))
         {
-            const water::String bpmText(bpmElem->getAllSubText().trim());
-            const double bpm = bpmText.getDoubleValue();
+            if (XmlElement* const bpmElem = elem->getChildByName("BeatsPerMinute"))
+            {
+                const water::String bpmText(bpmElem->getAllSubText().trim());
+                const double bpm = bpmText.getDoubleValue();
 
-            // some sane limits
-            if (bpm >= 20.0 && bpm < 400.0)
-                pData->time.setBPM(bpm);
+                // some sane limits
+                if (bpm >= 20.0 && bpm < 400.0)
+                    pData->time.setBPM(bpm);
 
-            if (pData->aboutToClose)
-                return true;
+                if (pData->aboutToClose)
+                    return true;
 
-            if (pData->actionCanceled)
-            {
-                setLastError("Project load canceled");
-                return false;
+                if (pData->actionCanceled)
+                {
+                    setLastError("Project load canceled");
+                    return false;
+                }
             }
+
+            continue;
         }
-    }
 
-    // and we handle plugins
-    for (XmlElement* elem = xmlElement->getFirstChildElement(); elem != nullptr; elem = elem->getNextElement())
-    {
-        const water::String& tagName(elem->getTagName());
+        // positions and connections are handled after all plugins are loaded
+        if (tagName == "Patchbay" || tagName == "ExternalPatchbay")
+        {
+            xmlElement->addChildElement(elemPtr.release());
+            continue;
+        }
 
+        // and we handle plugins
         if (isPreset || tagName == "Plugin")
         {
             CarlaStateSave stateSave;
-            stateSave.fillFromXmlElement(isPreset ? xmlElement.get() : elem);
+            stateSave.fillFromXmlElement(isPreset ? xmlElement.get() : elem, binaryReader);
 
             if (pData->aboutToClose)
                 return true;
@@ -3158,13 +3361,20 @@ bool CarlaEngine::loadProjectInternal(water::XmlDocument& xmlDoc, const bool alw
             if (! isPreset)
                 callback(true, true, ENGINE_CALLBACK_IDLE, 0, 0, 0, 0, 0.0f, nullptr);
         }
+    }
 
-        if (isPreset)
-        {
-            callback(true, true, ENGINE_CALLBACK_PROJECT_LOAD_FINISHED, 0, 0, 0, 0, 0.0f, nullptr);
-            callback(true, true, ENGINE_CALLBACK_CANCELABLE_ACTION, 0, 0, 0, 0, 0.0f, "Loading project");
-            return true;
-        }
+    if (isPreset)
+    {
+        callback(true, true, ENGINE_CALLBACK_PROJECT_LOAD_FINISHED, 0, 0, 0, 0, 0.0f, nullptr);
+        callback(true, true, ENGINE_CALLBACK_CANCELABLE_ACTION, 0, 0, 0, 0, 0.0f, "Loading project");
+        return true;
+    }
+
+    if (const char* const error = xmlReader.getLastError())
+    {
+        carla_stderr2("CarlaEngine::loadProjectInternal() - %s", error);
+        setLastError("Failed to completely parse project file");
+        return false;
     }
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
@@ -3553,7 +3763,7 @@ bool CarlaEngine::loadProjectInternal(water::XmlDocument& xmlDoc, const bool alw
     callback(true, true, ENGINE_CALLBACK_PROJECT_LOAD_FINISHED, 0, 0, 0, 0, 0.0f, nullptr);
     callback(true, true, ENGINE_CALLBACK_CANCELABLE_ACTION, 0, 0, 0, 0, 0.0f, "Loading project");
 
-    carla_debug("CarlaEngine::loadProjectInternal(%p, %s) - END", &xmlDoc, bool2str(alwaysLoadConnections));
+    carla_debug("CarlaEngine::loadProjectInternal(%p, %s) - END", &xmlReader, bool2str(alwaysLoadConnections));
     return true;
 
 #ifdef BUILD_BRIDGE_ALTERNATIVE_ARCH
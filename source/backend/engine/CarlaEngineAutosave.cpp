@@ -0,0 +1,455 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaEngineAutosave.hpp"
+#include "CarlaEngineInternal.hpp"
+#include "CarlaBinaryProjectUtils.hpp"
+#include "CarlaStateUtils.hpp"
+
+#include "extra/Time.hpp"
+
+#include "water/files/File.h"
+#include "water/files/FileInputStream.h"
+#include "water/files/FileOutputStream.h"
+#include "water/memory/MemoryBlock.h"
+#include "water/streams/MemoryOutputStream.h"
+#include "water/xml/XmlDocument.h"
+#include "water/xml/XmlElement.h"
+
+CARLA_BACKEND_START_NAMESPACE
+
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+
+// -----------------------------------------------------------------------
+// journal file layout, all values little-endian:
+//  - 8 byte magic
+//  - per entry: int64 size, plugin state xml
+// entries are matched to plugins by name, which is unique and part of the state, so failed plugin loads do not matter
+
+static const char kJournalMagic[8] = { 'C','A','R','L','A','J','N','L' };
+
+static uint32_t fnv1a(uint32_t hash, const void* const data, const std::size_t size) noexcept
+{
+    const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static uint32_t fnv1a(const uint32_t hash, const char* const str) noexcept
+{
+    return fnv1a(hash, str, std::strlen(str) + 1);
+}
+
+// -----------------------------------------------------------------------
+
+CarlaEngineAutosave::CarlaEngineAutosave(CarlaEngine* const engine) noexcept
+    : kEngine(engine),
+      fProjectFilename(),
+      fPlugins(),
+      fStructureHash(0),
+      fLastTime(0),
+      fNextChunkCheck(0),
+      fValid(false),
+      fHasBase(false)
+{
+    CARLA_SAFE_ASSERT(engine != nullptr);
+}
+
+void CarlaEngineAutosave::idle()
+{
+    CarlaEngine::ProtectedData* const pData = kEngine->pData;
+
+    if (pData->options.autosaveInterval == 0 || pData->currentProjectFilename.isEmpty())
+        return;
+    if (pData->loadingProject || pData->projectSaver.isBusy())
+        return;
+
+    const uint32_t now = d_gettime_ms();
+
+    if (fLastTime == 0)
+    {
+        fLastTime = now;
+        return;
+    }
+
+    if (now - fLastTime < pData->options.autosaveInterval * 1000)
+        return;
+
+    fLastTime = now;
+
+    const water::File projectFile(pData->currentProjectFilename.buffer());
+
+    // a full save is needed if plugins were added, removed or reconnected, or the journal is too big
+    bool needsFullSave = !fValid || fProjectFilename != pData->currentProjectFilename || !hasSameStructure();
+
+    if (! needsFullSave)
+    {
+        const water::File journalFile(getJournalFile(projectFile));
+        const water::File baseFile(fHasBase ? getBaseFile(projectFile) : projectFile);
+
+        needsFullSave = journalFile.getSize() > baseFile.getSize();
+    }
+
+    if (needsFullSave)
+        fValid = saveFull(projectFile);
+    else
+        fValid = saveJournal(projectFile);
+}
+
+void CarlaEngineAutosave::markSaved()
+{
+    recordStates();
+    fProjectFilename = kEngine->pData->currentProjectFilename;
+    fLastTime = d_gettime_ms();
+}
+
+void CarlaEngineAutosave::finishSaved(const bool success)
+{
+    if (! success)
+    {
+        fValid = false;
+        return;
+    }
+
+    const water::File projectFile(fProjectFilename.buffer());
+    getBaseFile(projectFile).deleteFile();
+    getJournalFile(projectFile).deleteFile();
+
+    fValid = true;
+    fHasBase = false;
+}
+
+// -----------------------------------------------------------------------
+
+void CarlaEngineAutosave::recordStates()
+{
+    CarlaEngine::ProtectedData* const pData = kEngine->pData;
+
+    fPlugins.clear();
+
+    for (uint i=0; i < pData->curPluginCount; ++i)
+    {
+        const CarlaPluginPtr plugin = pData->plugins[i].plugin;
+
+        if (plugin.get() == nullptr || ! plugin->isEnabled())
+            continue;
+
+        PluginState state;
+        state.plugin = plugin;
+        state.revision = plugin->getStateRevision();
+        state.chunkHash = getChunkHash(plugin.get());
+        fPlugins.push_back(state);
+    }
+
+    fStructureHash = getStructureHash();
+}
+
+uint32_t CarlaEngineAutosave::getStructureHash() const
+{
+    CarlaEngine::ProtectedData* const pData = kEngine->pData;
+
+    uint32_t hash = 2166136261u;
+
+    // journal entries refer to plugins by name, renaming needs a full save
+    for (uint i=0; i < pData->curPluginCount; ++i)
+    {
+        const CarlaPluginPtr plugin = pData->plugins[i].plugin;
+
+        if (plugin.get() != nullptr && plugin->isEnabled())
+            hash = fnv1a(hash, plugin->getName());
+    }
+
+    const double bpm = pData->timeInfo.bbt.valid ? pData->timeInfo.bbt.beatsPerMinute : 0.0;
+    hash = fnv1a(hash, &bpm, sizeof(bpm));
+
+    if (pData->options.processMode == ENGINE_PROCESS_MODE_PATCHBAY)
+    {
+        if (const char* const* const conns = kEngine->getPatchbayConnections(false))
+            for (int i=0; conns[i] != nullptr; ++i)
+                hash = fnv1a(hash, conns[i]);
+    }
+
+    if (const char* const* const conns = kEngine->getPatchbayConnections(true))
+        for (int i=0; conns[i] != nullptr; ++i)
+            hash = fnv1a(hash, conns[i]);
+
+    return hash;
+}
+
+bool CarlaEngineAutosave::hasSameStructure() const
+{
+    CarlaEngine::ProtectedData* const pData = kEngine->pData;
+
+    std::size_t index = 0;
+
+    for (uint i=0; i < pData->curPluginCount; ++i)
+    {
+        const CarlaPluginPtr plugin = pData->plugins[i].plugin;
+
+        if (plugin.get() == nullptr || ! plugin->isEnabled())
+            continue;
+
+        if (index >= fPlugins.size() || fPlugins[index].plugin.lock() != plugin)
+            return false;
+
+        ++index;
+    }
+
+    return index == fPlugins.size() && fStructureHash == getStructureHash();
+}
+
+// -----------------------------------------------------------------------
+
+bool CarlaEngineAutosave::saveFull(const water::File& projectFile)
+{
+    const water::File baseFile(getBaseFile(projectFile));
+    const water::File journalFile(getJournalFile(projectFile));
+
+    water::MemoryOutputStream out;
+    bool ok;
+
+    // keep binary projects binary, but without compression to be as fast as possible
+    if (projectFile.hasFileExtension(kCarlaBinaryProjectExtension))
+    {
+        CarlaBinaryProjectWriter writer;
+        kEngine->saveProjectInternal(out, &writer);
+        recordStates();
+        ok = writer.writeToFile(baseFile, out.getData(), out.getDataSize());
+    }
+    else
+    {
+        kEngine->saveProjectInternal(out);
+        recordStates();
+        ok = baseFile.replaceWithData(out.getData(), out.getDataSize());
+    }
+
+    if (! ok)
+    {
+        carla_stderr2("CarlaEngineAutosave::saveFull() - failed to write '%s'", baseFile.getFullPathName().toRawUTF8());
+        return false;
+    }
+
+    journalFile.deleteFile();
+
+    fProjectFilename = kEngine->pData->currentProjectFilename;
+    fHasBase = true;
+    return true;
+}
+
+bool CarlaEngineAutosave::saveJournal(const water::File& projectFile)
+{
+    water::MemoryOutputStream entries;
+
+    // chunks can change without any notification, so each autosave also compares the chunk of one plugin,
+    // going through all of them in turn, instead of querying every plugin every time
+    const std::size_t chunkCheckIndex = fPlugins.empty() ? 0 : fNextChunkCheck++ % fPlugins.size();
+
+    for (std::size_t i = 0; i < fPlugins.size(); ++i)
+    {
+        PluginState& state(fPlugins[i]);
+
+        const CarlaPluginPtr plugin = state.plugin.lock();
+        CARLA_SAFE_ASSERT_CONTINUE(plugin.get() != nullptr);
+
+        // same as regular saves, deactivate bridge client-side ping check, since some plugins block during save
+        const bool isBridge = (plugin->getHints() & PLUGIN_IS_BRIDGE) != 0;
+
+        if (isBridge)
+            plugin->setCustomData(CUSTOM_DATA_TYPE_STRING, "__CarlaPingOnOff__", "false", false);
+
+        // some plugins store their state as custom data here, only changed values update the revision
+        plugin->prepareForSave(false);
+
+        const uint32_t revision = plugin->getStateRevision();
+        bool changed = revision != state.revision;
+
+        if (! changed && i == chunkCheckIndex)
+            changed = getChunkHash(plugin.get()) != state.chunkHash;
+
+        if (changed)
+        {
+            water::MemoryOutputStream streamPlugin;
+            plugin->getStateSave(false).dumpToMemoryStream(streamPlugin);
+
+            water::MemoryOutputStream entry;
+            entry << "<Plugin>\n";
+            entry << streamPlugin;
+            entry << "</Plugin>\n";
+
+            entries.writeInt64(static_cast<water::int64>(entry.getDataSize()));
+            entries << entry;
+
+            state.revision = revision;
+            state.chunkHash = getChunkHash(plugin.get());
+        }
+
+        if (isBridge)
+            plugin->setCustomData(CUSTOM_DATA_TYPE_STRING, "__CarlaPingOnOff__", "true", false);
+    }
+
+    if (entries.getDataSize() == 0)
+        return true;
+
+    const water::File journalFile(getJournalFile(projectFile));
+    const bool isNew = ! journalFile.existsAsFile();
+
+    water::FileOutputStream stream(journalFile);
+
+    if (stream.failedToOpen())
+    {
+        carla_stderr2("CarlaEngineAutosave::saveJournal() - failed to open '%s'", journalFile.getFullPathName().toRawUTF8());
+        return false;
+    }
+
+    if ((isNew && ! stream.write(kJournalMagic, sizeof(kJournalMagic))) ||
+        ! stream.write(entries.getData(), entries.getDataSize()))
+    {
+        carla_stderr2("CarlaEngineAutosave::saveJournal() - failed to write '%s'", journalFile.getFullPathName().toRawUTF8());
+        return false;
+    }
+
+    stream.flush();
+    return true;
+}
+
+// -----------------------------------------------------------------------
+
+bool CarlaEngineAutosave::restore(CarlaEngine* const engine, const char* const projectFilename)
+{
+    CARLA_SAFE_ASSERT_RETURN(engine != nullptr, false);
+    CARLA_SAFE_ASSERT_RETURN(projectFilename != nullptr && projectFilename[0] != '\0', false);
+
+    const water::File projectFile(projectFilename);
+    const water::File baseFile(getBaseFile(projectFile));
+    const water::File journalFile(getJournalFile(projectFile));
+
+    if (! baseFile.existsAsFile() && ! journalFile.existsAsFile())
+    {
+        engine->setLastError("No autosave found");
+        return false;
+    }
+
+    const uint pluginOffset = engine->getCurrentPluginCount();
+
+    if (baseFile.existsAsFile())
+    {
+        if (! engine->loadProject(baseFile.getFullPathName().toRawUTF8(), true))
+            return false;
+
+        engine->pData->setCurrentProject(projectFilename);
+    }
+    else
+    {
+        if (! engine->loadProject(projectFilename, true))
+            return false;
+    }
+
+    if (! journalFile.existsAsFile())
+        return true;
+
+    water::FileInputStream stream(journalFile);
+    CARLA_SAFE_ASSERT_RETURN(stream.openedOk(), true);
+
+    char magic[sizeof(kJournalMagic)];
+
+    if (stream.read(magic, sizeof(magic)) != sizeof(magic) || std::memcmp(magic, kJournalMagic, sizeof(magic)) != 0)
+    {
+        carla_stderr2("CarlaEngineAutosave::restore() - invalid journal file, ignored");
+        return true;
+    }
+
+    CarlaStateSave stateSave;
+    water::MemoryBlock data;
+
+    for (;;)
+    {
+        // a crash during write can leave the last entry incomplete, stop there
+        if (stream.getNumBytesRemaining() < 8)
+            break;
+
+        const water::int64 size = stream.readInt64();
+
+        if (size <= 0 || size > stream.getNumBytesRemaining())
+            break;
+
+        data.setSize(static_cast<size_t>(size));
+
+        if (stream.read(data.getData(), static_cast<int>(size)) != static_cast<int>(size))
+            break;
+
+        water::XmlDocument xml(water::String::fromUTF8(static_cast<const char*>(data.getData()), static_cast<int>(size)));
+        ScopedPointer<water::XmlElement> xmlElement(xml.getDocumentElement());
+        CARLA_SAFE_ASSERT_CONTINUE(xmlElement != nullptr);
+
+        if (! stateSave.fillFromXmlElement(xmlElement))
+            continue;
+        CARLA_SAFE_ASSERT_CONTINUE(stateSave.name != nullptr);
+
+        const CarlaPluginPtr plugin = findPluginByName(engine, pluginOffset, stateSave.name);
+
+        if (plugin.get() == nullptr)
+        {
+            carla_stderr2("CarlaEngineAutosave::restore() - plugin '%s' not found, its state was not restored",
+                          stateSave.name);
+            continue;
+        }
+
+        plugin->loadStateSave(stateSave);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------
+
+water::File CarlaEngineAutosave::getBaseFile(const water::File& projectFile)
+{
+    const water::String filename(projectFile.getFileNameWithoutExtension() + ".autosave" + projectFile.getFileExtension());
+    return projectFile.getSiblingFile(filename.toRawUTF8());
+}
+
+water::File CarlaEngineAutosave::getJournalFile(const water::File& projectFile)
+{
+    const water::String filename(projectFile.getFileNameWithoutExtension() + ".autosave.journal");
+    return projectFile.getSiblingFile(filename.toRawUTF8());
+}
+
+CarlaPluginPtr CarlaEngineAutosave::findPluginByName(CarlaEngine* const engine, const uint pluginOffset, const char* const name)
+{
+    for (uint i = pluginOffset, count = engine->getCurrentPluginCount(); i < count; ++i)
+    {
+        const CarlaPluginPtr plugin = engine->getPlugin(i);
+
+        if (plugin.get() != nullptr && std::strcmp(plugin->getName(), name) == 0)
+            return plugin;
+    }
+
+    return CarlaPluginPtr();
+}
+
+uint32_t CarlaEngineAutosave::getChunkHash(CarlaPlugin* const plugin)
+{
+    // chunks can change without any notification, so their contents need to be compared
+    if ((plugin->getOptionsEnabled() & PLUGIN_OPTION_USE_CHUNKS) == 0)
+        return 0;
+
+    void* data = nullptr;
+    const std::size_t dataSize = plugin->getChunkData(&data);
+
+    if (data == nullptr || dataSize == 0)
+        return 0;
+
+    return fnv1a(2166136261u, data, dataSize);
+}
+
+// -----------------------------------------------------------------------
+
+#endif // BUILD_BRIDGE_ALTERNATIVE_ARCH
+
+CARLA_BACKEND_END_NAMESPACE
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_ENGINE_AUTOSAVE_HPP_INCLUDED
+#define CARLA_ENGINE_AUTOSAVE_HPP_INCLUDED
+
+#include "CarlaPlugin.hpp"
+
+#include "extra/String.hpp"
+
+#include <vector>
+
+namespace water {
+class File;
+}
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// CarlaEngineAutosave
+//
+// Periodically saves the current project next to its file, in 2 parts:
+//  - a full project save, written when the plugin list or connections change (<name>.autosave.<ext>)
+//  - a journal of plugin states that changed since then, appended to on every autosave (<name>.autosave.journal)
+//
+// Plugins are considered changed when their state revision differs from the last autosave.
+// Chunk data is not always notified, so it is also compared for one plugin per autosave, in turn.
+// The journal is compacted into a new full save once it grows bigger than the full save itself.
+// Right after a regular project save there is no full autosave, the journal then applies to the project file.
+
+class CarlaEngineAutosave
+{
+public:
+    CarlaEngineAutosave(CarlaEngine* engine) noexcept;
+
+    // autosave if enough time has passed, must be called from the main thread
+    void idle();
+
+    // remember current plugin states as saved, called right after the project document is created
+    void markSaved();
+
+    // called once the project file has been written, deleting old autosave files on success
+    void finishSaved(bool success);
+
+    // load the last full autosave of a project and replay its journal on top
+    static bool restore(CarlaEngine* engine, const char* projectFilename);
+
+private:
+    CarlaEngine* const kEngine;
+
+    struct PluginState {
+        std::weak_ptr<CarlaPlugin> plugin;
+        uint32_t revision;
+        uint32_t chunkHash;
+    };
+
+    String fProjectFilename;
+    std::vector<PluginState> fPlugins;
+    uint32_t fStructureHash;
+    uint32_t fLastTime;
+    std::size_t fNextChunkCheck;
+    bool fValid;   // tracked states match what is on disk
+    bool fHasBase; // full autosave exists, otherwise the journal applies to the project file itself
+
+    void recordStates();
+    uint32_t getStructureHash() const;
+    bool hasSameStructure() const;
+
+    bool saveFull(const water::File& projectFile);
+    bool saveJournal(const water::File& projectFile);
+
+    static water::File getBaseFile(const water::File& projectFile);
+    static water::File getJournalFile(const water::File& projectFile);
+    static CarlaPluginPtr findPluginByName(CarlaEngine* engine, uint pluginOffset, const char* name);
+    static uint32_t getChunkHash(CarlaPlugin* plugin);
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaEngineAutosave)
+};
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_ENGINE_AUTOSAVE_HPP_INCLUDED
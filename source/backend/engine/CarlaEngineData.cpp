@@ -215,11 +215,18 @@ EngineOptions::EngineOptions() noexcept
       uiScale(1.0f),
       maxParameters(MAX_DEFAULT_PARAMETERS),
       uiBridgesTimeout(4000),
+      sfzStreamingPreload(0),
+      autosaveInterval(0),
+      minSubBlockSize(32),
+      doublePrecision(false),
       audioBufferSize(512),
       audioSampleRate(44100),
       audioTripleBuffer(false),
       audioDriver(nullptr),
       audioDevice(nullptr),
+      offlineRenderFile(nullptr),
+      offlineRenderMidiFile(nullptr),
+      offlineRenderLength(0),
 #ifndef BUILD_BRIDGE
 # ifdef CARLA_OS_WIN
       oscEnabled(false),
@@ -263,6 +270,16 @@ EngineOptions::~EngineOptions() noexcept
         delete[] audioDevice;
         audioDevice = nullptr;
     }
+    if (offlineRenderFile != nullptr)
+    {
+        delete[] offlineRenderFile;
+        offlineRenderFile = nullptr;
+    }
+    if (offlineRenderMidiFile != nullptr)
+    {
+        delete[] offlineRenderMidiFile;
+        offlineRenderMidiFile = nullptr;
+    }
     if (pathAudio != nullptr)
     {
         delete[] pathAudio;
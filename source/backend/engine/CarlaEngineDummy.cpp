@@ -218,13 +218,16 @@ protected:
 
             oldTime = d_gettime_us();
 
-            const PendingRtEventsRunner prt(this, bufferSize, true);
+            // keep the sleep below out of the measured cycle
+            {
+                const PendingRtEventsRunner prt(this, bufferSize, true);
 
-            carla_zeroFloats(audioOuts[0], bufferSize);
-            carla_zeroFloats(audioOuts[1], bufferSize);
-            carla_zeroStructs(pData->events.out, kMaxEngineEventInternalCount);
+                carla_zeroFloats(audioOuts[0], bufferSize);
+                carla_zeroFloats(audioOuts[1], bufferSize);
+                carla_zeroStructs(pData->events.out, kMaxEngineEventInternalCount);
 
-            pData->graph.process(pData, audioIns, audioOuts, bufferSize);
+                pData->graph.process(pData, audioIns, audioOuts, bufferSize);
+            }
 
             newTime = d_gettime_us();
             CARLA_SAFE_ASSERT_CONTINUE(newTime >= oldTime);
@@ -234,6 +237,7 @@ protected:
             if (remainingTime <= 0)
             {
                 ++pData->xruns;
+                pData->flightRecorder.xrun();
                 carla_stdout("XRUN! remaining time: " P_INT64 ", old: " P_INT64 ", new: " P_INT64 ")",
                              remainingTime, oldTime, newTime);
             }
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaEngineFlightRecorder.hpp"
+#include "CarlaEngineInternal.hpp"
+#include "CarlaProcessTimeUtils.hpp"
+
+#include "extra/Time.hpp"
+
+#include "water/files/File.h"
+#include "water/streams/MemoryOutputStream.h"
+
+#include <cstdarg>
+
+CARLA_BACKEND_START_NAMESPACE
+
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+
+// -----------------------------------------------------------------------
+
+static const uint32_t kMaxDumpCount    = 16;
+static const uint32_t kMinDumpInterval = 10000; // in milliseconds
+
+static uint16_t countEvents(const EngineEvent* const events) noexcept
+{
+    if (events == nullptr)
+        return 0;
+
+    uint16_t count = 0;
+
+    for (; count < kMaxEngineEventInternalCount; ++count)
+    {
+        if (events[count].type == kEngineEventTypeNull)
+            break;
+    }
+
+    return count;
+}
+
+static void writeFormatted(water::MemoryOutputStream& out, const char* const format, ...) noexcept
+{
+    char strBuf[STR_MAX+1];
+
+    va_list args;
+    va_start(args, format);
+    const int len = std::vsnprintf(strBuf, STR_MAX+1, format, args);
+    va_end(args);
+
+    if (len > 0)
+        out.write(strBuf, std::min(static_cast<std::size_t>(len), static_cast<std::size_t>(STR_MAX)));
+}
+
+// -----------------------------------------------------------------------
+
+const uint32_t CarlaEngineFlightRecorder::kMaxCycles;
+const uint32_t CarlaEngineFlightRecorder::kMaxPlugins;
+
+CarlaEngineFlightRecorder::CarlaEngineFlightRecorder(CarlaEngine* const engine) noexcept
+    : kEngine(engine),
+      fCycles(),
+      fWritePos(0),
+      fRecording(false),
+      fPendingXruns(0),
+      fFrozen(false),
+      fSnapshot(),
+      fDumpCount(0),
+      fSkippedDumps(0),
+      fLastDumpTime(0)
+{
+    CARLA_SAFE_ASSERT(engine != nullptr);
+}
+
+void CarlaEngineFlightRecorder::clear() noexcept
+{
+    fWritePos = 0;
+    fRecording = false;
+    fDumpCount = 0;
+    fSkippedDumps = 0;
+    fLastDumpTime = 0;
+
+    __atomic_store_n(&fPendingXruns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&fFrozen, false, __ATOMIC_RELEASE);
+}
+
+void CarlaEngineFlightRecorder::beginCycleRT(const uint32_t frames) noexcept
+{
+    if (__atomic_load_n(&fFrozen, __ATOMIC_ACQUIRE))
+    {
+        fRecording = false;
+        return;
+    }
+
+    Cycle& cycle(fCycles[fWritePos % kMaxCycles]);
+    carla_zeroStruct(cycle);
+    cycle.startTime = carla_getMonotonicTimeNs();
+    cycle.frames = frames;
+
+    fRecording = true;
+}
+
+void CarlaEngineFlightRecorder::endCycleRT() noexcept
+{
+    if (! fRecording)
+        return;
+
+    fRecording = false;
+
+    Cycle& cycle(fCycles[fWritePos % kMaxCycles]);
+
+    const uint64_t duration = carla_getMonotonicTimeNs() - cycle.startTime;
+    cycle.duration = static_cast<uint32_t>(std::min<uint64_t>(duration, UINT32_MAX));
+
+    const CarlaEngine::ProtectedData* const pData = kEngine->pData;
+    cycle.eventsIn  = countEvents(pData->events.in);
+    cycle.eventsOut = countEvents(pData->events.out);
+
+    const uint32_t xruns = __atomic_exchange_n(&fPendingXruns, 0, __ATOMIC_ACQ_REL);
+    cycle.xruns = static_cast<uint16_t>(std::min<uint32_t>(xruns, UINT16_MAX));
+
+    ++fWritePos;
+
+    // stop recording until the main thread has taken a copy
+    if (xruns != 0)
+        __atomic_store_n(&fFrozen, true, __ATOMIC_RELEASE);
+}
+
+void CarlaEngineFlightRecorder::addPluginTimeRT(const uint pluginId, const uint64_t timeNs) noexcept
+{
+    if (! fRecording || pluginId >= kMaxPlugins)
+        return;
+
+    uint32_t& pluginTime(fCycles[fWritePos % kMaxCycles].pluginTimes[pluginId]);
+    pluginTime = static_cast<uint32_t>(std::min<uint64_t>(pluginTime + timeNs, UINT32_MAX));
+}
+
+void CarlaEngineFlightRecorder::addLockFailureRT() noexcept
+{
+    if (! fRecording)
+        return;
+
+    Cycle& cycle(fCycles[fWritePos % kMaxCycles]);
+
+    if (cycle.lockFailures != UINT16_MAX)
+        ++cycle.lockFailures;
+}
+
+void CarlaEngineFlightRecorder::xrun() noexcept
+{
+    // xruns reported while frozen are caused by the cycles that were already recorded
+    if (__atomic_load_n(&fFrozen, __ATOMIC_ACQUIRE))
+        return;
+
+    __atomic_add_fetch(&fPendingXruns, 1, __ATOMIC_RELEASE);
+}
+
+void CarlaEngineFlightRecorder::idle()
+{
+    if (! __atomic_load_n(&fFrozen, __ATOMIC_ACQUIRE))
+        return;
+
+    const uint32_t numCycles = std::min(fWritePos, kMaxCycles);
+    const uint32_t firstPos = fWritePos - numCycles;
+
+    for (uint32_t i=0; i < numCycles; ++i)
+        fSnapshot[i] = fCycles[(firstPos + i) % kMaxCycles];
+
+    __atomic_store_n(&fFrozen, false, __ATOMIC_RELEASE);
+
+    // do not flood the disk when xruns keep happening
+    const uint32_t now = d_gettime_ms();
+
+    if (fDumpCount >= kMaxDumpCount || (fDumpCount != 0 && now - fLastDumpTime < kMinDumpInterval))
+    {
+        ++fSkippedDumps;
+        return;
+    }
+
+    fLastDumpTime = now;
+    ++fDumpCount;
+
+    if (numCycles != 0)
+        writeSnapshot(numCycles);
+}
+
+// -----------------------------------------------------------------------
+
+bool CarlaEngineFlightRecorder::writeSnapshot(const uint32_t numCycles)
+{
+    const CarlaEngine::ProtectedData* const pData = kEngine->pData;
+
+    water::File dumpDir;
+
+    if (const char* const dumpDirStr = std::getenv("CARLA_XRUN_DUMP_DIR"))
+        dumpDir = water::File(dumpDirStr);
+    else
+        dumpDir = water::File::getSpecialLocation(water::File::tempDirectory);
+
+    const water::File dumpFile(dumpDir.getNonexistentChildFile("carla-xrun", ".txt", false));
+
+    water::MemoryOutputStream out;
+
+    writeFormatted(out, "# Carla xrun flight record\n");
+    writeFormatted(out, "# engine: %s, driver: %s\n", kEngine->getName(), kEngine->getCurrentDriverName());
+    writeFormatted(out, "# sample rate: %.0f, buffer size: %u, total xruns: %u, skipped dumps: %u\n",
+               pData->sampleRate, pData->bufferSize, pData->xruns, fSkippedDumps);
+
+    const uint numPlugins = std::min<uint>(pData->curPluginCount, kMaxPlugins);
+
+    for (uint i=0; i < numPlugins; ++i)
+    {
+        if (const CarlaPluginPtr plugin = pData->plugins[i].plugin)
+        {
+            writeFormatted(out, "# plugin %u: %s\n", i, plugin->getName());
+        }
+    }
+
+    writeFormatted(out, "# times in us, relative to the start of the last cycle\n");
+    writeFormatted(out, "start\tperiod\tduration\tload%%\tframes\tevIn\tevOut\tlockFail\txruns");
+
+    for (uint i=0; i < numPlugins; ++i)
+    {
+        writeFormatted(out, "\tplugin%u", i);
+    }
+
+    writeFormatted(out, "\n");
+
+    const Cycle& lastCycle(fSnapshot[numCycles - 1]);
+
+    for (uint32_t i=0; i < numCycles; ++i)
+    {
+        const Cycle& cycle(fSnapshot[i]);
+
+        const double start = static_cast<double>(static_cast<int64_t>(cycle.startTime - lastCycle.startTime)) / 1000.0;
+        const double period = i != 0 ? static_cast<double>(cycle.startTime - fSnapshot[i - 1].startTime) / 1000.0 : 0.0;
+        const double duration = static_cast<double>(cycle.duration) / 1000.0;
+        const double load = cycle.frames != 0 && pData->sampleRate > 0.0
+                          ? duration / (static_cast<double>(cycle.frames) / pData->sampleRate * 1000000.0) * 100.0
+                          : 0.0;
+
+        writeFormatted(out, "%.1f\t%.1f\t%.1f\t%.1f\t%u\t%u\t%u\t%u\t%u",
+                   start, period, duration, load, cycle.frames,
+                   cycle.eventsIn, cycle.eventsOut, cycle.lockFailures, cycle.xruns);
+
+        for (uint j=0; j < numPlugins; ++j)
+        {
+            if (cycle.pluginTimes[j] != 0)
+            {
+                writeFormatted(out, "\t%.1f", static_cast<double>(cycle.pluginTimes[j]) / 1000.0);
+            }
+            else
+            {
+                writeFormatted(out, "\t-");
+            }
+        }
+
+        writeFormatted(out, "\n");
+    }
+
+    if (! dumpFile.replaceWithData(out.getData(), out.getDataSize()))
+    {
+        carla_stderr2("CarlaEngineFlightRecorder::writeSnapshot() - failed to write '%s'",
+                      dumpFile.getFullPathName().toRawUTF8());
+        return false;
+    }
+
+    carla_stdout("Xrun flight record written to '%s'", dumpFile.getFullPathName().toRawUTF8());
+    return true;
+}
+
+#endif // BUILD_BRIDGE_ALTERNATIVE_ARCH
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
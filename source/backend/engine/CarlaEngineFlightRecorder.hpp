@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_ENGINE_FLIGHT_RECORDER_HPP_INCLUDED
+#define CARLA_ENGINE_FLIGHT_RECORDER_HPP_INCLUDED
+
+#include "CarlaEngine.hpp"
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// CarlaEngineFlightRecorder
+//
+// Always-on record of the last engine cycles, for post-mortem analysis of xruns.
+// Each cycle stores its start time and duration, event counts, failed plugin locks and per-plugin processing times.
+// When the driver reports an xrun the ring is frozen at the end of the current cycle, the main thread then takes
+// a copy of it, lets recording continue and writes the copy into a text file inside the temporary directory
+// (or $CARLA_XRUN_DUMP_DIR if set).
+// Cycles are written from a single audio thread, the one running the engine graph.
+
+class CarlaEngineFlightRecorder
+{
+public:
+    static const uint32_t kMaxCycles  = 512;
+    static const uint32_t kMaxPlugins = 16;
+
+    CarlaEngineFlightRecorder(CarlaEngine* engine) noexcept;
+
+    // forget all recorded cycles and dumps, must not be called while the engine is processing
+    void clear() noexcept;
+
+    // called by the audio thread at the start and end of each engine cycle
+    void beginCycleRT(uint32_t frames) noexcept;
+    void endCycleRT() noexcept;
+
+    // called by the audio thread while processing the plugins of the current cycle
+    void addPluginTimeRT(uint pluginId, uint64_t timeNs) noexcept;
+    void addLockFailureRT() noexcept;
+
+    // called when the driver reports an xrun, from any thread
+    void xrun() noexcept;
+
+    // write frozen cycles into a file, must be called from the main thread
+    void idle();
+
+private:
+    CarlaEngine* const kEngine;
+
+    struct Cycle {
+        uint64_t startTime; // monotonic, in nanoseconds
+        uint32_t duration;  // in nanoseconds
+        uint32_t frames;
+        uint16_t eventsIn;
+        uint16_t eventsOut;
+        uint16_t lockFailures;
+        uint16_t xruns;
+        uint32_t pluginTimes[kMaxPlugins]; // in nanoseconds, 0 if not processed
+    };
+
+    // written by the audio thread, read by the main thread only while frozen
+    Cycle fCycles[kMaxCycles];
+    uint32_t fWritePos;
+    bool fRecording;
+
+    // shared between threads
+    uint32_t fPendingXruns;
+    bool fFrozen;
+
+    // main thread only
+    Cycle fSnapshot[kMaxCycles];
+    uint32_t fDumpCount;
+    uint32_t fSkippedDumps;
+    uint32_t fLastDumpTime;
+
+    bool writeSnapshot(uint32_t numCycles);
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaEngineFlightRecorder)
+};
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_ENGINE_FLIGHT_RECORDER_HPP_INCLUDED
@@ -734,12 +734,19 @@ RackGraph::Buffers::Buffers() noexcept
       inBufTmp{nullptr, nullptr},
       outBuf{nullptr, nullptr},
 #endif
-      unusedBuf(nullptr)
+      unusedBuf(nullptr),
+#ifdef CARLA_PROPER_CPP11_SUPPORT
+      inBuf64{nullptr, nullptr},
+      outBuf64{nullptr, nullptr},
+#endif
+      unusedBuf64(nullptr)
     {
 #ifndef CARLA_PROPER_CPP11_SUPPORT
         inBuf[0]    = inBuf[1]    = nullptr;
         inBufTmp[0] = inBufTmp[1] = nullptr;
         outBuf[0]   = outBuf[1]   = nullptr;
+        inBuf64[0]  = inBuf64[1]  = nullptr;
+        outBuf64[0] = outBuf64[1] = nullptr;
 #endif
     }
 
@@ -754,6 +761,11 @@ RackGraph::Buffers::~Buffers() noexcept
     if (outBuf[0]   != nullptr) { delete[] outBuf[0];   outBuf[0]   = nullptr; }
     if (outBuf[1]   != nullptr) { delete[] outBuf[1];   outBuf[1]   = nullptr; }
     if (unusedBuf   != nullptr) { delete[] unusedBuf;   unusedBuf   = nullptr; }
+    if (inBuf64[0]  != nullptr) { delete[] inBuf64[0];  inBuf64[0]  = nullptr; }
+    if (inBuf64[1]  != nullptr) { delete[] inBuf64[1];  inBuf64[1]  = nullptr; }
+    if (outBuf64[0] != nullptr) { delete[] outBuf64[0]; outBuf64[0] = nullptr; }
+    if (outBuf64[1] != nullptr) { delete[] outBuf64[1]; outBuf64[1] = nullptr; }
+    if (unusedBuf64 != nullptr) { delete[] unusedBuf64; unusedBuf64 = nullptr; }
 
     connectedIn1.clear();
     connectedIn2.clear();
@@ -761,7 +773,7 @@ RackGraph::Buffers::~Buffers() noexcept
     connectedOut2.clear();
 }
 
-void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool createBuffers) noexcept
+void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool createBuffers, const bool createDoubleBuffers) noexcept
 {
     const CarlaRecursiveMutexLocker cml(mutex);
 
@@ -772,6 +784,11 @@ void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool cre
     if (outBuf[0]   != nullptr) { delete[] outBuf[0];   outBuf[0]   = nullptr; }
     if (outBuf[1]   != nullptr) { delete[] outBuf[1];   outBuf[1]   = nullptr; }
     if (unusedBuf   != nullptr) { delete[] unusedBuf;   unusedBuf   = nullptr; }
+    if (inBuf64[0]  != nullptr) { delete[] inBuf64[0];  inBuf64[0]  = nullptr; }
+    if (inBuf64[1]  != nullptr) { delete[] inBuf64[1];  inBuf64[1]  = nullptr; }
+    if (outBuf64[0] != nullptr) { delete[] outBuf64[0]; outBuf64[0] = nullptr; }
+    if (outBuf64[1] != nullptr) { delete[] outBuf64[1]; outBuf64[1] = nullptr; }
+    if (unusedBuf64 != nullptr) { delete[] unusedBuf64; unusedBuf64 = nullptr; }
 
     CARLA_SAFE_ASSERT_RETURN(bufferSize > 0,);
 
@@ -787,6 +804,15 @@ void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool cre
             outBuf[0] = new float[bufferSize];
             outBuf[1] = new float[bufferSize];
         }
+
+        if (createDoubleBuffers)
+        {
+            inBuf64[0]  = new double[bufferSize];
+            inBuf64[1]  = new double[bufferSize];
+            outBuf64[0] = new double[bufferSize];
+            outBuf64[1] = new double[bufferSize];
+            unusedBuf64 = new double[bufferSize];
+        }
     }
     catch(...) {
         if (inBufTmp[0] != nullptr) { delete[] inBufTmp[0]; inBufTmp[0] = nullptr; }
@@ -800,6 +826,15 @@ void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool cre
             if (outBuf[0] != nullptr) { delete[] outBuf[0]; outBuf[0] = nullptr; }
             if (outBuf[1] != nullptr) { delete[] outBuf[1]; outBuf[1] = nullptr; }
         }
+
+        if (createDoubleBuffers)
+        {
+            if (inBuf64[0]  != nullptr) { delete[] inBuf64[0];  inBuf64[0]  = nullptr; }
+            if (inBuf64[1]  != nullptr) { delete[] inBuf64[1];  inBuf64[1]  = nullptr; }
+            if (outBuf64[0] != nullptr) { delete[] outBuf64[0]; outBuf64[0] = nullptr; }
+            if (outBuf64[1] != nullptr) { delete[] outBuf64[1]; outBuf64[1] = nullptr; }
+            if (unusedBuf64 != nullptr) { delete[] unusedBuf64; unusedBuf64 = nullptr; }
+        }
         return;
     }
 
@@ -813,6 +848,14 @@ void RackGraph::Buffers::setBufferSize(const uint32_t bufferSize, const bool cre
         carla_zeroFloats(outBuf[0], bufferSize);
         carla_zeroFloats(outBuf[1], bufferSize);
     }
+
+    if (createDoubleBuffers)
+    {
+        carla_zeroDoubles(inBuf64[0],  bufferSize);
+        carla_zeroDoubles(inBuf64[1],  bufferSize);
+        carla_zeroDoubles(outBuf64[0], bufferSize);
+        carla_zeroDoubles(outBuf64[1], bufferSize);
+    }
 }
 
 // -----------------------------------------------------------------------
@@ -822,6 +865,7 @@ RackGraph::RackGraph(CarlaEngine* const engine, const uint32_t ins, const uint32
     : extGraph(engine),
       inputs(ins),
       outputs(outs),
+      doublePrecision(engine->usesDoublePrecision()),
       isOffline(false),
       audioBuffers(),
       kEngine(engine)
@@ -836,7 +880,7 @@ RackGraph::~RackGraph() noexcept
 
 void RackGraph::setBufferSize(const uint32_t bufferSize) noexcept
 {
-    audioBuffers.setBufferSize(bufferSize, (inputs > 0 || outputs > 0));
+    audioBuffers.setBufferSize(bufferSize, (inputs > 0 || outputs > 0), doublePrecision);
 }
 
 void RackGraph::setOffline(const bool offline) noexcept
@@ -966,14 +1010,36 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
     float* const inBuf0   = audioBuffers.inBufTmp[0];
     float* const inBuf1   = audioBuffers.inBufTmp[1];
 
-    // initialize audio inputs
-    carla_copyFloats(inBuf0, inBufReal[0], frames);
-    carla_copyFloats(inBuf1, inBufReal[1], frames);
+    // double-precision buses, audio is only converted to float for plugins that need it and at the end
+    double* const dummyBuf64 = audioBuffers.unusedBuf64;
+    double* const inBuf64_0  = audioBuffers.inBuf64[0];
+    double* const inBuf64_1  = audioBuffers.inBuf64[1];
+    double* const outBuf64_0 = audioBuffers.outBuf64[0];
+    double* const outBuf64_1 = audioBuffers.outBuf64[1];
 
     // initialize audio outputs (zero)
     carla_zeroFloats(outBufReal[0], frames);
     carla_zeroFloats(outBufReal[1], frames);
 
+    if (doublePrecision)
+    {
+        CARLA_SAFE_ASSERT_RETURN(dummyBuf64 != nullptr,);
+
+        // initialize audio inputs
+        carla_convertFloatsToDoubles(inBuf64_0, inBufReal[0], frames);
+        carla_convertFloatsToDoubles(inBuf64_1, inBufReal[1], frames);
+
+        // initialize audio outputs (zero)
+        carla_zeroDoubles(outBuf64_0, frames);
+        carla_zeroDoubles(outBuf64_1, frames);
+    }
+    else
+    {
+        // initialize audio inputs
+        carla_copyFloats(inBuf0, inBufReal[0], frames);
+        carla_copyFloats(inBuf1, inBufReal[1], frames);
+    }
+
     // initialize event outputs (zero)
     carla_zeroStructs(data->events.out, kMaxEngineEventInternalCount);
 
@@ -981,6 +1047,9 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
     float* outBuf[MAX_GRAPH_AUDIO_IO];
     float* cvBuf[MAX_GRAPH_CV_IO];
 
+    const double* inBuf64[MAX_GRAPH_AUDIO_IO];
+    double* outBuf64[MAX_GRAPH_AUDIO_IO];
+
     uint32_t oldAudioInCount  = 0;
     uint32_t oldAudioOutCount = 0;
     uint32_t oldMidiOutCount  = 0;
@@ -991,18 +1060,37 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
     {
         const CarlaPluginPtr plugin = data->plugins[i].plugin;
 
-        if (plugin.get() == nullptr || ! plugin->isEnabled() || ! plugin->tryLock(isOffline))
+        if (plugin.get() == nullptr || ! plugin->isEnabled())
             continue;
 
+        if (! plugin->tryLock(isOffline))
+        {
+            data->flightRecorder.addLockFailureRT();
+            continue;
+        }
+
         if (processed)
         {
-            // initialize audio inputs (from previous outputs)
-            carla_copyFloats(inBuf0, outBufReal[0], frames);
-            carla_copyFloats(inBuf1, outBufReal[1], frames);
+            if (doublePrecision)
+            {
+                // initialize audio inputs (from previous outputs)
+                carla_copyDoubles(inBuf64_0, outBuf64_0, frames);
+                carla_copyDoubles(inBuf64_1, outBuf64_1, frames);
+
+                // initialize audio outputs (zero)
+                carla_zeroDoubles(outBuf64_0, frames);
+                carla_zeroDoubles(outBuf64_1, frames);
+            }
+            else
+            {
+                // initialize audio inputs (from previous outputs)
+                carla_copyFloats(inBuf0, outBufReal[0], frames);
+                carla_copyFloats(inBuf1, outBufReal[1], frames);
 
-            // initialize audio outputs (zero)
-            carla_zeroFloats(outBufReal[0], frames);
-            carla_zeroFloats(outBufReal[1], frames);
+                // initialize audio outputs (zero)
+                carla_zeroFloats(outBufReal[0], frames);
+                carla_zeroFloats(outBufReal[1], frames);
+            }
 
             // if plugin has no midi out, add previous events
             if (oldMidiOutCount == 0 && data->events.in[0].type != kEngineEventTypeNull)
@@ -1036,42 +1124,114 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
         CARLA_SAFE_ASSERT_RETURN(numOutBufs <= MAX_GRAPH_AUDIO_IO, plugin->unlock());
         CARLA_SAFE_ASSERT_RETURN(numCvBufs <= MAX_GRAPH_CV_IO, plugin->unlock());
 
-        inBuf[0] = inBuf0;
-        inBuf[1] = inBuf1;
+        if (doublePrecision && plugin->canProcessDouble())
+        {
+            inBuf64[0] = inBuf64_0;
+            inBuf64[1] = inBuf64_1;
 
-        outBuf[0] = outBufReal[0];
-        outBuf[1] = outBufReal[1];
+            outBuf64[0] = outBuf64_0;
+            outBuf64[1] = outBuf64_1;
 
-        for (uint32_t j=0; j<numCvBufs; ++j)
-            cvBuf[j] = dummyBuf;
+            if (numInBufs > 2 || numOutBufs > 2)
+            {
+                carla_zeroDoubles(dummyBuf64, frames);
 
-        if (numInBufs > 2 || numOutBufs > 2 || numCvBufs != 0)
-        {
-            carla_zeroFloats(dummyBuf, frames);
+                for (uint32_t j=2; j<numInBufs; ++j)
+                    inBuf64[j] = dummyBuf64;
 
-            for (uint32_t j=2; j<numInBufs; ++j)
-                inBuf[j] = dummyBuf;
+                for (uint32_t j=2; j<numOutBufs; ++j)
+                    outBuf64[j] = dummyBuf64;
+            }
 
-            for (uint32_t j=2; j<numOutBufs; ++j)
-                outBuf[j] = dummyBuf;
-        }
+            // process
+            plugin->initBuffers();
 
-        // process
-        plugin->initBuffers();
-        plugin->process(inBuf, outBuf, cvBuf, cvBuf, frames);
-        plugin->unlock();
+            const uint64_t startTime = carla_getMonotonicTimeNs();
+            plugin->processDouble(inBuf64, outBuf64, frames);
+            const uint64_t processTime = carla_getMonotonicTimeNs() - startTime;
+            data->plugins[i].processTime.addRT(processTime, frames, data->sampleRate);
+            data->flightRecorder.addPluginTimeRT(i, processTime);
 
-        // if plugin has no audio inputs, add input buffer
-        if (oldAudioInCount == 0)
+            plugin->unlock();
+        }
+        else
         {
-            carla_addFloats(outBufReal[0], inBuf0, frames);
-            carla_addFloats(outBufReal[1], inBuf1, frames);
+            // plugin only does 32-bit, convert at its edges
+            if (doublePrecision)
+            {
+                carla_convertDoublesToFloats(inBuf0, inBuf64_0, frames);
+                carla_convertDoublesToFloats(inBuf1, inBuf64_1, frames);
+                carla_zeroFloats(outBufReal[0], frames);
+                carla_zeroFloats(outBufReal[1], frames);
+            }
+
+            inBuf[0] = inBuf0;
+            inBuf[1] = inBuf1;
+
+            outBuf[0] = outBufReal[0];
+            outBuf[1] = outBufReal[1];
+
+            for (uint32_t j=0; j<numCvBufs; ++j)
+                cvBuf[j] = dummyBuf;
+
+            if (numInBufs > 2 || numOutBufs > 2 || numCvBufs != 0)
+            {
+                carla_zeroFloats(dummyBuf, frames);
+
+                for (uint32_t j=2; j<numInBufs; ++j)
+                    inBuf[j] = dummyBuf;
+
+                for (uint32_t j=2; j<numOutBufs; ++j)
+                    outBuf[j] = dummyBuf;
+            }
+
+            // process
+            plugin->initBuffers();
+
+            const uint64_t startTime = carla_getMonotonicTimeNs();
+            plugin->process(inBuf, outBuf, cvBuf, cvBuf, frames);
+            const uint64_t processTime = carla_getMonotonicTimeNs() - startTime;
+            data->plugins[i].processTime.addRT(processTime, frames, data->sampleRate);
+            data->flightRecorder.addPluginTimeRT(i, processTime);
+
+            plugin->unlock();
+
+            if (doublePrecision)
+            {
+                carla_convertFloatsToDoubles(outBuf64_0, outBufReal[0], frames);
+                carla_convertFloatsToDoubles(outBuf64_1, outBufReal[1], frames);
+            }
         }
 
-        // if plugin only has 1 output, copy it to the 2nd
-        if (oldAudioOutCount == 1)
+        if (doublePrecision)
         {
-            carla_copyFloats(outBufReal[1], outBufReal[0], frames);
+            // if plugin has no audio inputs, add input buffer
+            if (oldAudioInCount == 0)
+            {
+                carla_addDoubles(outBuf64_0, inBuf64_0, frames);
+                carla_addDoubles(outBuf64_1, inBuf64_1, frames);
+            }
+
+            // if plugin only has 1 output, copy it to the 2nd
+            if (oldAudioOutCount == 1)
+            {
+                carla_copyDoubles(outBuf64_1, outBuf64_0, frames);
+            }
+        }
+        else
+        {
+            // if plugin has no audio inputs, add input buffer
+            if (oldAudioInCount == 0)
+            {
+                carla_addFloats(outBufReal[0], inBuf0, frames);
+                carla_addFloats(outBufReal[1], inBuf1, frames);
+            }
+
+            // if plugin only has 1 output, copy it to the 2nd
+            if (oldAudioOutCount == 1)
+            {
+                carla_copyFloats(outBufReal[1], outBufReal[0], frames);
+            }
         }
 
         // set peaks
@@ -1080,8 +1240,16 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
 
             if (oldAudioInCount > 0)
             {
-                pluginData.peaks[0] = carla_findMaxNormalizedFloat(inBuf0, frames);
-                pluginData.peaks[1] = carla_findMaxNormalizedFloat(inBuf1, frames);
+                if (doublePrecision)
+                {
+                    pluginData.peaks[0] = carla_findMaxNormalizedDouble(inBuf64_0, frames);
+                    pluginData.peaks[1] = carla_findMaxNormalizedDouble(inBuf64_1, frames);
+                }
+                else
+                {
+                    pluginData.peaks[0] = carla_findMaxNormalizedFloat(inBuf0, frames);
+                    pluginData.peaks[1] = carla_findMaxNormalizedFloat(inBuf1, frames);
+                }
             }
             else
             {
@@ -1091,8 +1259,16 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
 
             if (oldAudioOutCount > 0)
             {
-                pluginData.peaks[2] = carla_findMaxNormalizedFloat(outBufReal[0], frames);
-                pluginData.peaks[3] = carla_findMaxNormalizedFloat(outBufReal[1], frames);
+                if (doublePrecision)
+                {
+                    pluginData.peaks[2] = carla_findMaxNormalizedDouble(outBuf64_0, frames);
+                    pluginData.peaks[3] = carla_findMaxNormalizedDouble(outBuf64_1, frames);
+                }
+                else
+                {
+                    pluginData.peaks[2] = carla_findMaxNormalizedFloat(outBufReal[0], frames);
+                    pluginData.peaks[3] = carla_findMaxNormalizedFloat(outBufReal[1], frames);
+                }
             }
             else
             {
@@ -1103,6 +1279,13 @@ void RackGraph::process(CarlaEngine::ProtectedData* const data, const float* inB
 
         processed = true;
     }
+
+    // back to 32-bit for the outside world
+    if (doublePrecision && processed)
+    {
+        carla_convertDoublesToFloats(outBufReal[0], outBuf64_0, frames);
+        carla_convertDoublesToFloats(outBufReal[1], outBuf64_1, frames);
+    }
 }
 
 void RackGraph::processHelper(CarlaEngine::ProtectedData* const data, const float* const* const inBuf, float* const* const outBuf, const uint32_t frames)
@@ -1540,6 +1723,9 @@ public:
 
         if (plugin.get() == nullptr || !plugin->isEnabled() || !plugin->tryLock(kEngine->isOffline()))
         {
+            if (plugin.get() != nullptr && plugin->isEnabled())
+                kEngine->pData->flightRecorder.addLockFailureRT();
+
             audio.clear();
             cvOut.clear();
             midi.clear();
@@ -1564,10 +1750,14 @@ public:
         const uint32_t numCVInChan  = cvIn.getNumChannels();
         const uint32_t numCVOutChan = cvOut.getNumChannels();
 
+        uint64_t startTime, processTime;
+
         if (numAudioChan+numCVInChan+numCVOutChan == 0)
         {
             // nothing to process
+            startTime = carla_getMonotonicTimeNs();
             plugin->process(nullptr, nullptr, nullptr, nullptr, numSamples);
+            processTime = carla_getMonotonicTimeNs() - startTime;
         }
         else if (numAudioChan != 0)
         {
@@ -1597,9 +1787,11 @@ public:
             for (uint32_t i=0, count=jmin(plugin->getAudioInCount(), numChan2); i<count; ++i)
                 inPeaks[i] = carla_findMaxNormalizedFloat(audioBuffers[i], numSamples);
 
+            startTime = carla_getMonotonicTimeNs();
             plugin->process(const_cast<const float**>(audioBuffers), audioBuffers,
                             cvInBuffers, cvOutBuffers,
                             numSamples);
+            processTime = carla_getMonotonicTimeNs() - startTime;
 
             for (uint32_t i=0, count=jmin(plugin->getAudioOutCount(), numChan2); i<count; ++i)
                 outPeaks[i] = carla_findMaxNormalizedFloat(audioBuffers[i], numSamples);
@@ -1617,11 +1809,15 @@ public:
             for (uint32_t i=0; i<numCVInChan; ++i)
                 cvInBuffers[i] = cvIn.getReadPointer(i);
 
+            startTime = carla_getMonotonicTimeNs();
             plugin->process(nullptr, nullptr,
                             cvInBuffers, cvOutBuffers,
                             numSamples);
+            processTime = carla_getMonotonicTimeNs() - startTime;
         }
 
+        kEngine->setPluginProcessTimeRT(plugin->getId(), processTime, numSamples);
+
         midi.clear();
 
         if (CarlaEngineEventPort* const port = plugin->getDefaultEventOutPort())
@@ -119,6 +119,7 @@ struct RackGraph {
     ExternalGraph extGraph;
     const uint32_t inputs;
     const uint32_t outputs;
+    const bool doublePrecision;
     bool isOffline;
 
     struct Buffers {
@@ -131,9 +132,13 @@ struct RackGraph {
         float* inBufTmp[2];
         float* outBuf[2];
         float* unusedBuf;
+        // double-precision buses between plugins, only used when doublePrecision is set
+        double* inBuf64[2];
+        double* outBuf64[2];
+        double* unusedBuf64;
         Buffers() noexcept;
         ~Buffers() noexcept;
-        void setBufferSize(uint32_t bufferSize, bool createBuffers) noexcept;
+        void setBufferSize(uint32_t bufferSize, bool createBuffers, bool createDoubleBuffers) noexcept;
         CARLA_PREVENT_HEAP_ALLOCATION
         CARLA_DECLARE_NON_COPYABLE(Buffers)
     } audioBuffers;
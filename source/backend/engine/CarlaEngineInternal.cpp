@@ -370,8 +370,15 @@ EngineEvent* CarlaEngine::getInternalEventBuffer(const bool isInput) const noexc
 
 CarlaEngine::ProtectedData::ProtectedData(CarlaEngine* const engine)
     : runner(engine),
+      projectSaver(engine),
+      threadPool(),
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+      autosave(engine),
+      flightRecorder(engine),
+#endif
 #if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
       osc(engine),
+      oscParameters(),
 #endif
       callback(nullptr),
       callbackPtr(nullptr),
@@ -503,6 +510,7 @@ bool CarlaEngine::ProtectedData::init(const char* const clientName)
     plugins = new EnginePluginData[maxPluginNumber];
     xruns = 0;
     dspLoad = 0.0f;
+    flightRecorder.clear();
 #endif
 
     nextAction.clearAndReset();
@@ -521,11 +529,18 @@ void CarlaEngine::ProtectedData::close()
 
     aboutToClose = true;
 
+    projectSaver.wait();
     runner.stop();
     nextAction.clearAndReset();
 
 #if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
     osc.close();
+
+    if (oscParameters.applied != 0)
+        carla_stdout("OSC parameter changes applied in the audio thread: %u, dropped: %u, max latency: %u us",
+                     oscParameters.applied, oscParameters.dropped, oscParameters.maxLatency);
+
+    oscParameters.clear();
 #endif
 
     aboutToClose    = false;
@@ -534,6 +549,7 @@ void CarlaEngine::ProtectedData::close()
     nextPluginId    = 0;
 
     deletePluginsAsNeeded();
+    threadPool.stop();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (plugins != nullptr)
@@ -564,6 +580,31 @@ void CarlaEngine::ProtectedData::initTime(const char* const features)
 
 // -----------------------------------------------------------------------
 
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+void CarlaEngine::ProtectedData::setCurrentProject(const char* const filename)
+{
+    if (currentProjectFilename == filename)
+        return;
+
+    currentProjectFilename = filename;
+
+    bool found;
+    const size_t r = currentProjectFilename.rfind(CARLA_OS_SEP, &found);
+
+    if (found)
+    {
+        currentProjectFolder = filename;
+        currentProjectFolder[r] = '\0';
+    }
+    else
+    {
+        currentProjectFolder.clear();
+    }
+}
+#endif
+
+// -----------------------------------------------------------------------
+
 void CarlaEngine::ProtectedData::deletePluginsAsNeeded()
 {
     std::vector<CarlaPluginPtr> safePluginListToDelete;
@@ -609,6 +650,7 @@ void CarlaEngine::ProtectedData::doPluginRemove(const uint pluginId) noexcept
 
         plugins[i].plugin = plugin;
         carla_zeroStruct(plugins[i].peaks);
+        plugins[i].processTime.reset();
     }
 
     const uint id = curPluginCount;
@@ -616,6 +658,7 @@ void CarlaEngine::ProtectedData::doPluginRemove(const uint pluginId) noexcept
     // reset last plugin (now removed)
     plugins[id].plugin.reset();
     carla_zeroFloats(plugins[id].peaks, 4);
+    plugins[id].processTime.reset();
 }
 
 void CarlaEngine::ProtectedData::doPluginsSwitch(const uint idA, const uint idB) noexcept
@@ -636,6 +679,9 @@ void CarlaEngine::ProtectedData::doPluginsSwitch(const uint idA, const uint idB)
 
     pluginB->setId(idA);
     plugins[idB].plugin = pluginA;
+
+    plugins[idA].processTime.reset();
+    plugins[idB].processTime.reset();
 }
 #endif
 
@@ -675,6 +721,12 @@ void CarlaEngine::ProtectedData::doNextPluginAction() noexcept
 #endif
     }
 
+#if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+    // plugin ids changed, queued OSC parameter changes no longer match their plugins
+    if (opcode != kEnginePostActionNull)
+        oscParameters.invalidate();
+#endif
+
     if (needsPost)
     {
         if (nextAction.sem != nullptr)
@@ -709,11 +761,25 @@ static int64_t getTimeInMicroseconds() noexcept
 
 PendingRtEventsRunner::PendingRtEventsRunner(CarlaEngine* const engine,
                                              const uint32_t frames,
-                                             const bool calcDSPLoad) noexcept
+                                             const bool calcDSPLoad,
+                                             const bool isAudioCallback) noexcept
     : pData(engine->pData),
       prevTime(calcDSPLoad ? getTimeInMicroseconds() : 0)
 {
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    pData->flightRecorder.beginCycleRT(frames);
+#endif
+
     pData->time.preProcess(frames);
+
+#if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+    // the queue has a single consumer, which must be the audio callback
+    if (isAudioCallback)
+        pData->oscParameters.process(pData->plugins, pData->curPluginCount, engine->isOffline());
+#else
+    // unused
+    (void)isAudioCallback;
+#endif
 }
 
 PendingRtEventsRunner::~PendingRtEventsRunner() noexcept
@@ -721,6 +787,8 @@ PendingRtEventsRunner::~PendingRtEventsRunner() noexcept
     pData->doNextPluginAction();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    pData->flightRecorder.endCycleRT();
+
     if (prevTime > 0)
     {
         const int64_t newTime = getTimeInMicroseconds();
@@ -740,6 +808,142 @@ PendingRtEventsRunner::~PendingRtEventsRunner() noexcept
 #endif
 }
 
+#if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+// -----------------------------------------------------------------------
+// EngineRtParameterQueue
+
+// events for a busy plugin are kept for the next cycle, but not forever, in microseconds
+static const int64_t kRtParameterMaxAge = 1000000;
+
+EngineRtParameterQueue::EngineRtParameterQueue() noexcept
+    : buffer(),
+      pending(),
+      hasPending(false),
+      generation(0),
+      applied(0),
+      dropped(0),
+      maxLatency(0),
+      lastLatency(0)
+{
+    buffer.createBuffer(sizeof(Event) * 512, true);
+}
+
+uint32_t EngineRtParameterQueue::getGeneration() const noexcept
+{
+    return __atomic_load_n(&generation, __ATOMIC_ACQUIRE);
+}
+
+bool EngineRtParameterQueue::append(const uint32_t gen, const uint pluginId, const uint32_t index, const float value) noexcept
+{
+    if (buffer.getWritableDataSize() < sizeof(Event))
+        return false;
+
+    const Event event = { gen, pluginId, index, value, getTimeInMicroseconds() };
+
+    if (! buffer.writeCustomType(event))
+        return false;
+
+    // make sure the event data is visible before the audio thread sees the new write position
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return buffer.commitWrite();
+}
+
+void EngineRtParameterQueue::invalidate() noexcept
+{
+    __atomic_add_fetch(&generation, 1, __ATOMIC_RELEASE);
+}
+
+void EngineRtParameterQueue::process(EnginePluginData* const plugins,
+                                     const uint pluginCount,
+                                     const bool isOffline) noexcept
+{
+    if (! hasPending && buffer.isEmpty())
+        return;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    const int64_t timeNow = getTimeInMicroseconds();
+    const uint32_t currentGeneration = getGeneration();
+
+    for (;;)
+    {
+        if (! hasPending)
+        {
+            if (buffer.getReadableDataSize() < sizeof(Event))
+                break;
+
+            buffer.readCustomType(pending);
+            hasPending = true;
+        }
+
+        // plugin might have been removed, replaced or moved in the mean time
+        if (pending.generation != currentGeneration || pending.pluginId >= pluginCount)
+        {
+            hasPending = false;
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        const CarlaPluginPtr plugin = plugins[pending.pluginId].plugin;
+
+        if (plugin.get() == nullptr)
+        {
+            hasPending = false;
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        // plugin is busy or being reloaded, stop here and try again on the next cycle
+        if (! plugin->isEnabled() || ! plugin->tryLock(isOffline))
+        {
+            if (timeNow - pending.time < kRtParameterMaxAge)
+                break;
+
+            hasPending = false;
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (pending.index < plugin->getParameterCount() && ! plugin->isParameterOutput(pending.index))
+        {
+            plugin->setParameterValueRT(pending.index, pending.value, 0, true);
+
+            const uint32_t latency = static_cast<uint32_t>(std::max<int64_t>(0, timeNow - pending.time));
+            __atomic_store_n(&lastLatency, latency, __ATOMIC_RELAXED);
+
+            if (latency > maxLatency)
+                __atomic_store_n(&maxLatency, latency, __ATOMIC_RELAXED);
+
+            __atomic_add_fetch(&applied, 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+        }
+
+        hasPending = false;
+        plugin->unlock();
+    }
+}
+
+void EngineRtParameterQueue::getStats(uint32_t& appliedRet, uint32_t& droppedRet,
+                                      uint32_t& lastLatencyRet, uint32_t& maxLatencyRet) const noexcept
+{
+    appliedRet     = __atomic_load_n(&applied, __ATOMIC_RELAXED);
+    droppedRet     = __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+    lastLatencyRet = __atomic_load_n(&lastLatency, __ATOMIC_RELAXED);
+    maxLatencyRet  = __atomic_load_n(&maxLatency, __ATOMIC_RELAXED);
+}
+
+void EngineRtParameterQueue::clear() noexcept
+{
+    buffer.flush();
+    hasPending = false;
+    applied = dropped = 0;
+    maxLatency = lastLatency = 0;
+}
+#endif
+
 // -----------------------------------------------------------------------
 // ScopedActionLock
 
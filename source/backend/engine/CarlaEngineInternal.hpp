@@ -4,9 +4,15 @@
 #ifndef CARLA_ENGINE_INTERNAL_HPP_INCLUDED
 #define CARLA_ENGINE_INTERNAL_HPP_INCLUDED
 
+#include "CarlaEngineAutosave.hpp"
+#include "CarlaEngineProjectSaver.hpp"
 #include "CarlaEngineRunner.hpp"
+#include "CarlaEngineFlightRecorder.hpp"
+#include "CarlaEngineThreadPool.hpp"
 #include "CarlaEngineUtils.hpp"
 #include "CarlaPlugin.hpp"
+#include "CarlaProcessTimeUtils.hpp"
+#include "CarlaRingBuffer.hpp"
 #include "LinkedList.hpp"
 
 #ifndef BUILD_BRIDGE
@@ -236,27 +242,95 @@ struct EngineNextAction {
 struct EnginePluginData {
     CarlaPluginPtr plugin;
     float peaks[4];
+    CarlaProcessTimeStats processTime;
 
     EnginePluginData()
         : plugin(nullptr),
 #ifdef CARLA_PROPER_CPP11_SUPPORT
-          peaks{0.0f, 0.0f, 0.0f, 0.0f} {}
+          peaks{0.0f, 0.0f, 0.0f, 0.0f},
+          processTime() {}
 #else
-          peaks()
+          peaks(),
+          processTime()
     {
         carla_zeroStruct(peaks);
     }
 #endif
 };
 
+#if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
+// -----------------------------------------------------------------------
+// EngineRtParameterQueue
+//
+// Lock-free single-producer single-consumer queue of parameter changes from the OSC thread into the audio thread.
+// Changes are applied at the start of the next audio cycle, the time they took to get there is measured.
+// If a plugin is busy the queue stops there and is resumed on the next cycle, so no change is reordered or lost.
+// Plugin ids are only valid for the generation they were taken in, which changes when plugins are removed,
+// replaced or switched; changes queued for an older generation are dropped.
+
+struct EngineRtParameterQueue {
+    struct Event {
+        uint32_t generation;
+        uint pluginId;
+        uint32_t index;
+        float value;
+        int64_t time;
+    };
+
+    CarlaHeapRingBuffer buffer;
+
+    // event already taken out of the buffer but not applied yet, audio thread only
+    Event pending;
+    bool hasPending;
+
+    // current plugin id generation
+    uint32_t generation;
+
+    // statistics, written by the audio thread only, read them with getStats()
+    uint32_t applied;
+    uint32_t dropped;
+    uint32_t maxLatency;  // in microseconds
+    uint32_t lastLatency; // in microseconds
+
+    EngineRtParameterQueue() noexcept;
+
+    // non-RT, must be read before resolving the plugin id given to append()
+    uint32_t getGeneration() const noexcept;
+
+    // non-RT, returns false if the queue is full
+    bool append(uint32_t generation, uint pluginId, uint32_t index, float value) noexcept;
+
+    // can be called from any thread, after plugin ids change
+    void invalidate() noexcept;
+
+    // RT, called once per audio cycle from the audio callback only
+    void process(EnginePluginData* plugins, uint pluginCount, bool isOffline) noexcept;
+
+    // can be called from any thread
+    void getStats(uint32_t& appliedRet, uint32_t& droppedRet, uint32_t& lastLatencyRet, uint32_t& maxLatencyRet) const noexcept;
+
+    // non-RT, must not be called while the engine is running
+    void clear() noexcept;
+
+    CARLA_DECLARE_NON_COPYABLE(EngineRtParameterQueue)
+};
+#endif
+
 // -----------------------------------------------------------------------
 // CarlaEngineProtectedData
 
 struct CarlaEngine::ProtectedData {
     CarlaEngineRunner runner;
+    CarlaEngineProjectSaver projectSaver;
+    CarlaEngineThreadPool threadPool;
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    CarlaEngineAutosave autosave;
+    CarlaEngineFlightRecorder flightRecorder;
+#endif
 
 #if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
     CarlaEngineOsc osc;
+    EngineRtParameterQueue oscParameters;
 #endif
 
     EngineCallbackFunc callback;
@@ -320,6 +394,10 @@ struct CarlaEngine::ProtectedData {
 
     void initTime(const char* features);
 
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    void setCurrentProject(const char* filename);
+#endif
+
     // -------------------------------------------------------------------
 
     void deletePluginsAsNeeded();
@@ -345,7 +423,8 @@ class PendingRtEventsRunner
 public:
     PendingRtEventsRunner(CarlaEngine* engine,
                           uint32_t numFrames,
-                          bool calcDSPLoad = false) noexcept;
+                          bool calcDSPLoad = false,
+                          bool isAudioCallback = true) noexcept;
     ~PendingRtEventsRunner() noexcept;
 
 private:
@@ -3520,7 +3520,7 @@ protected:
 #endif
 
         {
-            const PendingRtEventsRunner prt(this, pData->bufferSize);
+            const PendingRtEventsRunner prt(this, pData->bufferSize, false, false);
 
             for (uint i=0; i < pData->curPluginCount; ++i)
             {
@@ -4386,6 +4386,7 @@ private:
     static int JACKBRIDGE_API carla_jack_xrun_callback(void* arg)
     {
         ++(handlePtr->pData->xruns);
+        handlePtr->pData->flightRecorder.xrun();
         return 0;
     }
 #endif
@@ -19,6 +19,7 @@
 #include "CarlaBinaryUtils.hpp"
 #include "CarlaMathUtils.hpp"
 #include "CarlaStateUtils.hpp"
+#include "CarlaXmlStreamUtils.hpp"
 
 #include "CarlaExternalUI.hpp"
 #include "CarlaHost.h"
@@ -29,7 +30,6 @@
 
 #include "water/files/File.h"
 #include "water/streams/MemoryOutputStream.h"
-#include "water/xml/XmlDocument.h"
 #include "water/xml/XmlElement.h"
 
 #ifdef CARLA_OS_WIN
@@ -38,7 +38,6 @@
 
 using water::File;
 using water::MemoryOutputStream;
-using water::XmlDocument;
 using water::XmlElement;
 
 CARLA_BACKEND_START_NAMESPACE
@@ -1519,9 +1518,8 @@ protected:
             pData->runner.start();
 
         fOptionsForced = true;
-        const water::String state(data);
-        XmlDocument xml(state);
-        loadProjectInternal(xml, true);
+        CarlaXmlStreamReader xmlReader(data, std::strlen(data));
+        loadProjectInternal(xmlReader, true);
 
         reloadFromUI();
     }
@@ -3068,6 +3066,8 @@ CARLA_BACKEND_END_NAMESPACE
 #include "CarlaPipeUtils.cpp"
 #include "CarlaProcessUtils.cpp"
 #include "CarlaStateUtils.cpp"
+#include "CarlaBinaryProjectUtils.cpp"
+#include "CarlaXmlStreamUtils.cpp"
 
 #endif /* CARLA_PLUGIN_BUILD */
 
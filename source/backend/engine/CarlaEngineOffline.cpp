@@ -0,0 +1,641 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaEngineGraph.hpp"
+#include "CarlaEngineInit.hpp"
+#include "CarlaEngineInternal.hpp"
+#include "CarlaMIDI.h"
+#include "CarlaMutex.hpp"
+
+#include "extra/Time.hpp"
+
+#include "water/files/File.h"
+#include "water/files/FileInputStream.h"
+#include "water/files/FileOutputStream.h"
+#include "water/midi/MidiFile.h"
+
+#include <algorithm>
+#include <vector>
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -------------------------------------------------------------------------------------------------------------------
+// Offline render file writer
+//
+// Writes interleaved audio into a 32-bit float WAV file from its own thread, so disk access does not stall rendering.
+// The render thread fills one block while the other one is being written.
+
+class CarlaEngineOfflineWriter : public CarlaThread
+{
+public:
+    static const uint32_t kBlockFrames = 16384;
+    static const uint32_t kNumChannels = 2;
+
+    CarlaEngineOfflineWriter() noexcept
+        : CarlaThread("CarlaEngineOfflineWriter"),
+          fStream(),
+          fQueuedSignal(),
+          fFreedSignal(),
+          fRenderBlock(0),
+          fRenderFrames(0),
+          fWriteBlock(0),
+          fDataSize(0),
+          fFailed(false)
+    {
+        carla_zeroStructs(fBlocks, 2);
+        carla_zeroStructs(fBlockFrames, 2);
+        carla_zeroStructs(fQueued, 2);
+    }
+
+    ~CarlaEngineOfflineWriter() override
+    {
+        close();
+    }
+
+    bool open(const char* const filename, const double sampleRate)
+    {
+        CARLA_SAFE_ASSERT_RETURN(fStream == nullptr, false);
+
+        const water::File file(filename);
+        file.deleteFile();
+
+        fStream = new water::FileOutputStream(file);
+
+        if (fStream->failedToOpen())
+        {
+            fStream = nullptr;
+            return false;
+        }
+
+        for (uint32_t i=0; i < 2; ++i)
+        {
+            if (fBlocks[i] == nullptr)
+                fBlocks[i] = new float[kBlockFrames * kNumChannels];
+
+            fBlockFrames[i] = 0;
+            fQueued[i] = false;
+        }
+
+        fRenderBlock = fRenderFrames = fWriteBlock = 0;
+        fDataSize = 0;
+        fFailed = false;
+
+        // sizes are filled in when closing
+        const uint32_t byteRate = static_cast<uint32_t>(sampleRate) * kNumChannels * sizeof(float);
+
+        fStream->write("RIFF", 4);
+        fStream->writeInt(0);
+        fStream->write("WAVEfmt ", 8);
+        fStream->writeInt(16);
+        fStream->writeShort(3); // WAVE_FORMAT_IEEE_FLOAT
+        fStream->writeShort(kNumChannels);
+        fStream->writeInt(static_cast<int>(sampleRate));
+        fStream->writeInt(static_cast<int>(byteRate));
+        fStream->writeShort(kNumChannels * sizeof(float));
+        fStream->writeShort(32);
+        fStream->write("data", 4);
+        fStream->writeInt(0);
+
+        return startThread();
+    }
+
+    // must be called from the render thread, waits if both blocks are full
+    void write(float* const* const buffers, const uint32_t frames)
+    {
+        for (uint32_t i=0; i < frames;)
+        {
+            if (fRenderFrames == kBlockFrames)
+                queueRenderBlock();
+
+            float* const block = fBlocks[fRenderBlock] + fRenderFrames * kNumChannels;
+            const uint32_t count = std::min(frames - i, kBlockFrames - fRenderFrames);
+
+            for (uint32_t j=0; j < count; ++j)
+            {
+                block[j * kNumChannels]     = buffers[0][i + j];
+                block[j * kNumChannels + 1] = buffers[1][i + j];
+            }
+
+            fRenderFrames += count;
+            i += count;
+        }
+    }
+
+    // write remaining audio and finish the file, returns false if any write failed
+    bool close()
+    {
+        if (fStream == nullptr)
+            return false;
+
+        if (fRenderFrames != 0)
+            queueRenderBlock();
+
+        for (uint32_t i=0; i < 2; ++i)
+            waitForBlock(i);
+
+        signalThreadShouldExit();
+        fQueuedSignal.signal();
+        stopThread(-1);
+
+        const uint32_t dataSize = static_cast<uint32_t>(std::min<uint64_t>(fDataSize, UINT32_MAX - 36));
+
+        if (fStream->setPosition(4))
+            fStream->writeInt(static_cast<int>(dataSize + 36));
+        else
+            fFailed = true;
+
+        if (fStream->setPosition(40))
+            fStream->writeInt(static_cast<int>(dataSize));
+        else
+            fFailed = true;
+
+        fStream->flush();
+
+        if (fStream->getStatus().failed())
+            fFailed = true;
+
+        fStream = nullptr;
+
+        for (uint32_t i=0; i < 2; ++i)
+        {
+            delete[] fBlocks[i];
+            fBlocks[i] = nullptr;
+        }
+
+        return !fFailed;
+    }
+
+protected:
+    void run() override
+    {
+        for (;;)
+        {
+            if (! __atomic_load_n(&fQueued[fWriteBlock], __ATOMIC_ACQUIRE))
+            {
+                if (shouldThreadExit())
+                    break;
+
+                fQueuedSignal.wait();
+                continue;
+            }
+
+            const std::size_t size = fBlockFrames[fWriteBlock] * kNumChannels * sizeof(float);
+
+            if (! fStream->write(fBlocks[fWriteBlock], size))
+                fFailed = true;
+
+            fDataSize += size;
+
+            __atomic_store_n(&fQueued[fWriteBlock], false, __ATOMIC_RELEASE);
+            fFreedSignal.signal();
+
+            fWriteBlock = 1 - fWriteBlock;
+        }
+    }
+
+private:
+    ScopedPointer<water::FileOutputStream> fStream;
+    CarlaSignal fQueuedSignal;
+    CarlaSignal fFreedSignal;
+
+    float* fBlocks[2];
+    uint32_t fBlockFrames[2];
+    bool fQueued[2];
+
+    // render thread only
+    uint32_t fRenderBlock;
+    uint32_t fRenderFrames;
+
+    // writer thread only
+    uint32_t fWriteBlock;
+    uint64_t fDataSize;
+    bool fFailed;
+
+    void queueRenderBlock()
+    {
+        fBlockFrames[fRenderBlock] = fRenderFrames;
+        __atomic_store_n(&fQueued[fRenderBlock], true, __ATOMIC_RELEASE);
+        fQueuedSignal.signal();
+
+        fRenderBlock = 1 - fRenderBlock;
+        fRenderFrames = 0;
+
+        waitForBlock(fRenderBlock);
+    }
+
+    void waitForBlock(const uint32_t block)
+    {
+        while (__atomic_load_n(&fQueued[block], __ATOMIC_ACQUIRE))
+            fFreedSignal.wait();
+    }
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaEngineOfflineWriter)
+};
+
+// -------------------------------------------------------------------------------------------------------------------
+// Offline Engine
+//
+// Renders the rack into an audio file as fast as possible, without any audio device or clock involved.
+// Rendering starts when the transport is played, with MIDI input taken from a file, and stops the transport once done.
+// While not rendering the engine only handles pending plugin actions, so projects can be loaded in the meantime.
+
+class CarlaEngineOffline : public CarlaEngine,
+                           public CarlaThread
+{
+public:
+    CarlaEngineOffline()
+        : CarlaEngine(),
+          CarlaThread("CarlaEngineOffline"),
+          fRunning(false),
+          fStartRequested(false),
+          fStopRequested(false),
+          fRenderLength(0),
+          fMidiEvents(),
+          fWriter()
+    {
+        carla_debug("CarlaEngineOffline::CarlaEngineOffline()");
+
+        // just to make sure
+        pData->options.transportMode = ENGINE_TRANSPORT_MODE_INTERNAL;
+    }
+
+    ~CarlaEngineOffline() override
+    {
+        carla_debug("CarlaEngineOffline::~CarlaEngineOffline()");
+    }
+
+    // -------------------------------------
+
+    bool init(const char* const clientName) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(clientName != nullptr && clientName[0] != '\0', false);
+        carla_debug("CarlaEngineOffline::init(\"%s\")", clientName);
+
+        if (pData->options.processMode != ENGINE_PROCESS_MODE_CONTINUOUS_RACK)
+        {
+            setLastError("Invalid process mode, the Offline driver only supports rack mode");
+            return false;
+        }
+
+        if (pData->options.offlineRenderFile == nullptr)
+        {
+            setLastError("No offline render file set");
+            return false;
+        }
+
+        fRunning = true;
+
+        if (! pData->init(clientName))
+        {
+            close();
+            setLastError("Failed to init internal data");
+            return false;
+        }
+
+        pData->bufferSize = pData->options.audioBufferSize;
+        pData->sampleRate = pData->options.audioSampleRate;
+        pData->initTime(pData->options.transportExtra);
+
+        double lastMidiTime = 0.0;
+
+        if (pData->options.offlineRenderMidiFile != nullptr && ! loadMidiFile(pData->options.offlineRenderMidiFile, lastMidiTime))
+        {
+            close();
+            setLastError("Failed to load offline render MIDI file");
+            return false;
+        }
+
+        const double renderLength = pData->options.offlineRenderLength != 0
+                                  ? static_cast<double>(pData->options.offlineRenderLength) / 1000.0
+                                  : lastMidiTime;
+        fRenderLength = static_cast<uint64_t>(renderLength * pData->sampleRate + 0.5);
+
+        if (fRenderLength == 0)
+        {
+            close();
+            setLastError("No offline render length set");
+            return false;
+        }
+
+        pData->graph.create(2, 2, 0, 0);
+
+        if (! startThread())
+        {
+            close();
+            setLastError("Failed to start offline render thread");
+            return false;
+        }
+
+        patchbayRefresh(true, false, false);
+
+        callback(true, true,
+                 ENGINE_CALLBACK_ENGINE_STARTED,
+                 0,
+                 pData->options.processMode,
+                 pData->options.transportMode,
+                 static_cast<int>(pData->bufferSize),
+                 static_cast<float>(pData->sampleRate),
+                 getCurrentDriverName());
+        return true;
+    }
+
+    bool close() override
+    {
+        carla_debug("CarlaEngineOffline::close()");
+
+        fRunning = false;
+        stopThread(-1);
+        CarlaEngine::close();
+
+        pData->graph.destroy();
+        fMidiEvents.clear();
+        return true;
+    }
+
+    bool hasIdleOnMainThread() const noexcept override
+    {
+        return true;
+    }
+
+    bool isRunning() const noexcept override
+    {
+        return fRunning;
+    }
+
+    bool isOffline() const noexcept override
+    {
+        return true;
+    }
+
+    EngineType getType() const noexcept override
+    {
+        return kEngineTypeDummy;
+    }
+
+    const char* getCurrentDriverName() const noexcept override
+    {
+        return "Offline";
+    }
+
+    // -------------------------------------------------------------------
+    // Transport, started and stopped by the render thread itself
+
+    void transportPlay() noexcept override
+    {
+        __atomic_store_n(&fStartRequested, true, __ATOMIC_RELEASE);
+    }
+
+    void transportPause() noexcept override
+    {
+        __atomic_store_n(&fStopRequested, true, __ATOMIC_RELEASE);
+    }
+
+    // -------------------------------------------------------------------
+    // Patchbay
+
+    bool patchbayRefresh(const bool sendHost, const bool sendOSC, const bool) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(pData->graph.isReady(), false);
+
+        RackGraph* const graph = pData->graph.getRackGraph();
+        CARLA_SAFE_ASSERT_RETURN(graph != nullptr, false);
+
+        ExternalGraph& extGraph(graph->extGraph);
+
+        // there are no external ports, the rack output is always rendered
+        extGraph.clear();
+
+        if (sendHost || sendOSC)
+            graph->refresh(sendHost, sendOSC, false, "Offline");
+
+        return true;
+    }
+
+    // -------------------------------------------------------------------
+
+protected:
+    void run() override
+    {
+        const uint32_t bufferSize = pData->bufferSize;
+
+        float* audioIns[2] = {
+            (float*)std::malloc(sizeof(float)*bufferSize),
+            (float*)std::malloc(sizeof(float)*bufferSize),
+        };
+        CARLA_SAFE_ASSERT_RETURN(audioIns[0] != nullptr,);
+        CARLA_SAFE_ASSERT_RETURN(audioIns[1] != nullptr,);
+
+        float* audioOuts[2] = {
+            (float*)std::malloc(sizeof(float)*bufferSize),
+            (float*)std::malloc(sizeof(float)*bufferSize),
+        };
+        CARLA_SAFE_ASSERT_RETURN(audioOuts[0] != nullptr,);
+        CARLA_SAFE_ASSERT_RETURN(audioOuts[1] != nullptr,);
+
+        carla_zeroFloats(audioIns[0], bufferSize);
+        carla_zeroFloats(audioIns[1], bufferSize);
+
+        while (! shouldThreadExit())
+        {
+            __atomic_store_n(&fStopRequested, false, __ATOMIC_RELEASE);
+
+            if (! __atomic_exchange_n(&fStartRequested, false, __ATOMIC_ACQ_REL))
+            {
+                // handle pending plugin actions while waiting
+                {
+                    const PendingRtEventsRunner prt(this, bufferSize);
+                }
+
+                d_msleep(10);
+                continue;
+            }
+
+            const float* inBuf[2] = { audioIns[0], audioIns[1] };
+            render(inBuf, audioOuts);
+        }
+
+        std::free(audioIns[0]);
+        std::free(audioIns[1]);
+        std::free(audioOuts[0]);
+        std::free(audioOuts[1]);
+    }
+
+    // -------------------------------------------------------------------
+
+private:
+    bool fRunning;
+    bool fStartRequested;
+    bool fStopRequested;
+
+    struct MidiEvent {
+        uint64_t frame;
+        uint8_t size;
+        uint8_t data[3];
+
+        bool operator<(const MidiEvent& other) const noexcept
+        {
+            return frame < other.frame;
+        }
+    };
+
+    uint64_t fRenderLength;
+    std::vector<MidiEvent> fMidiEvents;
+    CarlaEngineOfflineWriter fWriter;
+
+    bool loadMidiFile(const char* const filename, double& lastTime)
+    {
+        const water::File file(filename);
+
+        if (! file.existsAsFile())
+            return false;
+
+        water::FileInputStream fileStream(file);
+        water::MidiFile midiFile;
+
+        if (! midiFile.readFrom(fileStream))
+            return false;
+
+        midiFile.convertTimestampTicksToSeconds();
+
+        fMidiEvents.clear();
+
+        for (size_t i=0, numTracks = midiFile.getNumTracks(); i < numTracks; ++i)
+        {
+            const water::MidiMessageSequence* const track = midiFile.getTrack(i);
+            CARLA_SAFE_ASSERT_CONTINUE(track != nullptr);
+
+            for (int j=0, numEvents = track->getNumEvents(); j < numEvents; ++j)
+            {
+                const water::MidiMessageSequence::MidiEventHolder* const midiEventHolder = track->getEventPointer(j);
+                CARLA_SAFE_ASSERT_CONTINUE(midiEventHolder != nullptr);
+
+                const water::MidiMessage& midiMessage(midiEventHolder->message);
+
+                const int dataSize = midiMessage.getRawDataSize();
+                if (dataSize <= 0 || dataSize > 3)
+                    continue;
+
+                const uint8_t* const data = midiMessage.getRawData();
+                if (! MIDI_IS_CHANNEL_MESSAGE(data[0]))
+                    continue;
+
+                const double time = midiMessage.getTimeStamp() * pData->sampleRate;
+                CARLA_SAFE_ASSERT_CONTINUE(time >= 0.0);
+
+                MidiEvent event;
+                carla_zeroStruct(event);
+                event.frame = static_cast<uint64_t>(time + 0.5);
+                event.size = static_cast<uint8_t>(dataSize);
+                std::memcpy(event.data, data, static_cast<std::size_t>(dataSize));
+
+                fMidiEvents.push_back(event);
+            }
+        }
+
+        // tracks are merged, keeping the order of simultaneous events within each track
+        std::stable_sort(fMidiEvents.begin(), fMidiEvents.end());
+
+        lastTime = midiFile.getLastTimestamp();
+        return true;
+    }
+
+    void render(const float* audioIns[2], float* audioOuts[2])
+    {
+        const uint32_t bufferSize = pData->bufferSize;
+        const char* const filename = pData->options.offlineRenderFile;
+
+        if (! fWriter.open(filename, pData->sampleRate))
+        {
+            carla_stderr2("CarlaEngineOffline: failed to open '%s' for writing", filename);
+            return;
+        }
+
+        carla_stdout("CarlaEngineOffline: rendering " P_UINT64 " frames into '%s'", fRenderLength, filename);
+
+        const uint32_t startTime = d_gettime_ms();
+        std::size_t midiIndex = 0;
+        uint32_t lateMidiEvents = 0;
+        uint64_t frame = 0;
+
+        CarlaEngine::transportPlay();
+
+        while (frame < fRenderLength)
+        {
+            if (shouldThreadExit() || __atomic_load_n(&fStopRequested, __ATOMIC_ACQUIRE))
+            {
+                carla_stdout("CarlaEngineOffline: render stopped after " P_UINT64 " frames", frame);
+                break;
+            }
+
+            {
+                const PendingRtEventsRunner prt(this, bufferSize, true);
+
+                carla_zeroFloats(audioOuts[0], bufferSize);
+                carla_zeroFloats(audioOuts[1], bufferSize);
+                carla_zeroStructs(pData->events.in,  kMaxEngineEventInternalCount);
+                carla_zeroStructs(pData->events.out, kMaxEngineEventInternalCount);
+
+                for (uint32_t i = 0; midiIndex < fMidiEvents.size() && i < kMaxEngineEventInternalCount; ++midiIndex, ++i)
+                {
+                    const MidiEvent& midiEvent(fMidiEvents[midiIndex]);
+
+                    if (midiEvent.frame >= frame + bufferSize)
+                        break;
+
+                    EngineEvent& engineEvent(pData->events.in[i]);
+
+                    // carried over from a previous block that had too many events, play it as soon as possible
+                    if (midiEvent.frame < frame)
+                    {
+                        engineEvent.time = 0;
+                        ++lateMidiEvents;
+                    }
+                    else
+                    {
+                        engineEvent.time = static_cast<uint32_t>(midiEvent.frame - frame);
+                    }
+
+                    engineEvent.fillFromMidiData(midiEvent.size, midiEvent.data, 0);
+                }
+
+                pData->graph.processRack(pData, audioIns, audioOuts, bufferSize);
+            }
+
+            const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(bufferSize, fRenderLength - frame));
+            fWriter.write(audioOuts, frames);
+            frame += frames;
+        }
+
+        CarlaEngine::transportPause();
+
+        if (! fWriter.close())
+            carla_stderr2("CarlaEngineOffline: failed to write '%s'", filename);
+
+        if (lateMidiEvents != 0)
+            carla_stderr("CarlaEngineOffline: %u MIDI events were delayed to a later block, too many events at once",
+                         lateMidiEvents);
+
+        const double renderTime = static_cast<double>(d_gettime_ms() - startTime) / 1000.0;
+        const double audioTime = static_cast<double>(frame) / pData->sampleRate;
+
+        carla_stdout("CarlaEngineOffline: rendered %.1fs of audio in %.1fs (%.1fx realtime)",
+                     audioTime, renderTime, renderTime > 0.0 ? audioTime / renderTime : 0.0);
+    }
+
+    CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaEngineOffline)
+};
+
+// -----------------------------------------
+
+namespace EngineInit {
+
+CarlaEngine* newOffline()
+{
+    return new CarlaEngineOffline();
+}
+
+}
+
+// -----------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
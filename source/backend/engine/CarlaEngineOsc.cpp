@@ -33,7 +33,8 @@ CarlaEngineOsc::CarlaEngineOsc(CarlaEngine* const engine) noexcept
       fServerPathTCP(),
       fServerPathUDP(),
       fServerTCP(nullptr),
-      fServerUDP(nullptr)
+      fServerUDP(nullptr),
+      fUpdates()
 {
     CARLA_SAFE_ASSERT(engine != nullptr);
     carla_debug("CarlaEngineOsc::CarlaEngineOsc(%p)", engine);
@@ -204,6 +205,9 @@ void CarlaEngineOsc::close() noexcept
 
     fControlDataTCP.clear();
     fControlDataUDP.clear();
+
+    fUpdates.clear();
+    fUpdates.resetRates();
 }
 
 // -----------------------------------------------------------------------
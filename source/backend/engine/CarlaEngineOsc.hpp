@@ -15,6 +15,8 @@
 
 #include "extra/String.hpp"
 
+#include <map>
+
 #define CARLA_ENGINE_OSC_HANDLE_ARGS const CarlaPluginPtr& plugin, \
   const int argc, const lo_arg* const* const argv, const char* const types
 
@@ -100,10 +102,17 @@ public:
 
     // -------------------------------------------------------------------
     // UDP
+    //
+    // Parameter values and peaks are queued and only sent on flushUDP(), coalesced into bundles.
+    // Values superseded before being sent are dropped, as are values that did not change since last sent.
+    // Meters (peaks and runtime info) and parameters are each sent at their own rate, which the client can change.
+
+    void queueParameterValue(uint pluginId, uint32_t index, float value) noexcept;
+    void queuePeaks(uint pluginId, const float peaks[4]) noexcept;
+    void flushUDP() noexcept;
 
-    void sendRuntimeInfo() const noexcept;
-    void sendParameterValue(uint pluginId, uint32_t index, float value) const noexcept;
-    void sendPeaks(uint pluginId, const float peaks[4]) const noexcept;
+    // make the next flush send everything again, for when plugin ids change
+    void resetUDP() noexcept;
 
     // -------------------------------------------------------------------
 
@@ -120,6 +129,34 @@ private:
     lo_server fServerTCP;
     lo_server fServerUDP;
 
+    struct PeakValues {
+        float values[4];
+    };
+
+    struct UpdateScheduler {
+        // send intervals in ms, 0 means disabled, set from the OSC thread so always accessed atomically
+        uint32_t meterInterval;
+        uint32_t parameterInterval;
+        uint32_t lastMeterTime;
+        uint32_t lastParameterTime;
+        uint32_t lastProcessTimeTime;
+        uint32_t lastFullRefreshTime;
+        bool resetPending;
+
+        // key is plugin id in the upper 32 bits, parameter index in the lower ones
+        std::map<uint64_t, float> pendingParameters;
+        std::map<uint64_t, float> sentParameters;
+        std::map<uint, PeakValues> pendingPeaks;
+        std::map<uint, PeakValues> sentPeaks;
+
+        UpdateScheduler() noexcept;
+        void setRates(uint32_t meterRate, uint32_t parameterRate) noexcept;
+        uint32_t getMeterInterval() const noexcept;
+        uint32_t getParameterInterval() const noexcept;
+        void resetRates() noexcept;
+        void clear() noexcept;
+    } fUpdates;
+
     // -------------------------------------------------------------------
 
     int handleMessage(bool isTCP, const char* path,
@@ -130,6 +167,9 @@ private:
     int handleMsgControl(const char* method,
                          int argc, const lo_arg* const* argv, const char* types);
 
+    void addToBundle(lo_bundle& bundle, const char* path, lo_message msg) const noexcept;
+    void sendBundle(lo_bundle& bundle) const noexcept;
+
     // Internal methods
     int handleMsgSetActive(CARLA_ENGINE_OSC_HANDLE_ARGS);
     int handleMsgSetDryWet(CARLA_ENGINE_OSC_HANDLE_ARGS);
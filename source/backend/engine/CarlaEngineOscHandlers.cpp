@@ -253,6 +253,10 @@ int CarlaEngineOsc::handleMsgRegister(const bool isTCP,
         free(targeturl);
         free(port);
 
+        // new client needs to receive everything
+        if (! isTCP)
+            resetUDP();
+
         if (isTCP)
         {
             const EngineOptions& opts(fEngine->getOptions());
@@ -318,6 +322,10 @@ int CarlaEngineOsc::handleMsgUnregister(const bool isTCP,
 
     carla_stdout("OSC client %s unregistered", url);
     oscData.clear();
+
+    if (isTCP)
+        fUpdates.resetRates();
+
     return 0;
 }
 
@@ -351,6 +359,21 @@ int CarlaEngineOsc::handleMsgControl(const char* const method,
         ok = true;
         fEngine->setActionCanceled(true);
     }
+    else if (std::strcmp(method, "set_update_rates") == 0)
+    {
+        CARLA_SAFE_ASSERT_RETURN_OSC_ERR(argc == 3);
+        CARLA_SAFE_ASSERT_RETURN_OSC_ERR(types[1] == 'i');
+        CARLA_SAFE_ASSERT_RETURN_OSC_ERR(types[2] == 'i');
+
+        const int32_t meterRate = argv[1]->i;
+        CARLA_SAFE_ASSERT_RETURN_OSC_ERR(meterRate >= 0);
+
+        const int32_t parameterRate = argv[2]->i;
+        CARLA_SAFE_ASSERT_RETURN_OSC_ERR(parameterRate >= 0);
+
+        ok = true;
+        fUpdates.setRates(static_cast<uint32_t>(meterRate), static_cast<uint32_t>(parameterRate));
+    }
     else if (std::strcmp(method, "patchbay_connect") == 0)
     {
         CARLA_SAFE_ASSERT_RETURN_OSC_ERR(argc == 6);
@@ -688,6 +711,19 @@ int CarlaEngineOsc::handleMsgSetParameterValue(CARLA_ENGINE_OSC_HANDLE_ARGS)
 
     CARLA_SAFE_ASSERT_RETURN(index >= 0, 0);
 
+    // apply on the next audio cycle if possible, fallback to regular path if engine is stopped or queue is full.
+    // the id is checked against the current plugin list after taking the generation, so it cannot go stale unnoticed
+    if (fEngine->isRunning())
+    {
+        EngineRtParameterQueue& queue(fEngine->pData->oscParameters);
+        const uint32_t generation = queue.getGeneration();
+        const uint pluginId = plugin->getId();
+
+        if (fEngine->getPluginUnchecked(pluginId) == plugin &&
+            queue.append(generation, pluginId, static_cast<uint32_t>(index), value))
+            return 0;
+    }
+
     plugin->setParameterValue(static_cast<uint32_t>(index), value, true, false, true);
     return 0;
 }
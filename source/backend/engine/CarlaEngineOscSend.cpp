@@ -21,8 +21,11 @@
 
 #include "CarlaBackendUtils.hpp"
 #include "CarlaEngine.hpp"
+#include "CarlaMathUtils.hpp"
 #include "CarlaPlugin.hpp"
 
+#include "water/misc/Time.h"
+
 CARLA_BACKEND_START_NAMESPACE
 
 static const char* const kNullString = "";
@@ -349,54 +352,281 @@ void CarlaEngineOsc::sendExit() const noexcept
 
 // -----------------------------------------------------------------------
 
-void CarlaEngineOsc::sendRuntimeInfo() const noexcept
+// keep bundles small enough to fit in a single UDP packet
+static const std::size_t kMaxBundleSize = 1400;
+
+// default update rates, in Hz
+static const uint32_t kDefaultMeterRate = 20;
+static const uint32_t kDefaultParameterRate = 40;
+
+// UDP bundles can get lost, so everything is sent again from time to time, in ms
+static const uint32_t kFullRefreshInterval = 5000;
+
+static uint64_t getParameterKey(const uint pluginId, const uint32_t index) noexcept
+{
+    return (static_cast<uint64_t>(pluginId) << 32) | index;
+}
+
+CarlaEngineOsc::UpdateScheduler::UpdateScheduler() noexcept
+    : meterInterval(0),
+      parameterInterval(0),
+      lastMeterTime(0),
+      lastParameterTime(0),
+      lastProcessTimeTime(0),
+      lastFullRefreshTime(0),
+      resetPending(false),
+      pendingParameters(),
+      sentParameters(),
+      pendingPeaks(),
+      sentPeaks()
+{
+    resetRates();
+}
+
+void CarlaEngineOsc::UpdateScheduler::setRates(const uint32_t meterRate, const uint32_t parameterRate) noexcept
+{
+    __atomic_store_n(&meterInterval, meterRate != 0 ? std::max(1000U / meterRate, 1U) : 0U, __ATOMIC_RELAXED);
+    __atomic_store_n(&parameterInterval, parameterRate != 0 ? std::max(1000U / parameterRate, 1U) : 0U, __ATOMIC_RELAXED);
+}
+
+uint32_t CarlaEngineOsc::UpdateScheduler::getMeterInterval() const noexcept
+{
+    return __atomic_load_n(&meterInterval, __ATOMIC_RELAXED);
+}
+
+uint32_t CarlaEngineOsc::UpdateScheduler::getParameterInterval() const noexcept
 {
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.path != nullptr && fControlDataUDP.path[0] != '\0',);
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.target != nullptr,);
-
-    const EngineTimeInfo timeInfo(fEngine->getTimeInfo());
-
-    char targetPath[std::strlen(fControlDataUDP.path)+9];
-    std::strcpy(targetPath, fControlDataUDP.path);
-    std::strcat(targetPath, "/runtime");
-    try_lo_send(fControlDataUDP.target, targetPath, "fiihiiif",
-                static_cast<double>(fEngine->getDSPLoad()),
-                static_cast<int32_t>(fEngine->getTotalXruns()),
-                timeInfo.playing ? 1 : 0,
-                static_cast<int64_t>(timeInfo.frame),
-                static_cast<int32_t>(timeInfo.bbt.bar),
-                static_cast<int32_t>(timeInfo.bbt.beat),
-                static_cast<int32_t>(timeInfo.bbt.tick),
-                timeInfo.bbt.beatsPerMinute);
+    return __atomic_load_n(&parameterInterval, __ATOMIC_RELAXED);
 }
 
-void CarlaEngineOsc::sendParameterValue(const uint pluginId, const uint32_t index, const float value) const noexcept
+void CarlaEngineOsc::UpdateScheduler::resetRates() noexcept
 {
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.path != nullptr && fControlDataUDP.path[0] != '\0',);
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.target != nullptr,);
-
-    char targetPath[std::strlen(fControlDataUDP.path)+7];
-    std::strcpy(targetPath, fControlDataUDP.path);
-    std::strcat(targetPath, "/param");
-    try_lo_send(fControlDataUDP.target, targetPath, "iif",
-                static_cast<int32_t>(pluginId),
-                index,
-                static_cast<double>(value));
+    setRates(kDefaultMeterRate, kDefaultParameterRate);
 }
 
-void CarlaEngineOsc::sendPeaks(const uint pluginId, const float peaks[4]) const noexcept
+void CarlaEngineOsc::UpdateScheduler::clear() noexcept
 {
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.path != nullptr && fControlDataUDP.path[0] != '\0',);
-    CARLA_SAFE_ASSERT_RETURN(fControlDataUDP.target != nullptr,);
-
-    char targetPath[std::strlen(fControlDataUDP.path)+7];
-    std::strcpy(targetPath, fControlDataUDP.path);
-    std::strcat(targetPath, "/peaks");
-    try_lo_send(fControlDataUDP.target, targetPath, "iffff", static_cast<int32_t>(pluginId),
-                static_cast<double>(peaks[0]),
-                static_cast<double>(peaks[1]),
-                static_cast<double>(peaks[2]),
-                static_cast<double>(peaks[3]));
+    pendingParameters.clear();
+    sentParameters.clear();
+    pendingPeaks.clear();
+    sentPeaks.clear();
+    lastMeterTime = lastParameterTime = lastProcessTimeTime = lastFullRefreshTime = 0;
+}
+
+// -----------------------------------------------------------------------
+
+void CarlaEngineOsc::queueParameterValue(const uint pluginId, const uint32_t index, const float value) noexcept
+{
+    if (fUpdates.getParameterInterval() == 0)
+        return;
+
+    try {
+        fUpdates.pendingParameters[getParameterKey(pluginId, index)] = value;
+    } CARLA_SAFE_EXCEPTION("queueParameterValue");
+}
+
+void CarlaEngineOsc::queuePeaks(const uint pluginId, const float peaks[4]) noexcept
+{
+    if (fUpdates.getMeterInterval() == 0)
+        return;
+
+    try {
+        const std::map<uint, PeakValues>::iterator it = fUpdates.pendingPeaks.find(pluginId);
+
+        if (it == fUpdates.pendingPeaks.end())
+        {
+            PeakValues& pending(fUpdates.pendingPeaks[pluginId]);
+            carla_copyFloats(pending.values, peaks, 4);
+            return;
+        }
+
+        // hold the highest peak until the next send
+        for (int i=0; i<4; ++i)
+            it->second.values[i] = std::max(it->second.values[i], peaks[i]);
+    } CARLA_SAFE_EXCEPTION("queuePeaks");
+}
+
+void CarlaEngineOsc::flushUDP() noexcept
+{
+    if (__atomic_exchange_n(&fUpdates.resetPending, false, __ATOMIC_SEQ_CST))
+    {
+        fUpdates.sentParameters.clear();
+        fUpdates.sentPeaks.clear();
+    }
+
+    if (fControlDataUDP.target == nullptr || fControlDataUDP.path == nullptr || fControlDataUDP.path[0] == '\0')
+    {
+        fUpdates.pendingParameters.clear();
+        fUpdates.pendingPeaks.clear();
+        return;
+    }
+
+    const uint32_t timeNow = water::Time::getMillisecondCounter();
+    const uint32_t meterInterval = fUpdates.getMeterInterval();
+    const uint32_t parameterInterval = fUpdates.getParameterInterval();
+
+    // values are queued on every cycle, forgetting what was sent makes the next updates include everything
+    if (timeNow - fUpdates.lastFullRefreshTime >= kFullRefreshInterval)
+    {
+        fUpdates.lastFullRefreshTime = timeNow;
+        fUpdates.sentParameters.clear();
+        fUpdates.sentPeaks.clear();
+    }
+
+    const bool sendMeters = meterInterval != 0
+                         && timeNow - fUpdates.lastMeterTime >= meterInterval;
+    const bool sendParameters = parameterInterval != 0
+                             && timeNow - fUpdates.lastParameterTime >= parameterInterval;
+
+    if (! (sendMeters || sendParameters))
+        return;
+
+    const std::size_t pathlen = std::strlen(fControlDataUDP.path);
+    lo_bundle bundle = nullptr;
+
+    try {
+        if (sendMeters)
+        {
+            fUpdates.lastMeterTime = timeNow;
+
+            char targetPath[pathlen+9];
+            std::strcpy(targetPath, fControlDataUDP.path);
+            std::strcat(targetPath, "/runtime");
+
+            const EngineTimeInfo timeInfo(fEngine->getTimeInfo());
+
+            const lo_message msg = lo_message_new();
+            lo_message_add_float(msg, fEngine->getDSPLoad());
+            lo_message_add_int32(msg, static_cast<int32_t>(fEngine->getTotalXruns()));
+            lo_message_add_int32(msg, timeInfo.playing ? 1 : 0);
+            lo_message_add_int64(msg, static_cast<int64_t>(timeInfo.frame));
+            lo_message_add_int32(msg, static_cast<int32_t>(timeInfo.bbt.bar));
+            lo_message_add_int32(msg, static_cast<int32_t>(timeInfo.bbt.beat));
+            lo_message_add_int32(msg, static_cast<int32_t>(timeInfo.bbt.tick));
+            lo_message_add_float(msg, static_cast<float>(timeInfo.bbt.beatsPerMinute));
+            addToBundle(bundle, targetPath, msg);
+
+            std::strcpy(targetPath, fControlDataUDP.path);
+            std::strcat(targetPath, "/peaks");
+
+            for (std::map<uint, PeakValues>::const_iterator it = fUpdates.pendingPeaks.begin(),
+                 end = fUpdates.pendingPeaks.end(); it != end; ++it)
+            {
+                const std::map<uint, PeakValues>::iterator sent = fUpdates.sentPeaks.find(it->first);
+
+                if (sent != fUpdates.sentPeaks.end()
+                    && std::memcmp(sent->second.values, it->second.values, sizeof(float)*4) == 0)
+                    continue;
+
+                fUpdates.sentPeaks[it->first] = it->second;
+
+                const lo_message peaksMsg = lo_message_new();
+                lo_message_add_int32(peaksMsg, static_cast<int32_t>(it->first));
+                lo_message_add_float(peaksMsg, it->second.values[0]);
+                lo_message_add_float(peaksMsg, it->second.values[1]);
+                lo_message_add_float(peaksMsg, it->second.values[2]);
+                lo_message_add_float(peaksMsg, it->second.values[3]);
+                addToBundle(bundle, targetPath, peaksMsg);
+            }
+
+            fUpdates.pendingPeaks.clear();
+
+            // process time statistics only change once per second
+            if (timeNow - fUpdates.lastProcessTimeTime >= 1000)
+            {
+                fUpdates.lastProcessTimeTime = timeNow;
+
+                std::strcpy(targetPath, fControlDataUDP.path);
+                std::strcat(targetPath, "/ptime");
+
+                float meanLoad, p99Load, maxLoad;
+                uint32_t blockCount;
+
+                for (uint i=0, count=fEngine->getCurrentPluginCount(); i < count; ++i)
+                {
+                    if (! fEngine->getPluginProcessTime(i, meanLoad, p99Load, maxLoad, blockCount))
+                        continue;
+
+                    const lo_message ptimeMsg = lo_message_new();
+                    lo_message_add_int32(ptimeMsg, static_cast<int32_t>(i));
+                    lo_message_add_float(ptimeMsg, meanLoad);
+                    lo_message_add_float(ptimeMsg, p99Load);
+                    lo_message_add_float(ptimeMsg, maxLoad);
+                    lo_message_add_int32(ptimeMsg, static_cast<int32_t>(blockCount));
+                    addToBundle(bundle, targetPath, ptimeMsg);
+                }
+            }
+        }
+
+        if (sendParameters)
+        {
+            fUpdates.lastParameterTime = timeNow;
+
+            char targetPath[pathlen+7];
+            std::strcpy(targetPath, fControlDataUDP.path);
+            std::strcat(targetPath, "/param");
+
+            for (std::map<uint64_t, float>::const_iterator it = fUpdates.pendingParameters.begin(),
+                 end = fUpdates.pendingParameters.end(); it != end; ++it)
+            {
+                const std::map<uint64_t, float>::iterator sent = fUpdates.sentParameters.find(it->first);
+
+                if (sent != fUpdates.sentParameters.end() && carla_isEqual(sent->second, it->second))
+                    continue;
+
+                fUpdates.sentParameters[it->first] = it->second;
+
+                const lo_message msg = lo_message_new();
+                lo_message_add_int32(msg, static_cast<int32_t>(it->first >> 32));
+                lo_message_add_int32(msg, static_cast<int32_t>(it->first & 0xffffffff));
+                lo_message_add_float(msg, it->second);
+                addToBundle(bundle, targetPath, msg);
+            }
+
+            fUpdates.pendingParameters.clear();
+        }
+    } CARLA_SAFE_EXCEPTION("flushUDP");
+
+    sendBundle(bundle);
+}
+
+void CarlaEngineOsc::resetUDP() noexcept
+{
+    __atomic_store_n(&fUpdates.resetPending, true, __ATOMIC_SEQ_CST);
+}
+
+void CarlaEngineOsc::addToBundle(lo_bundle& bundle, const char* const path, const lo_message msg) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(msg != nullptr,);
+
+    if (bundle == nullptr)
+    {
+        bundle = lo_bundle_new(LO_TT_IMMEDIATE);
+
+        if (bundle == nullptr)
+        {
+            lo_message_free(msg);
+            return;
+        }
+    }
+
+    lo_bundle_add_message(bundle, path, msg);
+
+    if (lo_bundle_length(bundle) >= kMaxBundleSize)
+        sendBundle(bundle);
+}
+
+void CarlaEngineOsc::sendBundle(lo_bundle& bundle) const noexcept
+{
+    if (bundle == nullptr)
+        return;
+
+    try {
+        lo_send_bundle(fControlDataUDP.target, bundle);
+    } CARLA_SAFE_EXCEPTION("lo_send_bundle");
+
+    lo_bundle_free_recursive(bundle);
+    bundle = nullptr;
 }
 
 // -----------------------------------------------------------------------
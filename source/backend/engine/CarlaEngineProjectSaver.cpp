@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaEngineProjectSaver.hpp"
+#include "CarlaEngineInternal.hpp"
+#include "CarlaBinaryProjectUtils.hpp"
+
+#include "water/files/File.h"
+#include "water/streams/MemoryOutputStream.h"
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+CarlaEngineProjectSaver::CarlaEngineProjectSaver(CarlaEngine* const engine) noexcept
+    : CarlaThread("CarlaEngineProjectSaver"),
+      kEngine(engine),
+      fFilename(),
+      fDocument(),
+      fWriter(),
+      fBinary(false),
+      fCurrentProject(false),
+      fState(kStateIdle),
+      fSuccess(false),
+      fProgress(0.0f),
+      fLastProgress(0.0f)
+{
+    CARLA_SAFE_ASSERT(engine != nullptr);
+}
+
+CarlaEngineProjectSaver::~CarlaEngineProjectSaver()
+{
+    // never lose a save in progress
+    stopThread(-1);
+}
+
+bool CarlaEngineProjectSaver::isBusy() const noexcept
+{
+    return __atomic_load_n(&fState, __ATOMIC_ACQUIRE) != kStateIdle;
+}
+
+bool CarlaEngineProjectSaver::start(const char* const filename, const water::MemoryOutputStream& document,
+                                    CarlaBinaryProjectWriter* const writer, const bool binary,
+                                    const bool currentProject)
+{
+    CARLA_SAFE_ASSERT_RETURN(filename != nullptr && filename[0] != '\0', false);
+    CARLA_SAFE_ASSERT_RETURN(writer != nullptr, false);
+
+    ScopedPointer<CarlaBinaryProjectWriter> writerPtr(writer);
+    CARLA_SAFE_ASSERT_RETURN(! isBusy(), false);
+
+    // previous thread has finished but might have not been joined yet
+    stopThread(-1);
+
+    fFilename = filename;
+    fDocument = water::MemoryBlock(document.getData(), document.getDataSize());
+    fWriter = writerPtr.release();
+    fBinary = binary;
+    fCurrentProject = currentProject;
+    fSuccess = false;
+    fProgress = 0.0f;
+    fLastProgress = 0.0f;
+
+    __atomic_store_n(&fState, kStateRunning, __ATOMIC_RELEASE);
+
+    if (startThread())
+        return true;
+
+    __atomic_store_n(&fState, kStateIdle, __ATOMIC_RELEASE);
+    fWriter = nullptr;
+    return false;
+}
+
+void CarlaEngineProjectSaver::wait()
+{
+    if (! isBusy())
+        return;
+
+    stopThread(-1);
+    idle();
+}
+
+void CarlaEngineProjectSaver::idle()
+{
+    switch (__atomic_load_n(&fState, __ATOMIC_ACQUIRE))
+    {
+    case kStateRunning: {
+        const float progress = fProgress;
+
+        // avoid flooding the frontend
+        if (progress - fLastProgress >= 0.01f)
+        {
+            fLastProgress = progress;
+            kEngine->callback(true, true, ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS, 0, 0, 0, 0, progress, fFilename);
+        }
+    }   break;
+
+    case kStateFinished:
+        fWriter = nullptr;
+        fDocument.reset();
+
+        if (! fSuccess)
+            kEngine->setLastError("Failed to write file");
+
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+        if (fCurrentProject)
+            kEngine->pData->autosave.finishSaved(fSuccess);
+#endif
+
+        kEngine->callback(true, true, ENGINE_CALLBACK_PROJECT_SAVE_FINISHED, 0, fSuccess ? 1 : 0, 0, 0, 1.0f, fFilename);
+        __atomic_store_n(&fState, kStateIdle, __ATOMIC_RELEASE);
+        break;
+    }
+}
+
+void CarlaEngineProjectSaver::run()
+{
+    const water::File file(fFilename.buffer());
+
+    fWriter->setProgressCallback(progressCallback, this);
+
+    fSuccess = fBinary ? fWriter->writeToFile(file, fDocument.getData(), fDocument.getSize())
+                       : fWriter->writeToXmlFile(file, fDocument.getData(), fDocument.getSize());
+
+    if (! fSuccess)
+        carla_stderr2("CarlaEngineProjectSaver::run() - failed to write '%s'", fFilename.buffer());
+
+    __atomic_store_n(&fState, kStateFinished, __ATOMIC_RELEASE);
+}
+
+void CarlaEngineProjectSaver::progressCallback(void* const ptr, const float progress)
+{
+    static_cast<CarlaEngineProjectSaver*>(ptr)->fProgress = progress;
+}
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
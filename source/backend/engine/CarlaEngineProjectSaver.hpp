@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_ENGINE_PROJECT_SAVER_HPP_INCLUDED
+#define CARLA_ENGINE_PROJECT_SAVER_HPP_INCLUDED
+
+#include "CarlaBackend.h"
+#include "CarlaThread.hpp"
+
+#include "extra/ScopedPointer.hpp"
+#include "extra/String.hpp"
+
+#include "water/memory/MemoryBlock.h"
+
+namespace water {
+class MemoryOutputStream;
+}
+
+CARLA_BACKEND_START_NAMESPACE
+
+class CarlaBinaryProjectWriter;
+
+// -----------------------------------------------------------------------
+// CarlaEngineProjectSaver
+//
+// Writes a project snapshot to disk in a background thread.
+// The snapshot (document plus plugin chunks) is taken by the engine on the main thread,
+// everything after that (encoding, compression and file writes) happens here.
+
+class CarlaEngineProjectSaver : private CarlaThread
+{
+public:
+    CarlaEngineProjectSaver(CarlaEngine* engine) noexcept;
+    ~CarlaEngineProjectSaver() override;
+
+    bool isBusy() const noexcept;
+
+    // start writing a snapshot, takes ownership of writer
+    // currentProject signals that the file is the current project, so its autosave can be discarded once written
+    bool start(const char* filename, const water::MemoryOutputStream& document,
+               CarlaBinaryProjectWriter* writer, bool binary, bool currentProject);
+
+    // block until the current save has finished, reporting its result
+    void wait();
+
+    // report progress and completion through engine callbacks, must be called from the main thread
+    void idle();
+
+protected:
+    void run() override;
+
+private:
+    CarlaEngine* const kEngine;
+
+    String fFilename;
+    water::MemoryBlock fDocument;
+    ScopedPointer<CarlaBinaryProjectWriter> fWriter;
+    bool fBinary;
+    bool fCurrentProject;
+
+    enum State {
+        kStateIdle,
+        kStateRunning,
+        kStateFinished
+    };
+
+    // written by the saver thread
+    volatile int fState;
+    volatile bool fSuccess;
+    volatile float fProgress;
+
+    float fLastProgress;
+
+    static void progressCallback(void* ptr, float progress);
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaEngineProjectSaver)
+};
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_ENGINE_PROJECT_SAVER_HPP_INCLUDED
@@ -618,9 +618,15 @@ protected:
         const PendingRtEventsRunner prt(this, nframes, true);
 
         if (status & RTAUDIO_INPUT_OVERFLOW)
+        {
             ++pData->xruns;
+            pData->flightRecorder.xrun();
+        }
         if (status & RTAUDIO_OUTPUT_UNDERFLOW)
+        {
             ++pData->xruns;
+            pData->flightRecorder.xrun();
+        }
 
         // get buffers from RtAudio
         const float* const insPtr  = (const float*)inputBuffer;
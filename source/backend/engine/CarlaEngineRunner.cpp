@@ -70,7 +70,7 @@ bool CarlaEngineRunner::run() noexcept
 
 #if defined(HAVE_LIBLO) && ! defined(BUILD_BRIDGE)
     // int64_t lastPingTime = 0;
-    const CarlaEngineOsc& engineOsc(kEngine->pData->osc);
+    CarlaEngineOsc& engineOsc(kEngine->pData->osc);
 #endif
 
     // runner must do something...
@@ -126,7 +126,7 @@ bool CarlaEngineRunner::run() noexcept
 #if defined(HAVE_LIBLO) && ! defined(BUILD_BRIDGE)
                 // Update OSC engine client
                 if (oscRegistedForUDP)
-                    engineOsc.sendParameterValue(i, j, value);
+                    engineOsc.queueParameterValue(i, j, value);
 #endif
                 // Update UI
                 if (updateUI)
@@ -146,13 +146,13 @@ bool CarlaEngineRunner::run() noexcept
         // Update OSC control client peaks
 
         if (oscRegistedForUDP)
-            engineOsc.sendPeaks(i, kEngine->getPeaks(i));
+            engineOsc.queuePeaks(i, kEngine->getPeaks(i));
 #endif
     }
 
 #if defined(HAVE_LIBLO) && !defined(BUILD_BRIDGE)
     if (oscRegistedForUDP)
-        engineOsc.sendRuntimeInfo();
+        engineOsc.flushUDP();
 
     /*
     if (engineOsc.isControlRegisteredForTCP())
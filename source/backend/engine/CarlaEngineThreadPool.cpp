@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaEngineThreadPool.hpp"
+
+#include "CarlaSemUtils.hpp"
+#include "CarlaThread.hpp"
+
+#ifndef CARLA_OS_WIN
+# include <sched.h>
+# include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+# include <emmintrin.h>
+#endif
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+static const uint32_t kMaxWorkerCount = 16;
+
+// number of busy-wait iterations before starting to yield the CPU
+static const uint32_t kMaxSpinCount = 1000;
+
+static inline
+void waitPause(uint32_t& spinCount) noexcept
+{
+    if (spinCount < kMaxSpinCount)
+    {
+        ++spinCount;
+#if defined(__SSE2__) || defined(_M_X64)
+        _mm_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+        __asm__ __volatile__("yield");
+#endif
+        return;
+    }
+
+#ifdef CARLA_OS_WIN
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+#ifndef CARLA_OS_WASM
+class CarlaEngineThreadPool::Worker : public CarlaThread
+{
+public:
+    Worker(CarlaEngineThreadPool* const pool) noexcept
+        : CarlaThread("CarlaEngineThreadPool"),
+          kPool(pool),
+          fSem(),
+          fSemValid(carla_sem_create2(fSem, false)),
+          fState(kStateIdle) {}
+
+    ~Worker() override
+    {
+        stopThread(1000);
+
+        if (fSemValid)
+            carla_sem_destroy2(fSem);
+    }
+
+    bool isValid() const noexcept
+    {
+        return fSemValid;
+    }
+
+    bool isRunning() const noexcept
+    {
+        return __atomic_load_n(&fState, __ATOMIC_ACQUIRE) == kStateRunning;
+    }
+
+    // only called while idle
+    void wake() noexcept
+    {
+        __atomic_store_n(&fState, kStateWoken, __ATOMIC_RELEASE);
+        carla_sem_post(fSem);
+    }
+
+    // take back a wake request the worker did not pick up yet, returns false if it is already running
+    bool cancel() noexcept
+    {
+        int expected = kStateWoken;
+        return __atomic_compare_exchange_n(&fState, &expected, kStateIdle, false,
+                                           __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
+
+protected:
+    void run() override
+    {
+        while (! shouldThreadExit())
+        {
+            if (! carla_sem_timedwait(fSem, 100))
+                continue;
+
+            // the request was cancelled (or already finished) before this thread got to run
+            int expected = kStateWoken;
+            if (! __atomic_compare_exchange_n(&fState, &expected, kStateRunning, false,
+                                              __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                continue;
+
+            kPool->work();
+
+            __atomic_store_n(&fState, kStateIdle, __ATOMIC_RELEASE);
+        }
+    }
+
+private:
+    enum {
+        kStateIdle,
+        kStateWoken,
+        kStateRunning
+    };
+
+    CarlaEngineThreadPool* const kPool;
+    carla_sem_t fSem;
+    const bool fSemValid;
+    int fState;
+
+    CARLA_DECLARE_NON_COPYABLE(Worker)
+};
+#endif
+
+// -----------------------------------------------------------------------
+
+CarlaEngineThreadPool::CarlaEngineThreadPool() noexcept
+    : fWorkers(nullptr),
+      fWorkerCount(0),
+      fBusy(),
+      fFunc(nullptr),
+      fPtr(nullptr),
+      fNumTasks(0),
+      fNextTask(0),
+      fDoneTasks(0)
+{
+}
+
+CarlaEngineThreadPool::~CarlaEngineThreadPool()
+{
+    stop();
+}
+
+void CarlaEngineThreadPool::start()
+{
+#ifndef CARLA_OS_WASM
+    if (fWorkers != nullptr)
+        return;
+
+    // the audio thread requesting the work runs tasks too
+    const uint32_t numCPUs = getNumCPUs();
+    const uint32_t workerCount = std::min(kMaxWorkerCount, numCPUs > 1 ? numCPUs - 1 : 0);
+
+    if (workerCount == 0)
+        return;
+
+    Worker** const workers = new Worker*[workerCount];
+    uint32_t count = 0;
+
+    for (uint32_t i=0; i < workerCount; ++i)
+    {
+        Worker* const worker = new Worker(this);
+
+        if (! worker->isValid() || ! worker->startThread(true))
+        {
+            delete worker;
+            break;
+        }
+
+        workers[count++] = worker;
+    }
+
+    if (count == 0)
+    {
+        delete[] workers;
+        return;
+    }
+
+    carla_debug("CarlaEngineThreadPool started with %u worker threads", count);
+
+    fWorkers = workers;
+    fWorkerCount = count;
+#endif
+}
+
+void CarlaEngineThreadPool::stop()
+{
+#ifndef CARLA_OS_WASM
+    if (fWorkers == nullptr)
+        return;
+
+    const CarlaMutexLocker cml(fBusy);
+
+    for (uint32_t i=0; i < fWorkerCount; ++i)
+        fWorkers[i]->signalThreadShouldExit();
+
+    for (uint32_t i=0; i < fWorkerCount; ++i)
+        delete fWorkers[i];
+
+    delete[] fWorkers;
+    fWorkers = nullptr;
+    fWorkerCount = 0;
+#endif
+}
+
+bool CarlaEngineThreadPool::run(const ParallelTaskFunc func, void* const ptr, const uint32_t numTasks) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(func != nullptr, false);
+
+#ifndef CARLA_OS_WASM
+    if (numTasks == 0)
+        return true;
+
+    // busy with another request, or stopping
+    if (! fBusy.tryLock())
+        return false;
+
+    if (fWorkerCount == 0)
+    {
+        fBusy.unlock();
+        return false;
+    }
+
+    fFunc = func;
+    fPtr = ptr;
+    fNumTasks = numTasks;
+    __atomic_store_n(&fDoneTasks, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&fNextTask, 0, __ATOMIC_RELEASE);
+
+    const uint32_t numWorkers = std::min(fWorkerCount, numTasks - 1);
+
+    for (uint32_t i=0; i < numWorkers; ++i)
+        fWorkers[i]->wake();
+
+    // run tasks in this thread too, taking over the ones that workers did not pick up in time
+    work();
+
+    // workers that have not started yet will find nothing left to do, so do not wait for them
+    for (uint32_t i=0; i < numWorkers; ++i)
+        fWorkers[i]->cancel();
+
+    uint32_t spinCount = 0;
+
+    // wait for the tasks taken by running workers
+    while (__atomic_load_n(&fDoneTasks, __ATOMIC_ACQUIRE) != numTasks)
+        waitPause(spinCount);
+
+    // and for those workers to leave work(), so none of them runs into the next request
+    for (uint32_t i=0; i < numWorkers; ++i)
+        while (fWorkers[i]->isRunning())
+            waitPause(spinCount);
+
+    fBusy.unlock();
+    return true;
+#else
+    return false;
+
+    // unused
+    (void)ptr;
+    (void)numTasks;
+#endif
+}
+
+bool CarlaEngineThreadPool::isWorkerThread() const noexcept
+{
+#ifndef CARLA_OS_WASM
+    const pthread_t self = pthread_self();
+
+    for (uint32_t i=0; i < fWorkerCount; ++i)
+    {
+        if (pthread_equal(self, fWorkers[i]->getThreadId()))
+            return true;
+    }
+#endif
+
+    return false;
+}
+
+// -----------------------------------------------------------------------
+
+void CarlaEngineThreadPool::work() noexcept
+{
+    const uint32_t numTasks = fNumTasks;
+
+    for (;;)
+    {
+        const uint32_t task = __atomic_fetch_add(&fNextTask, 1, __ATOMIC_ACQ_REL);
+
+        if (task >= numTasks)
+            break;
+
+        try {
+            fFunc(fPtr, task);
+        } CARLA_SAFE_EXCEPTION("CarlaEngineThreadPool task");
+
+        __atomic_add_fetch(&fDoneTasks, 1, __ATOMIC_RELEASE);
+    }
+}
+
+uint32_t CarlaEngineThreadPool::getNumCPUs() noexcept
+{
+#ifdef CARLA_OS_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<uint32_t>(info.dwNumberOfProcessors);
+#else
+    const long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+    return numCPUs > 0 ? static_cast<uint32_t>(numCPUs) : 1;
+#endif
+}
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
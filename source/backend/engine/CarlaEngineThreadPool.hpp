@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_ENGINE_THREAD_POOL_HPP_INCLUDED
+#define CARLA_ENGINE_THREAD_POOL_HPP_INCLUDED
+
+#include "CarlaEngine.hpp"
+#include "CarlaMutex.hpp"
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// CarlaEngineThreadPool
+//
+// Engine-wide pool of realtime worker threads, for plugins that can split their processing into parallel tasks.
+// The audio thread requesting the work runs tasks too, while the woken workers pick up the remaining ones;
+// workers that do not wake up before the audio thread runs out of tasks are not waited for.
+// Only one audio thread can use the pool at a time, requests made while it is busy are rejected.
+
+class CarlaEngineThreadPool
+{
+public:
+    CarlaEngineThreadPool() noexcept;
+    ~CarlaEngineThreadPool();
+
+    // start the worker threads if not running yet, must be called from the main thread
+    void start();
+
+    // stop all worker threads, must not be called while plugins are processing
+    void stop();
+
+    // run tasks in parallel and wait for them to finish, must be called from the audio thread
+    bool run(ParallelTaskFunc func, void* ptr, uint32_t numTasks) noexcept;
+
+    // check if the calling thread is one of the workers
+    bool isWorkerThread() const noexcept;
+
+private:
+    class Worker;
+
+    Worker** fWorkers;
+    uint32_t fWorkerCount;
+
+    CarlaMutex fBusy;
+    ParallelTaskFunc fFunc;
+    void* fPtr;
+    uint32_t fNumTasks;
+    uint32_t fNextTask;
+    uint32_t fDoneTasks;
+
+    // run tasks until there are no more left
+    void work() noexcept;
+
+    static uint32_t getNumCPUs() noexcept;
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaEngineThreadPool)
+};
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_ENGINE_THREAD_POOL_HPP_INCLUDED
@@ -127,6 +127,11 @@ bool CarlaPlugin::isEnabled() const noexcept
     return pData->enabled;
 }
 
+uint32_t CarlaPlugin::getStateRevision() const noexcept
+{
+    return __atomic_load_n(&pData->stateRevision, __ATOMIC_RELAXED);
+}
+
 const char* CarlaPlugin::getName() const noexcept
 {
     return pData->name;
@@ -286,6 +291,145 @@ float CarlaPlugin::getParameterValue(const uint32_t parameterId) const noexcept
     return 0.0f;
 }
 
+uint32_t CarlaPlugin::getParameterValueChanges(uint64_t& sequence,
+                                               uint32_t* const indexes,
+                                               float* const values,
+                                               const uint32_t maxCount) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(indexes != nullptr, 0);
+    CARLA_SAFE_ASSERT_RETURN(values != nullptr, 0);
+
+    // shared by all plugins, so sequence numbers from a removed plugin never match a new one
+    static uint64_t sSequence = 0;
+
+    ProtectedData::ParameterChanges& changes(pData->paramChanges);
+    const uint32_t count = pData->param.count;
+
+    if (changes.count != count)
+    {
+        // parameter list changed, everything is new
+        changes.clear();
+
+        if (count == 0)
+        {
+            sequence = changes.lastSequence;
+            return 0;
+        }
+
+        try {
+            changes.values = new float[count];
+            changes.sequences = new uint64_t[count];
+        } CARLA_SAFE_EXCEPTION_RETURN("CarlaPlugin::getParameterValueChanges", 0);
+
+        changes.count = count;
+        changes.lastSequence = __atomic_add_fetch(&sSequence, 1, __ATOMIC_RELAXED);
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            changes.values[i] = getParameterValue(i);
+            changes.sequences[i] = changes.lastSequence;
+        }
+    }
+    else
+    {
+        uint64_t newSequence = 0;
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            const float value = getParameterValue(i);
+
+            if (carla_isEqual(changes.values[i], value))
+                continue;
+
+            if (newSequence == 0)
+                newSequence = changes.lastSequence = __atomic_add_fetch(&sSequence, 1, __ATOMIC_RELAXED);
+
+            changes.values[i] = value;
+            changes.sequences[i] = newSequence;
+        }
+    }
+
+    uint32_t written = 0;
+    bool truncated = false;
+
+    for (uint32_t i=0; i < count; ++i)
+    {
+        if (changes.sequences[i] <= sequence)
+            continue;
+
+        if (written == maxCount)
+        {
+            truncated = true;
+            break;
+        }
+
+        indexes[written] = i;
+        values[written] = changes.values[i];
+        ++written;
+    }
+
+    if (! truncated)
+    {
+        sequence = changes.lastSequence;
+        return written;
+    }
+
+    if (maxCount == 0)
+        return 0;
+
+    // not everything fits, report whole batches of changes, oldest first,
+    // and return the sequence of the last one so the others come on the next call
+    written = 0;
+
+    for (;;)
+    {
+        uint64_t nextSequence = 0;
+        uint32_t nextCount = 0;
+
+        for (uint32_t i=0; i < count; ++i)
+        {
+            const uint64_t seq = changes.sequences[i];
+
+            if (seq <= sequence)
+                continue;
+
+            if (nextCount == 0 || seq < nextSequence)
+            {
+                nextSequence = seq;
+                nextCount = 1;
+            }
+            else if (seq == nextSequence)
+            {
+                ++nextCount;
+            }
+        }
+
+        if (nextCount == 0)
+            break;
+
+        // a single batch bigger than the arrays, the rest of it is lost
+        if (written + nextCount > maxCount && written != 0)
+            break;
+
+        for (uint32_t i=0; i < count && written < maxCount; ++i)
+        {
+            if (changes.sequences[i] != nextSequence)
+                continue;
+
+            indexes[written] = i;
+            values[written] = changes.values[i];
+            ++written;
+        }
+
+        sequence = nextSequence;
+
+        if (written == maxCount)
+            break;
+    }
+
+    return written;
+}
+
 float CarlaPlugin::getParameterScalePointValue(const uint32_t parameterId, const uint32_t scalePointId) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(parameterId < getParameterCount(), 0.0f);
@@ -558,7 +702,10 @@ const CarlaStateSave& CarlaPlugin::getStateSave(const bool callPrepareForSave)
 
         if (data != nullptr && dataSize > 0)
         {
-            pData->stateSave.chunk = carla_strdup(String::asBase64(data, dataSize));
+            // keep the chunk as-is, it is only encoded if saved as XML
+            pData->stateSave.chunkData = new uint8_t[dataSize];
+            pData->stateSave.chunkDataSize = dataSize;
+            std::memcpy(pData->stateSave.chunkData, data, dataSize);
 
             if (pluginType != PLUGIN_INTERNAL && pluginType != PLUGIN_JSFX)
                 usingChunk = true;
@@ -923,7 +1070,11 @@ void CarlaPlugin::loadStateSave(const CarlaStateSave& stateSave)
     // ---------------------------------------------------------------
     // Part 6 - set chunk
 
-    if (stateSave.chunk != nullptr && (pData->options & PLUGIN_OPTION_USE_CHUNKS) != 0)
+    if (stateSave.chunkData != nullptr && (pData->options & PLUGIN_OPTION_USE_CHUNKS) != 0)
+    {
+        setChunkData(stateSave.chunkData, stateSave.chunkDataSize);
+    }
+    else if (stateSave.chunk != nullptr && (pData->options & PLUGIN_OPTION_USE_CHUNKS) != 0)
     {
         std::vector<uint8_t> chunk;
         d_getChunkFromBase64String_impl(chunk, stateSave.chunk);
@@ -1348,6 +1499,7 @@ void CarlaPlugin::setName(const char* const newName)
         delete[] pData->name;
 
     pData->name = carla_strdup(newName);
+    pData->stateChanged();
 }
 
 void CarlaPlugin::setOption(const uint option, const bool yesNo, const bool sendCallback)
@@ -1359,6 +1511,8 @@ void CarlaPlugin::setOption(const uint option, const bool yesNo, const bool send
     else
         pData->options &= ~option;
 
+    pData->stateChanged();
+
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (sendCallback)
         pData->engine->callback(true, true,
@@ -1410,6 +1564,7 @@ void CarlaPlugin::setActive(const bool active, const bool sendOsc, const bool se
     }
 
     pData->active = active;
+    pData->stateChanged();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     const float value = active ? 1.0f : 0.0f;
@@ -1440,6 +1595,7 @@ void CarlaPlugin::setDryWet(const float value, const bool sendOsc, const bool se
         return;
 
     pData->postProc.dryWet = fixedValue;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED,
@@ -1465,6 +1621,7 @@ void CarlaPlugin::setVolume(const float value, const bool sendOsc, const bool se
         return;
 
     pData->postProc.volume = fixedValue;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED,
@@ -1490,6 +1647,7 @@ void CarlaPlugin::setBalanceLeft(const float value, const bool sendOsc, const bo
         return;
 
     pData->postProc.balanceLeft = fixedValue;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED,
@@ -1515,6 +1673,7 @@ void CarlaPlugin::setBalanceRight(const float value, const bool sendOsc, const b
         return;
 
     pData->postProc.balanceRight = fixedValue;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED,
@@ -1540,6 +1699,7 @@ void CarlaPlugin::setPanning(const float value, const bool sendOsc, const bool s
         return;
 
     pData->postProc.panning = fixedValue;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED,
@@ -1560,6 +1720,7 @@ void CarlaPlugin::setDryWetRT(const float value, const bool sendCallbackLater) n
         return;
 
     pData->postProc.dryWet = fixedValue;
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, PARAMETER_DRYWET, fixedValue);
 }
 
@@ -1573,6 +1734,7 @@ void CarlaPlugin::setVolumeRT(const float value, const bool sendCallbackLater) n
         return;
 
     pData->postProc.volume = fixedValue;
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, PARAMETER_VOLUME, fixedValue);
 }
 
@@ -1586,6 +1748,7 @@ void CarlaPlugin::setBalanceLeftRT(const float value, const bool sendCallbackLat
         return;
 
     pData->postProc.balanceLeft = fixedValue;
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, PARAMETER_BALANCE_LEFT, fixedValue);
 }
 
@@ -1599,6 +1762,7 @@ void CarlaPlugin::setBalanceRightRT(const float value, const bool sendCallbackLa
         return;
 
     pData->postProc.balanceRight = fixedValue;
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, PARAMETER_BALANCE_RIGHT, fixedValue);
 }
 
@@ -1612,6 +1776,7 @@ void CarlaPlugin::setPanningRT(const float value, const bool sendCallbackLater)
         return;
 
     pData->postProc.panning = fixedValue;
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, PARAMETER_PANNING, fixedValue);
 }
 #endif // ! BUILD_BRIDGE_ALTERNATIVE_ARCH
@@ -1629,6 +1794,7 @@ void CarlaPlugin::setCtrlChannel(const int8_t channel, const bool sendOsc, const
         return;
 
     pData->ctrlChannel = channel;
+    pData->stateChanged();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     const float channelf = static_cast<float>(channel);
@@ -1657,6 +1823,8 @@ void CarlaPlugin::setParameterValue(const uint32_t parameterId, const float valu
     }
     CARLA_SAFE_ASSERT_RETURN(parameterId < pData->param.count,);
 
+    pData->stateChanged();
+
     if (sendGui && (pData->hints & PLUGIN_HAS_CUSTOM_UI) != 0)
         uiParameterChange(parameterId, value);
 
@@ -1671,6 +1839,7 @@ void CarlaPlugin::setParameterValue(const uint32_t parameterId, const float valu
 
 void CarlaPlugin::setParameterValueRT(const uint32_t parameterId, const float value, uint32_t, const bool sendCallbackLater) noexcept
 {
+    pData->stateChanged();
     pData->postponeParameterChangeRtEvent(sendCallbackLater, static_cast<int32_t>(parameterId), value);
 }
 
@@ -1724,6 +1893,7 @@ void CarlaPlugin::setParameterMidiChannel(const uint32_t parameterId, const uint
         return;
 
     pData->param.data[parameterId].midiChannel = channel;
+    pData->stateChanged();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     pData->engine->callback(sendCallback, sendOsc,
@@ -1817,6 +1987,7 @@ void CarlaPlugin::setParameterMappedControlIndex(const uint32_t parameterId, con
 #endif
 
     paramData.mappedControlIndex = index;
+    pData->stateChanged();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (index == CONTROL_INDEX_MIDI_LEARN)
@@ -1864,6 +2035,7 @@ void CarlaPlugin::setParameterMappedRange(const uint32_t parameterId, const floa
     paramData.hints |= PARAMETER_MAPPED_RANGES_SET;
     paramData.mappedMinimum = minimum;
     paramData.mappedMaximum = maximum;
+    pData->stateChanged();
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     if (pData->event.cvSourcePorts != nullptr && paramData.mappedControlIndex == CONTROL_INDEX_CV)
@@ -1908,9 +2080,15 @@ void CarlaPlugin::setCustomData(const char* const type, const char* const key, c
         if (std::strcmp(customData.key, key) == 0)
         {
             if (customData.value != nullptr)
+            {
+                if (std::strcmp(customData.value, value) == 0)
+                    return;
+
                 delete[] customData.value;
+            }
 
             customData.value = carla_strdup(value);
+            pData->stateChanged();
             return;
         }
     }
@@ -1921,6 +2099,7 @@ void CarlaPlugin::setCustomData(const char* const type, const char* const key, c
     customData.key   = carla_strdup(key);
     customData.value = carla_strdup(value);
     pData->custom.append(customData);
+    pData->stateChanged();
 }
 
 void CarlaPlugin::setChunkData(const void* const data, const std::size_t dataSize)
@@ -1936,6 +2115,7 @@ void CarlaPlugin::setProgram(const int32_t index,
     CARLA_SAFE_ASSERT_RETURN(index >= -1 && index < static_cast<int32_t>(pData->prog.count),);
 
     pData->prog.current = index;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_PROGRAM_CHANGED,
@@ -1968,6 +2148,7 @@ void CarlaPlugin::setMidiProgram(const int32_t index,
     CARLA_SAFE_ASSERT_RETURN(index >= -1 && index < static_cast<int32_t>(pData->midiprog.count),);
 
     pData->midiprog.current = index;
+    pData->stateChanged();
 
     pData->engine->callback(sendCallback, sendOsc,
                             ENGINE_CALLBACK_MIDI_PROGRAM_CHANGED,
@@ -2009,6 +2190,7 @@ void CarlaPlugin::setProgramRT(const uint32_t uindex, const bool sendCallbackLat
 
     const int32_t index = static_cast<int32_t>(uindex);
     pData->prog.current = index;
+    pData->stateChanged();
 
     // Change default parameter values
     switch (getType())
@@ -2031,6 +2213,7 @@ void CarlaPlugin::setMidiProgramRT(const uint32_t uindex, const bool sendCallbac
 
     const int32_t index = static_cast<int32_t>(uindex);
     pData->midiprog.current = index;
+    pData->stateChanged();
 
     // Change default parameter values
     switch (getType())
@@ -2067,6 +2250,19 @@ void CarlaPlugin::deactivate() noexcept
     CARLA_SAFE_ASSERT(pData->active);
 }
 
+bool CarlaPlugin::canProcessDouble() const noexcept
+{
+    return false;
+}
+
+void CarlaPlugin::processDouble(const double* const* const, double** const audioOut, const uint32_t frames)
+{
+    carla_safe_assert("canProcessDouble()", __FILE__, __LINE__);
+
+    for (uint32_t i=0; i < pData->audioOut.count; ++i)
+        carla_zeroDoubles(audioOut[i], frames);
+}
+
 void CarlaPlugin::bufferSizeChanged(const uint32_t newBufferSize)
 {
    #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
@@ -144,6 +144,11 @@ struct carla_clap_host : clap_host_t {
         virtual void clapRequestCallback() = 0;
         virtual void clapMarkDirty() = 0;
         virtual void clapLatencyChanged() = 0;
+        // thread check
+        virtual bool clapIsMainThread() const = 0;
+        virtual bool clapIsAudioThread() const = 0;
+        // thread pool
+        virtual bool clapThreadPoolRequestExec(uint32_t numTasks) = 0;
       #ifdef CLAP_WINDOW_API_NATIVE
         // gui
         virtual void clapGuiResizeHintsChanged() = 0;
@@ -167,6 +172,8 @@ struct carla_clap_host : clap_host_t {
 
     clap_host_latency_t latency;
     clap_host_state_t state;
+    clap_host_thread_check_t threadCheck;
+    clap_host_thread_pool_t threadPool;
   #ifdef CLAP_WINDOW_API_NATIVE
     clap_host_gui_t gui;
    #ifdef _POSIX_VERSION
@@ -194,6 +201,11 @@ struct carla_clap_host : clap_host_t {
 
         state.mark_dirty = carla_mark_dirty;
 
+        threadCheck.is_main_thread = carla_is_main_thread;
+        threadCheck.is_audio_thread = carla_is_audio_thread;
+
+        threadPool.request_exec = carla_request_exec;
+
       #ifdef CLAP_WINDOW_API_NATIVE
         gui.resize_hints_changed = carla_resize_hints_changed;
         gui.request_resize = carla_request_resize;
@@ -220,6 +232,10 @@ struct carla_clap_host : clap_host_t {
             return &self->latency;
         if (std::strcmp(extension_id, CLAP_EXT_STATE) == 0)
             return &self->state;
+        if (std::strcmp(extension_id, CLAP_EXT_THREAD_CHECK) == 0)
+            return &self->threadCheck;
+        if (std::strcmp(extension_id, CLAP_EXT_THREAD_POOL) == 0)
+            return &self->threadPool;
       #ifdef CLAP_WINDOW_API_NATIVE
         if (std::strcmp(extension_id, CLAP_EXT_GUI) == 0)
             return &self->gui;
@@ -260,6 +276,21 @@ struct carla_clap_host : clap_host_t {
         static_cast<const carla_clap_host*>(host->host_data)->hostCallbacks->clapMarkDirty();
     }
 
+    static bool CLAP_ABI carla_is_main_thread(const clap_host_t* const host)
+    {
+        return static_cast<const carla_clap_host*>(host->host_data)->hostCallbacks->clapIsMainThread();
+    }
+
+    static bool CLAP_ABI carla_is_audio_thread(const clap_host_t* const host)
+    {
+        return static_cast<const carla_clap_host*>(host->host_data)->hostCallbacks->clapIsAudioThread();
+    }
+
+    static bool CLAP_ABI carla_request_exec(const clap_host_t* const host, const uint32_t num_tasks)
+    {
+        return static_cast<const carla_clap_host*>(host->host_data)->hostCallbacks->clapThreadPoolRequestExec(num_tasks);
+    }
+
   #ifdef CLAP_WINDOW_API_NATIVE
     static void CLAP_ABI carla_resize_hints_changed(const clap_host_t* const host)
     {
@@ -706,11 +737,19 @@ public:
           fInputEvents(),
           fOutputEvents(),
          #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+          fUse64BitSamples(false),
           fAudioOutBuffers(nullptr),
+          fAudioOutBuffers64(nullptr),
+          fExtraBuffer64(nullptr),
          #endif
           fLastChunk(nullptr),
           fLastKnownLatency(0),
           kEngineHasIdleOnMainThread(engine->hasIdleOnMainThread()),
+          kMainThread(pthread_self()),
+          fAudioThread(),
+          fAudioThreadValid(false),
+          fMainThreadIsProcessing(false),
+          fIsProcessing(false),
           fNeedsParamFlush(false),
           fNeedsRestart(false),
           fNeedsProcess(false),
@@ -1381,6 +1420,9 @@ public:
         const clap_plugin_timer_support_t* timerExt = static_cast<const clap_plugin_timer_support_t*>(
             fPlugin->get_extension(fPlugin, CLAP_EXT_TIMER_SUPPORT));
 
+        const clap_plugin_thread_pool_t* threadPoolExt = static_cast<const clap_plugin_thread_pool_t*>(
+            fPlugin->get_extension(fPlugin, CLAP_EXT_THREAD_POOL));
+
         if (audioPortsExt != nullptr && (audioPortsExt->count == nullptr || audioPortsExt->get == nullptr))
             audioPortsExt = nullptr;
 
@@ -1399,10 +1441,17 @@ public:
         if (timerExt != nullptr && timerExt->on_timer == nullptr)
             timerExt = nullptr;
 
+        if (threadPoolExt != nullptr && threadPoolExt->exec == nullptr)
+            threadPoolExt = nullptr;
+
         fExtensions.latency = latencyExt;
         fExtensions.params = paramsExt;
         fExtensions.state = stateExt;
         fExtensions.timer = timerExt;
+        fExtensions.threadPool = threadPoolExt;
+
+        if (threadPoolExt != nullptr)
+            pData->engine->startThreadPool();
 
        #ifdef CLAP_WINDOW_API_NATIVE
         const clap_plugin_gui_t* guiExt = static_cast<const clap_plugin_gui_t*>(
@@ -1452,6 +1501,9 @@ public:
         fInputAudioBuffers.realloc(numAudioInputPorts);
         fOutputAudioBuffers.realloc(numAudioOutputPorts);
 
+        // 64-bit audio can only be used if all ports support it
+        bool supports64BitSamples = numAudioInputPorts + numAudioOutputPorts != 0;
+
         for (uint32_t i=0; i<numAudioInputPorts; ++i)
         {
             clap_audio_port_info_t portInfo = {};
@@ -1462,6 +1514,9 @@ public:
             fInputAudioBuffers.extra[i].offset = aIns;
             fInputAudioBuffers.extra[i].isMain = portInfo.flags & CLAP_AUDIO_PORT_IS_MAIN;
 
+            if ((portInfo.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS) == 0x0)
+                supports64BitSamples = false;
+
             aIns += portInfo.channel_count;
         }
 
@@ -1477,6 +1532,9 @@ public:
             for (uint32_t j=0; j<portInfo.channel_count; ++j)
                 fOutputAudioBuffers.buffers[i].constant_mask |= (1ULL << j);
 
+            if ((portInfo.flags & CLAP_AUDIO_PORT_SUPPORTS_64BITS) == 0x0)
+                supports64BitSamples = false;
+
             aOuts += portInfo.channel_count;
         }
 
@@ -1509,6 +1567,10 @@ public:
             pData->audioIn.createNew(aIns);
         }
 
+       #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+        fUse64BitSamples = supports64BitSamples && pData->engine->usesDoublePrecision();
+       #endif
+
         if (aOuts > 0)
         {
             pData->audioOut.createNew(aOuts);
@@ -1518,6 +1580,13 @@ public:
             fAudioOutBuffers = new float*[aOuts];
             for (uint32_t i=0; i < aOuts; ++i)
                 fAudioOutBuffers[i] = nullptr;
+
+            if (fUse64BitSamples)
+            {
+                fAudioOutBuffers64 = new double*[aOuts];
+                for (uint32_t i=0; i < aOuts; ++i)
+                    fAudioOutBuffers64[i] = nullptr;
+            }
            #endif
         }
 
@@ -1872,7 +1941,11 @@ public:
 
         // FIXME check return status
         fPlugin->activate(fPlugin, pData->engine->getSampleRate(), 1, pData->engine->getBufferSize());
+
+        // start/stop_processing belong to the audio thread, which is not running for us at this point
+        __atomic_store_n(&fMainThreadIsProcessing, true, __ATOMIC_RELEASE);
         fPlugin->start_processing(fPlugin);
+        __atomic_store_n(&fMainThreadIsProcessing, false, __ATOMIC_RELEASE);
 
         fNeedsParamFlush = false;
         runIdleCallbacksAsNeeded(false);
@@ -1883,9 +1956,15 @@ public:
         CARLA_SAFE_ASSERT_RETURN(fPlugin != nullptr,);
 
         // FIXME check return status
+        __atomic_store_n(&fMainThreadIsProcessing, true, __ATOMIC_RELEASE);
         fPlugin->stop_processing(fPlugin);
+        __atomic_store_n(&fMainThreadIsProcessing, false, __ATOMIC_RELEASE);
+
         fPlugin->deactivate(fPlugin);
 
+        // the engine audio thread might be a different one on the next activation
+        __atomic_store_n(&fAudioThreadValid, false, __ATOMIC_RELEASE);
+
         runIdleCallbacksAsNeeded(false);
     }
 
@@ -1895,6 +1974,36 @@ public:
                  float** const,
                  const uint32_t frames) override
     {
+        processWithSampleType(audioIn, audioOut, cvIn, frames);
+    }
+
+   #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    bool canProcessDouble() const noexcept override
+    {
+        return fUse64BitSamples;
+    }
+
+    void processDouble(const double* const* const audioIn, double** const audioOut, const uint32_t frames) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(fUse64BitSamples,);
+
+        processWithSampleType(audioIn, audioOut, nullptr, frames);
+    }
+   #endif
+
+    template <typename SampleType>
+    void processWithSampleType(const SampleType* const* const audioIn,
+                               SampleType** const audioOut,
+                               const float* const* const cvIn,
+                               const uint32_t frames)
+    {
+        // remember the audio thread for the whole activation, not just while inside the plugin process call
+        if (! __atomic_load_n(&fAudioThreadValid, __ATOMIC_ACQUIRE))
+        {
+            fAudioThread = pthread_self();
+            __atomic_store_n(&fAudioThreadValid, true, __ATOMIC_RELEASE);
+        }
+
         // --------------------------------------------------------------------------------------------------------
         // Check if active
 
@@ -1902,7 +2011,7 @@ public:
         {
             // disable any output sound
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
-                carla_zeroFloats(audioOut[i], frames);
+                carla_zeroStructs(audioOut[i], frames);
             return;
         }
 
@@ -1915,11 +2024,15 @@ public:
         {
             CARLA_SAFE_ASSERT_RETURN(audioIn != nullptr,);
         }
+       #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+        SampleType** const audioOutBuffers = getAudioOutBuffers(static_cast<SampleType*>(nullptr));
+       #endif
+
         if (pData->audioOut.count > 0)
         {
             CARLA_SAFE_ASSERT_RETURN(audioOut != nullptr,);
            #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
-            CARLA_SAFE_ASSERT_RETURN(fAudioOutBuffers != nullptr,);
+            CARLA_SAFE_ASSERT_RETURN(audioOutBuffers != nullptr,);
            #endif
         }
 
@@ -1928,7 +2041,7 @@ public:
 
        #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            carla_zeroFloats(fAudioOutBuffers[i], frames);
+            carla_zeroStructs(audioOutBuffers[i], frames);
        #endif
 
         // --------------------------------------------------------------------------------------------------------
@@ -1941,7 +2054,7 @@ public:
         else if (! pData->singleMutex.tryLock())
         {
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
-                carla_zeroFloats(audioOut[i], frames);
+                carla_zeroStructs(audioOut[i], frames);
             return;
         }
 
@@ -2429,14 +2542,14 @@ public:
         // Plugin processing
 
         for (uint32_t i=0; i<fInputAudioBuffers.count; ++i)
-            fInputAudioBuffers.buffers[i].data32 = audioIn + fInputAudioBuffers.extra[i].offset;
+            setAudioBufferData(fInputAudioBuffers.buffers[i], audioIn + fInputAudioBuffers.extra[i].offset);
 
         for (uint32_t i=0; i<fOutputAudioBuffers.count; ++i)
         {
            #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
-            fOutputAudioBuffers.buffers[i].data32 = fAudioOutBuffers + fOutputAudioBuffers.extra[i].offset;
+            setAudioBufferData(fOutputAudioBuffers.buffers[i], audioOutBuffers + fOutputAudioBuffers.extra[i].offset);
            #else
-            fOutputAudioBuffers.buffers[i].data32 = audioOut + fOutputAudioBuffers.extra[i].offset;
+            setAudioBufferData(fOutputAudioBuffers.buffers[i], audioOut + fOutputAudioBuffers.extra[i].offset);
            #endif
         }
 
@@ -2452,8 +2565,12 @@ public:
             fOutputEvents.cast()
         };
 
+        fIsProcessing = true;
+
         fPlugin->process(fPlugin, &process);
 
+        fIsProcessing = false;
+
        #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
         // --------------------------------------------------------------------------------------------------------
         // Post-processing (dry/wet, volume and balance)
@@ -2464,8 +2581,8 @@ public:
             const bool isMono    = (pData->audioIn.count == 1);
 
             bool isPair;
-            float bufValue;
-            float* const oldBufLeft = pData->postProc.extraBuffer;
+            SampleType bufValue;
+            SampleType* const oldBufLeft = getPostProcExtraBuffer(static_cast<SampleType*>(nullptr));
 
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
             {
@@ -2477,7 +2594,7 @@ public:
                     for (uint32_t k=0; k < frames; ++k)
                     {
                         bufValue = audioIn[c][k];
-                        fAudioOutBuffers[i][k] = (fAudioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
+                        audioOutBuffers[i][k] = (audioOutBuffers[i][k] * pData->postProc.dryWet) + (bufValue * (1.0f - pData->postProc.dryWet));
                     }
                 }
 
@@ -2489,7 +2606,7 @@ public:
                     if (isPair)
                     {
                         CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        carla_copyFloats(oldBufLeft, fAudioOutBuffers[i], frames);
+                        carla_copyStructs(oldBufLeft, audioOutBuffers[i], frames);
                     }
 
                     float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
@@ -2500,14 +2617,14 @@ public:
                         if (isPair)
                         {
                             // left
-                            fAudioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
-                            fAudioOutBuffers[i][k] += fAudioOutBuffers[i+1][k] * (1.0f - balRangeR);
+                            audioOutBuffers[i][k]  = oldBufLeft[k]           * (1.0f - balRangeL);
+                            audioOutBuffers[i][k] += audioOutBuffers[i+1][k] * (1.0f - balRangeR);
                         }
                         else
                         {
                             // right
-                            fAudioOutBuffers[i][k]  = fAudioOutBuffers[i][k] * balRangeR;
-                            fAudioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
+                            audioOutBuffers[i][k]  = audioOutBuffers[i][k] * balRangeR;
+                            audioOutBuffers[i][k] += oldBufLeft[k]         * balRangeL;
                         }
                     }
                 }
@@ -2515,7 +2632,7 @@ public:
                 // Volume (and buffer copy)
                 {
                     for (uint32_t k=0; k < frames; ++k)
-                        audioOut[i][k] = fAudioOutBuffers[i][k] * pData->postProc.volume;
+                        audioOut[i][k] = audioOutBuffers[i][k] * pData->postProc.volume;
                 }
             }
 
@@ -2598,7 +2715,52 @@ public:
 #endif
     }
 
+    // helpers for processWithSampleType(), the pointer type selects which data member is used
+    static void setAudioBufferData(clap_audio_buffer_const_t& buffer, const float* const* const data) noexcept
+    {
+        buffer.data32 = data;
+        buffer.data64 = nullptr;
+    }
+
+    static void setAudioBufferData(clap_audio_buffer_const_t& buffer, const double* const* const data) noexcept
+    {
+        buffer.data32 = nullptr;
+        buffer.data64 = data;
+    }
+
+    static void setAudioBufferData(clap_audio_buffer_t& buffer, float** const data) noexcept
+    {
+        buffer.data32 = data;
+        buffer.data64 = nullptr;
+    }
+
+    static void setAudioBufferData(clap_audio_buffer_t& buffer, double** const data) noexcept
+    {
+        buffer.data32 = nullptr;
+        buffer.data64 = data;
+    }
+
    #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    float** getAudioOutBuffers(float*) const noexcept
+    {
+        return fAudioOutBuffers;
+    }
+
+    double** getAudioOutBuffers(double*) const noexcept
+    {
+        return fAudioOutBuffers64;
+    }
+
+    float* getPostProcExtraBuffer(float*) const noexcept
+    {
+        return pData->postProc.extraBuffer;
+    }
+
+    double* getPostProcExtraBuffer(double*) const noexcept
+    {
+        return fExtraBuffer64;
+    }
+
     void bufferSizeChanged(const uint32_t newBufferSize) override
     {
         CARLA_ASSERT_INT(newBufferSize > 0, newBufferSize);
@@ -2614,6 +2776,19 @@ public:
             fAudioOutBuffers[i] = new float[newBufferSize];
         }
 
+        if (fUse64BitSamples)
+        {
+            for (uint32_t i=0; i < pData->audioOut.count; ++i)
+            {
+                if (fAudioOutBuffers64[i] != nullptr)
+                    delete[] fAudioOutBuffers64[i];
+                fAudioOutBuffers64[i] = new double[newBufferSize];
+            }
+
+            delete[] fExtraBuffer64;
+            fExtraBuffer64 = new double[newBufferSize];
+        }
+
         if (pData->active)
             activate();
 
@@ -2651,6 +2826,29 @@ public:
             delete[] fAudioOutBuffers;
             fAudioOutBuffers = nullptr;
         }
+
+        if (fAudioOutBuffers64 != nullptr)
+        {
+            for (uint32_t i=0; i < pData->audioOut.count; ++i)
+            {
+                if (fAudioOutBuffers64[i] != nullptr)
+                {
+                    delete[] fAudioOutBuffers64[i];
+                    fAudioOutBuffers64[i] = nullptr;
+                }
+            }
+
+            delete[] fAudioOutBuffers64;
+            fAudioOutBuffers64 = nullptr;
+        }
+
+        if (fExtraBuffer64 != nullptr)
+        {
+            delete[] fExtraBuffer64;
+            fExtraBuffer64 = nullptr;
+        }
+
+        fUse64BitSamples = false;
        #endif
 
         fInputEvents.clear(pData->event.portIn);
@@ -2774,7 +2972,48 @@ protected:
 
     void clapMarkDirty() override
     {
-        carla_stdout("CarlaPluginCLAP::clapMarkDirty()");
+        carla_debug("CarlaPluginCLAP::clapMarkDirty()");
+
+        pData->stateChanged();
+    }
+
+    // -------------------------------------------------------------------
+
+    bool clapIsMainThread() const override
+    {
+        return pthread_equal(pthread_self(), kMainThread) != 0;
+    }
+
+    bool clapIsAudioThread() const override
+    {
+        const pthread_t self = pthread_self();
+
+        if (__atomic_load_n(&fAudioThreadValid, __ATOMIC_ACQUIRE) && pthread_equal(self, fAudioThread) != 0)
+            return true;
+
+        // start/stop_processing called from the main thread while the plugin is not being processed
+        if (__atomic_load_n(&fMainThreadIsProcessing, __ATOMIC_ACQUIRE) && pthread_equal(self, kMainThread) != 0)
+            return true;
+
+        return pData->engine->isThreadPoolWorker();
+    }
+
+    bool clapThreadPoolRequestExec(const uint32_t numTasks) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(fExtensions.threadPool != nullptr, false);
+
+        // only allowed from within the process call
+        if (! fIsProcessing || pthread_equal(pthread_self(), fAudioThread) == 0)
+            return false;
+
+        return pData->engine->runParallelTasks(_threadPoolExec, this, numTasks);
+    }
+
+    static void _threadPoolExec(void* const ptr, const uint32_t taskIndex)
+    {
+        CarlaPluginCLAP* const self = static_cast<CarlaPluginCLAP*>(ptr);
+
+        self->fExtensions.threadPool->exec(self->fPlugin, taskIndex);
     }
 
     // -------------------------------------------------------------------
@@ -3234,6 +3473,7 @@ private:
         const clap_plugin_params_t* params;
         const clap_plugin_state_t* state;
         const clap_plugin_timer_support_t* timer;
+        const clap_plugin_thread_pool_t* threadPool;
       #ifdef CLAP_WINDOW_API_NATIVE
         const clap_plugin_gui_t* gui;
        #ifdef _POSIX_VERSION
@@ -3245,7 +3485,8 @@ private:
             : latency(nullptr),
               params(nullptr),
               state(nullptr),
-              timer(nullptr)
+              timer(nullptr),
+              threadPool(nullptr)
           #ifdef CLAP_WINDOW_API_NATIVE
             , gui(nullptr)
            #ifdef _POSIX_VERSION
@@ -3303,11 +3544,19 @@ private:
     carla_clap_input_events fInputEvents;
     carla_clap_output_events fOutputEvents;
    #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    bool fUse64BitSamples;
     float** fAudioOutBuffers;
+    double** fAudioOutBuffers64;
+    double* fExtraBuffer64;
    #endif
     void* fLastChunk;
     uint32_t fLastKnownLatency;
     const bool kEngineHasIdleOnMainThread;
+    const pthread_t kMainThread;
+    pthread_t fAudioThread;
+    bool fAudioThreadValid;
+    bool fMainThreadIsProcessing;
+    volatile bool fIsProcessing;
     bool fNeedsParamFlush;
     bool fNeedsRestart;
     bool fNeedsProcess;
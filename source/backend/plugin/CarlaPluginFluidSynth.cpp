@@ -8,7 +8,9 @@
 
 #include "CarlaBackendUtils.hpp"
 #include "CarlaMathUtils.hpp"
+#include "CarlaThread.hpp"
 
+#include "water/files/File.h"
 #include "water/text/StringArray.h"
 
 #include <fluidsynth.h>
@@ -24,6 +26,56 @@ static const ExternalMidiNote kExternalMidiNoteFallback = { -1, 0, 0 };
 
 // -------------------------------------------------------------------------------------------------------------------
 
+// Loads a SoundFont into a plugin synth on a worker thread, so big files do not block the caller.
+// There is no sharing layer on top, FluidSynth 2 already keeps sample data in its own process-wide sample cache.
+// Instances loading the same file (using its resolved path, which is part of the cache key) share the sample
+// memory and only parse the SoundFont structure again.
+class FluidSoundFontLoader : public CarlaThread
+{
+public:
+    FluidSoundFontLoader(fluid_synth_t* const synth, const char* const filename)
+        : CarlaThread("FluidSoundFontLoader"),
+          kSynth(synth),
+          kFilename(water::File(filename).getLinkedTarget().getFullPathName()),
+          fSynthId(-1) {}
+
+    // returns the SoundFont id, or -1 on failure.
+    // the idle callback is called from the calling thread while waiting.
+    int load(void (*idleCallback)(void*), void* const idleCallbackPtr)
+    {
+        if (! startThread())
+            return fluid_synth_sfload(kSynth, kFilename.toRawUTF8(), 0);
+
+        while (isThreadRunning())
+        {
+            idleCallback(idleCallbackPtr);
+            d_msleep(10);
+        }
+
+        return __atomic_load_n(&fSynthId, __ATOMIC_ACQUIRE);
+    }
+
+protected:
+    void run() override
+    {
+        __atomic_store_n(&fSynthId, fluid_synth_sfload(kSynth, kFilename.toRawUTF8(), 0), __ATOMIC_RELEASE);
+    }
+
+private:
+    fluid_synth_t* const kSynth;
+    const water::String kFilename;
+    int fSynthId;
+
+    CARLA_DECLARE_NON_COPYABLE(FluidSoundFontLoader)
+};
+
+static void loadingIdleCallbackFunction(void* ptr)
+{
+    ((CarlaEngine*)ptr)->callback(true, false, ENGINE_CALLBACK_IDLE, 0, 0, 0, 0, 0.0f, nullptr);
+}
+
+// -------------------------------------------------------------------------------------------------------------------
+
 class CarlaPluginFluidSynth : public CarlaPlugin
 {
 public:
@@ -1684,7 +1736,9 @@ public:
         // ---------------------------------------------------------------
         // open soundfont
 
-        const int synthId = fluid_synth_sfload(fSynth, filename, 0);
+        // read on a worker thread, sample data already loaded by other instances comes from FluidSynth's cache
+        FluidSoundFontLoader loader(fSynth, filename);
+        const int synthId = loader.load(loadingIdleCallbackFunction, pData->engine);
 
         if (synthId < 0)
         {
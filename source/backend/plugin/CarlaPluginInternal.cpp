@@ -700,6 +700,37 @@ void CarlaPlugin::ProtectedData::PostUiEvents::clear() noexcept
     mutex.unlock();
 }
 
+// -----------------------------------------------------------------------
+// ProtectedData::ParameterChanges
+
+CarlaPlugin::ProtectedData::ParameterChanges::ParameterChanges() noexcept
+    : count(0),
+      lastSequence(0),
+      values(nullptr),
+      sequences(nullptr) {}
+
+CarlaPlugin::ProtectedData::ParameterChanges::~ParameterChanges() noexcept
+{
+    clear();
+}
+
+void CarlaPlugin::ProtectedData::ParameterChanges::clear() noexcept
+{
+    if (values != nullptr)
+    {
+        delete[] values;
+        values = nullptr;
+    }
+
+    if (sequences != nullptr)
+    {
+        delete[] sequences;
+        sequences = nullptr;
+    }
+
+    count = 0;
+}
+
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
 // -----------------------------------------------------------------------
 // ProtectedData::PostProc
@@ -731,6 +762,7 @@ CarlaPlugin::ProtectedData::ProtectedData(CarlaEngine* const eng, const uint idx
       uiLib(nullptr),
       ctrlChannel(0),
       extraHints(0x0),
+      stateRevision(0),
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
       midiLearnParameterIndex(-1),
       transientTryCounter(0),
@@ -755,7 +787,8 @@ CarlaPlugin::ProtectedData::ProtectedData(CarlaEngine* const eng, const uint idx
       extNotes(),
       latency(),
       postRtEvents(),
-      postUiEvents()
+      postUiEvents(),
+      paramChanges()
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     , postProc()
 #endif
@@ -1041,6 +1074,12 @@ void CarlaPlugin::ProtectedData::updateDefaultParameterValues(CarlaPlugin* const
         param.ranges[i].def = param.ranges[i].getFixedValue(plugin->getParameterValue(i));
 }
 
+void CarlaPlugin::ProtectedData::stateChanged() noexcept
+{
+    // can be called from any thread, including RT
+    __atomic_add_fetch(&stateRevision, 1, __ATOMIC_RELAXED);
+}
+
 // -----------------------------------------------------------------------
 
 CARLA_BACKEND_END_NAMESPACE
@@ -246,6 +246,9 @@ struct CarlaPlugin::ProtectedData {
     // misc
     int8_t ctrlChannel;
     uint   extraHints;
+
+    // incremented on every state change, used to detect modified plugins
+    volatile uint32_t stateRevision;
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     int32_t midiLearnParameterIndex;
     uint    transientTryCounter;
@@ -372,6 +375,21 @@ struct CarlaPlugin::ProtectedData {
 
     } postUiEvents;
 
+    // parameter values as seen by the last CarlaPlugin::getParameterValueChanges() call
+    struct ParameterChanges {
+        uint32_t count;
+        uint64_t lastSequence;
+        float* values;
+        uint64_t* sequences; // when each parameter last changed
+
+        ParameterChanges() noexcept;
+        ~ParameterChanges() noexcept;
+        void clear() noexcept;
+
+        CARLA_DECLARE_NON_COPYABLE(ParameterChanges)
+
+    } paramChanges;
+
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
     struct PostProc {
         float dryWet;
@@ -440,6 +458,7 @@ struct CarlaPlugin::ProtectedData {
     void updateParameterValues(CarlaPlugin* plugin,
                                bool sendCallback, bool sendOsc, bool useDefault) noexcept;
     void updateDefaultParameterValues(CarlaPlugin* plugin) noexcept;
+    void stateChanged() noexcept;
 
     // -------------------------------------------------------------------
 
@@ -290,6 +290,7 @@ public:
           fLatencyIndex(-1),
           fForcedStereoIn(false),
           fForcedStereoOut(false),
+          fForcedStereoShared(false),
           fNeedsFixedBuffers(false),
           fUsesCustomData(false)
        #ifdef CARLA_ENABLE_DSSI_PLUGIN_GUI
@@ -489,6 +490,10 @@ public:
         else if (pData->audioIn.count == 1 || pData->audioOut.count == 1 || fForcedStereoIn || fForcedStereoOut)
             options |= PLUGIN_OPTION_FORCE_STEREO;
 
+        // a single instance can only be shared between both channels of mono effects
+        if (canShareForcedStereoInstance(pData->audioIn.count, pData->audioOut.count) || fForcedStereoShared)
+            options |= PLUGIN_OPTION_FORCE_STEREO_SHARED;
+
         if (fDssiDescriptor != nullptr)
         {
             if (fDssiDescriptor->get_program != nullptr && fDssiDescriptor->select_program != nullptr)
@@ -902,8 +907,8 @@ public:
         uint32_t aIns, aOuts, mIns, params;
         aIns = aOuts = mIns = params = 0;
 
-        bool forcedStereoIn, forcedStereoOut;
-        forcedStereoIn = forcedStereoOut = false;
+        bool forcedStereoIn, forcedStereoOut, forcedStereoShared;
+        forcedStereoIn = forcedStereoOut = forcedStereoShared = false;
 
         bool needsCtrlIn, needsCtrlOut;
         needsCtrlIn = needsCtrlOut = false;
@@ -925,7 +930,10 @@ public:
 
         if (pData->options & PLUGIN_OPTION_FORCE_STEREO)
         {
-            if ((aIns == 1 || aOuts == 1) && fHandles.count() == 1 && addInstance())
+            if ((pData->options & PLUGIN_OPTION_FORCE_STEREO_SHARED) != 0 && fHandles.count() == 1)
+                forcedStereoShared = canShareForcedStereoInstance(aIns, aOuts);
+
+            if ((aIns == 1 || aOuts == 1) && fHandles.count() == 1 && (forcedStereoShared || addInstance()))
             {
                 if (aIns == 1)
                 {
@@ -1282,8 +1290,9 @@ public:
         // check initial latency
         findInitialLatencyValue(aIns, aOuts);
 
-        fForcedStereoIn  = forcedStereoIn;
-        fForcedStereoOut = forcedStereoOut;
+        fForcedStereoIn     = forcedStereoIn;
+        fForcedStereoOut    = forcedStereoOut;
+        fForcedStereoShared = forcedStereoShared;
 
         bufferSizeChanged(pData->engine->getBufferSize());
         reloadPrograms(true);
@@ -1572,6 +1581,7 @@ public:
             bool allNotesOffSent = false;
 #endif
             const bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
+            const uint32_t minSubBlockSize = std::max(1U, pData->engine->getOptions().minSubBlockSize);
 
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
@@ -1601,12 +1611,15 @@ public:
                     eventTime = timeOffset;
                 }
 
-                if (isSampleAccurate && eventTime > timeOffset)
+                // avoid tiny sub-blocks, splits only happen on a grid of minSubBlockSize frames
+                const uint32_t splitTime = eventTime - eventTime % minSubBlockSize;
+
+                if (isSampleAccurate && splitTime > timeOffset)
                 {
-                    if (processSingle(audioIn, audioOut, eventTime - timeOffset, timeOffset, midiEventCount))
+                    if (processSingle(audioIn, audioOut, splitTime - timeOffset, timeOffset, midiEventCount))
                     {
                         startTime  = 0;
-                        timeOffset = eventTime;
+                        timeOffset = splitTime;
                         midiEventCount = 0;
 
                         if (pData->midiprog.current >= 0 && pData->midiprog.count > 0)
@@ -1714,7 +1727,7 @@ public:
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
                             carla_zeroStruct(seqEvent);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : eventTime;
+                            seqEvent.time.tick = isSampleAccurate ? startTime + eventTime - timeOffset : eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1759,7 +1772,7 @@ public:
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
                             carla_zeroStruct(seqEvent);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : eventTime;
+                            seqEvent.time.tick = isSampleAccurate ? startTime + eventTime - timeOffset : eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1784,7 +1797,7 @@ public:
                             snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
                             carla_zeroStruct(seqEvent);
 
-                            seqEvent.time.tick = isSampleAccurate ? startTime : eventTime;
+                            seqEvent.time.tick = isSampleAccurate ? startTime + eventTime - timeOffset : eventTime;
 
                             seqEvent.type = SND_SEQ_EVENT_CONTROLLER;
                             seqEvent.data.control.channel = event.channel;
@@ -1813,7 +1826,7 @@ public:
                     snd_seq_event_t& seqEvent(fMidiEvents[midiEventCount++]);
                     carla_zeroStruct(seqEvent);
 
-                    seqEvent.time.tick = isSampleAccurate ? startTime : eventTime;
+                    seqEvent.time.tick = isSampleAccurate ? startTime + eventTime - timeOffset : eventTime;
 
                     switch (status)
                     {
@@ -2032,6 +2045,18 @@ public:
                 try {
                     fDescriptor->run(handle, frames);
                 } CARLA_SAFE_EXCEPTION("LADSPA/DSSI run");
+
+                // run the right channel through the same instance
+                if (fForcedStereoShared)
+                {
+                    connectSharedStereoPorts(handle, 1);
+
+                    try {
+                        fDescriptor->run(handle, frames);
+                    } CARLA_SAFE_EXCEPTION("LADSPA/DSSI run (shared stereo)");
+
+                    connectSharedStereoPorts(handle, 0);
+                }
             }
 
             // ----------------------------------------------------------------------------------------------------
@@ -2259,6 +2284,13 @@ public:
 
     void reconnectAudioPorts() const noexcept
     {
+        if (fForcedStereoShared)
+        {
+            if (LADSPA_Handle const handle = fHandles.getFirst(nullptr))
+                connectSharedStereoPorts(handle, 0);
+            return;
+        }
+
         if (fForcedStereoIn)
         {
             if (LADSPA_Handle const handle = fHandles.getFirst(nullptr))
@@ -2324,6 +2356,26 @@ public:
         }
     }
 
+    void connectSharedStereoPorts(LADSPA_Handle const handle, const uint32_t channel) const noexcept
+    {
+        try {
+            fDescriptor->connect_port(handle, pData->audioIn.ports[channel].rindex, fAudioInBuffers[channel]);
+        } CARLA_SAFE_EXCEPTION("LADSPA/DSSI connect_port (shared stereo input)");
+
+        try {
+            fDescriptor->connect_port(handle, pData->audioOut.ports[channel].rindex, fAudioOutBuffers[channel]);
+        } CARLA_SAFE_EXCEPTION("LADSPA/DSSI connect_port (shared stereo output)");
+    }
+
+    // only plain mono effects can share their instance, synths would handle MIDI events twice
+    bool canShareForcedStereoInstance(const uint32_t aIns, const uint32_t aOuts) const noexcept
+    {
+        if (aIns != 1 || aOuts != 1)
+            return false;
+
+        return fDssiDescriptor == nullptr || fDssiDescriptor->run_synth == nullptr;
+    }
+
     // -------------------------------------------------------------------
     // Plugin buffers
 
@@ -3013,6 +3065,9 @@ public:
         else if (options & PLUGIN_OPTION_FORCE_STEREO)
             pData->options |= PLUGIN_OPTION_FORCE_STEREO;
 
+        if (options & PLUGIN_OPTION_FORCE_STEREO_SHARED)
+            pData->options |= PLUGIN_OPTION_FORCE_STEREO_SHARED;
+
         if (fDssiDescriptor != nullptr)
         {
             if (fDssiDescriptor->get_program != nullptr && fDssiDescriptor->select_program != nullptr)
@@ -3061,6 +3116,7 @@ private:
     int32_t fLatencyIndex; // -1 if invalid
     bool    fForcedStereoIn;
     bool    fForcedStereoOut;
+    bool    fForcedStereoShared; // both channels run through the first instance
     bool    fNeedsFixedBuffers;
     bool    fUsesCustomData;
 
@@ -15,6 +15,8 @@
 #include "CarlaPipeUtils.hpp"
 #include "CarlaPluginUI.hpp"
 #include "CarlaScopeUtils.hpp"
+#include "CarlaSemUtils.hpp"
+#include "CarlaThread.hpp"
 #include "Lv2AtomRingBuffer.hpp"
 
 #include "extra/Base64.hpp"
@@ -521,7 +523,11 @@ public:
           fFilename(),
           fPluginURI(),
           fUiURI(),
-          fUiState(UiNone) {}
+          fUiState(UiNone)
+    {
+        // our own UI bridges can use binary messages
+        setBinaryModeAllowed(true);
+    }
 
     ~CarlaPipeServerLV2() noexcept override
     {
@@ -631,16 +637,304 @@ static void initAtomForge(LV2_Atom_Forge& atomForge) noexcept
 #endif
 }
 
+// -------------------------------------------------------------------------------------------------------------------
+// CarlaPluginLV2WorkerPool
+//
+// Process-wide pool of threads serving LV2 worker requests, shared by all LV2 plugins.
+// Plugins wake the pool from the audio thread as soon as a request is scheduled.
+// Requests from the same plugin are never served by more than one thread at a time,
+// nor while the plugin is held for activate, deactivate or state restore.
+
+class CarlaPluginLV2WorkerPool
+{
+public:
+    class Client
+    {
+    public:
+        Client() noexcept
+            : fPending(false),
+              fBusy(false) {}
+
+        virtual ~Client() {}
+
+    protected:
+        // called from one of the pool threads
+        virtual void runWorkerRequests() = 0;
+
+    private:
+        bool fPending;
+        bool fBusy;
+
+        friend class CarlaPluginLV2WorkerPool;
+        CARLA_DECLARE_NON_COPYABLE(Client)
+    };
+
+    static CarlaPluginLV2WorkerPool& getInstance() noexcept
+    {
+        static CarlaPluginLV2WorkerPool pool;
+        return pool;
+    }
+
+    // must be called from the main thread, returns false if the pool threads could not be started
+    bool registerClient(Client* const client)
+    {
+        CARLA_SAFE_ASSERT_RETURN(client != nullptr, false);
+
+        const CarlaMutexLocker cml(fLifecycleMutex);
+
+        if (fThreadCount == 0 && ! startThreads())
+            return false;
+
+        __atomic_store_n(&client->fPending, false, __ATOMIC_RELAXED);
+        __atomic_store_n(&client->fBusy, false, __ATOMIC_RELAXED);
+
+        const CarlaMutexLocker cml2(fClientsMutex);
+        return fClients.append(client);
+    }
+
+    // must be called from the main thread, waits for any request of this client currently being served
+    void unregisterClient(Client* const client)
+    {
+        CARLA_SAFE_ASSERT_RETURN(client != nullptr,);
+
+        const CarlaMutexLocker cml(fLifecycleMutex);
+
+        bool isEmpty;
+
+        {
+            const CarlaMutexLocker cml2(fClientsMutex);
+            fClients.removeOne(client);
+            isEmpty = fClients.isEmpty();
+        }
+
+        while (__atomic_load_n(&client->fBusy, __ATOMIC_ACQUIRE))
+            d_msleep(1);
+
+        if (isEmpty)
+            stopThreads();
+    }
+
+    // can be called from the audio thread
+    void schedule(Client* const client) noexcept
+    {
+        __atomic_store_n(&client->fPending, true, __ATOMIC_RELEASE);
+        wake();
+    }
+
+    // keeps the pool from serving a client, for plugin calls that must not run concurrently with work().
+    // waits for any request of this client currently being served, must not be used from the audio thread
+    class ScopedClientHold
+    {
+    public:
+        ScopedClientHold(Client* const client) noexcept
+            : kClient(client)
+        {
+            CarlaPluginLV2WorkerPool& pool(getInstance());
+
+            for (;;)
+            {
+                {
+                    const CarlaMutexLocker cml(pool.fClientsMutex);
+
+                    if (! __atomic_load_n(&kClient->fBusy, __ATOMIC_ACQUIRE))
+                    {
+                        __atomic_store_n(&kClient->fBusy, true, __ATOMIC_RELEASE);
+                        break;
+                    }
+                }
+
+                d_msleep(1);
+            }
+        }
+
+        ~ScopedClientHold() noexcept
+        {
+            __atomic_store_n(&kClient->fBusy, false, __ATOMIC_RELEASE);
+
+            // requests scheduled meanwhile were skipped by the pool
+            if (__atomic_load_n(&kClient->fPending, __ATOMIC_ACQUIRE))
+                getInstance().wake();
+        }
+
+    private:
+        Client* const kClient;
+
+        CARLA_PREVENT_HEAP_ALLOCATION
+        CARLA_DECLARE_NON_COPYABLE(ScopedClientHold)
+    };
+
+private:
+    static const uint32_t kMaxThreadCount = 2;
+
+    class Thread : public CarlaThread
+    {
+    public:
+        Thread(CarlaPluginLV2WorkerPool* const pool) noexcept
+            : CarlaThread("CarlaPluginLV2Worker"),
+              kPool(pool) {}
+
+        ~Thread() override
+        {
+            stopThread(1000);
+        }
+
+    protected:
+        void run() override
+        {
+            while (! shouldThreadExit())
+            {
+                if (! carla_sem_timedwait(kPool->fSem, 100))
+                    continue;
+
+                kPool->serve();
+            }
+        }
+
+    private:
+        CarlaPluginLV2WorkerPool* const kPool;
+
+        CARLA_DECLARE_NON_COPYABLE(Thread)
+    };
+
+    CarlaMutex fLifecycleMutex;
+    CarlaMutex fClientsMutex;
+    LinkedList<Client*> fClients;
+
+    Thread* fThreads[kMaxThreadCount];
+    uint32_t fThreadCount;
+
+    carla_sem_t fSem;
+    const bool fSemValid;
+    bool fWakePending;
+
+    CarlaPluginLV2WorkerPool() noexcept
+        : fLifecycleMutex(),
+          fClientsMutex(),
+          fClients(),
+          fThreadCount(0),
+          fSem(),
+          fSemValid(carla_sem_create2(fSem, false)),
+          fWakePending(false)
+    {
+        carla_zeroPointers(fThreads, kMaxThreadCount);
+    }
+
+    ~CarlaPluginLV2WorkerPool()
+    {
+        stopThreads();
+
+        if (fSemValid)
+            carla_sem_destroy2(fSem);
+    }
+
+    bool startThreads()
+    {
+        CARLA_SAFE_ASSERT_RETURN(fSemValid, false);
+
+        for (uint32_t i=0; i < kMaxThreadCount; ++i)
+        {
+            Thread* const thread = new Thread(this);
+
+            if (! thread->startThread(false))
+            {
+                delete thread;
+                break;
+            }
+
+            fThreads[fThreadCount++] = thread;
+        }
+
+        return fThreadCount != 0;
+    }
+
+    void stopThreads()
+    {
+        for (uint32_t i=0; i < fThreadCount; ++i)
+            fThreads[i]->signalThreadShouldExit();
+
+        for (uint32_t i=0; i < fThreadCount; ++i)
+        {
+            delete fThreads[i];
+            fThreads[i] = nullptr;
+        }
+
+        fThreadCount = 0;
+    }
+
+    // the semaphore is binary, so only post it if no thread was woken up yet
+    void wake() noexcept
+    {
+        if (! __atomic_exchange_n(&fWakePending, true, __ATOMIC_ACQ_REL))
+            carla_sem_post(fSem);
+    }
+
+    // take the next client with pending requests that is not being served yet
+    Client* claim(bool& hasMorePending) noexcept
+    {
+        const CarlaMutexLocker cml(fClientsMutex);
+
+        Client* claimed = nullptr;
+        hasMorePending = false;
+
+        for (LinkedList<Client*>::Itenerator it = fClients.begin2(); it.valid(); it.next())
+        {
+            Client* const client(it.getValue(nullptr));
+            CARLA_SAFE_ASSERT_CONTINUE(client != nullptr);
+
+            if (! __atomic_load_n(&client->fPending, __ATOMIC_ACQUIRE))
+                continue;
+            if (__atomic_load_n(&client->fBusy, __ATOMIC_ACQUIRE))
+                continue;
+
+            if (claimed != nullptr)
+            {
+                hasMorePending = true;
+                break;
+            }
+
+            __atomic_store_n(&client->fBusy, true, __ATOMIC_RELEASE);
+            __atomic_store_n(&client->fPending, false, __ATOMIC_RELEASE);
+            claimed = client;
+        }
+
+        return claimed;
+    }
+
+    void serve()
+    {
+        __atomic_store_n(&fWakePending, false, __ATOMIC_RELEASE);
+
+        bool hasMorePending;
+
+        while (Client* const client = claim(hasMorePending))
+        {
+            // let another thread serve the other clients meanwhile
+            if (hasMorePending)
+                wake();
+
+            try {
+                client->runWorkerRequests();
+            } CARLA_SAFE_EXCEPTION("CarlaPluginLV2WorkerPool runWorkerRequests");
+
+            __atomic_store_n(&client->fBusy, false, __ATOMIC_RELEASE);
+        }
+    }
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaPluginLV2WorkerPool)
+};
+
 // -------------------------------------------------------------------------------------------------------------------
 
 class CarlaPluginLV2 : public CarlaPlugin,
-                       private CarlaPluginUI::Callback
+                       private CarlaPluginUI::Callback,
+                       private CarlaPluginLV2WorkerPool::Client
 {
 public:
     CarlaPluginLV2(CarlaEngine* const engine, const uint id)
         : CarlaPlugin(engine, id),
           fHandle(nullptr),
           fHandle2(nullptr),
+          fForcedStereoShared(false),
           fDescriptor(nullptr),
           fRdfDescriptor(nullptr),
           fAudioInBuffers(nullptr),
@@ -652,6 +946,7 @@ public:
           fHasThreadSafeRestore(false),
           fNeedsFixedBuffers(false),
           fNeedsUiClose(false),
+          fHasControlPortInputs(false),
           fInlineDisplayNeedsRedraw(false),
           fInlineDisplayLastRedrawTime(0),
           fLatencyIndex(-1),
@@ -662,6 +957,8 @@ public:
           fAtomBufferWorkerResp(),
           fAtomBufferUiOutTmpData(nullptr),
           fAtomBufferWorkerInTmpData(nullptr),
+          fWorkerPoolRegistered(false),
+          fWorkerFallbackMutex(),
           fAtomBufferRealtime(nullptr),
           fAtomBufferRealtimeSize(0),
           fEventsIn(),
@@ -691,6 +988,9 @@ public:
 
         fInlineDisplayNeedsRedraw = false;
 
+        // stop serving worker requests before anything gets cleaned up
+        unregisterFromWorkerPool();
+
         // close UI
         if (fUI.type != UI::TYPE_NULL)
         {
@@ -1039,9 +1339,15 @@ public:
         else if (fEventsOut.count != 0)
             pass();
         // if inputs or outputs are just 1, then yes we can force stereo
-        else if ((pData->audioIn.count == 1 || pData->audioOut.count == 1) || fHandle2 != nullptr)
+        else if ((pData->audioIn.count == 1 || pData->audioOut.count == 1) || fHandle2 != nullptr || fForcedStereoShared)
             options |= PLUGIN_OPTION_FORCE_STEREO;
 
+        // a single instance can only be shared between both channels of mono effects,
+        // and not if it takes events, as those would be delivered twice
+        if (fEventsOut.count == 0 && ! hasEventInputPorts() &&
+            ((pData->audioIn.count == 1 && pData->audioOut.count == 1) || fForcedStereoShared))
+            options |= PLUGIN_OPTION_FORCE_STEREO_SHARED;
+
         if (fExt.programs != nullptr)
             options |= PLUGIN_OPTION_MAP_PROGRAM_CHANGES;
 
@@ -1909,7 +2215,12 @@ public:
                     if (! fPipeServer.writeMessage(tmpBuf))
                         return;
 
-                    // write parameter values
+                    // write parameter values, control ports are sent all at once
+                    std::vector<uint32_t> controlIndexes;
+                    std::vector<float> controlValues;
+                    controlIndexes.reserve(pData->param.count);
+                    controlValues.reserve(pData->param.count);
+
                     for (uint32_t i=0; i < pData->param.count; ++i)
                     {
                         ParameterData& pdata(pData->param.data[i]);
@@ -1928,12 +2239,18 @@ public:
                         }
                         else
                         {
-                            if (! fPipeServer.writeControlMessage(static_cast<uint32_t>(pData->param.data[i].rindex),
-                                                                  getParameterValue(i), false))
-                                return;
+                            controlIndexes.push_back(static_cast<uint32_t>(pData->param.data[i].rindex));
+                            controlValues.push_back(getParameterValue(i));
                         }
                     }
 
+                    if (! controlIndexes.empty())
+                    {
+                        if (! fPipeServer.writeControlMessages(controlIndexes.data(), controlValues.data(),
+                                                               static_cast<uint32_t>(controlIndexes.size()), false))
+                            return;
+                    }
+
                     // ready to show
                     if (! fPipeServer.writeMessage("show\n", 5))
                         return;
@@ -2137,25 +2454,13 @@ public:
 
     void idle() override
     {
-        if (fAtomBufferWorkerIn.isDataAvailableForReading())
+        // worker requests are served by the worker pool, unless its threads could not be started
+        if (! fWorkerPoolRegistered && fAtomBufferWorkerIn.isDataAvailableForReading())
         {
-            Lv2AtomRingBuffer tmpRingBuffer(fAtomBufferWorkerIn, fAtomBufferWorkerInTmpData);
-            CARLA_SAFE_ASSERT_RETURN(tmpRingBuffer.isDataAvailableForReading(),);
-            CARLA_SAFE_ASSERT_RETURN(fExt.worker != nullptr && fExt.worker->work != nullptr,);
-
-            const size_t localSize = fAtomBufferWorkerIn.getSize();
-            uint8_t* const localData = new uint8_t[localSize];
-            LV2_Atom* const localAtom = static_cast<LV2_Atom*>(static_cast<void*>(localData));
-            localAtom->size = localSize;
-            uint32_t portIndex;
+            const CarlaMutexTryLocker cmtl(fWorkerFallbackMutex);
 
-            for (; tmpRingBuffer.get(portIndex, localAtom); localAtom->size = localSize)
-            {
-                CARLA_SAFE_ASSERT_CONTINUE(localAtom->type == kUridCarlaAtomWorkerIn);
-                fExt.worker->work(fHandle, carla_lv2_worker_respond, this, localAtom->size, LV2_ATOM_BODY_CONST(localAtom));
-            }
-
-            delete[] localData;
+            if (cmtl.wasLocked())
+                runWorkerRequests();
         }
 
         if (fInlineDisplayNeedsRedraw)
@@ -2334,6 +2639,9 @@ public:
         // Safely disable plugin for reload
         const ScopedDisabler sd(this);
 
+        // no worker requests can be running while deactivating
+        unregisterFromWorkerPool();
+
         if (pData->active)
             deactivate();
 
@@ -2348,8 +2656,8 @@ public:
 
         const uint32_t eventBufferSize = static_cast<uint32_t>(fLv2Options.sequenceSize) + 0xff;
 
-        bool forcedStereoIn, forcedStereoOut;
-        forcedStereoIn = forcedStereoOut = false;
+        bool forcedStereoIn, forcedStereoOut, forcedStereoShared;
+        forcedStereoIn = forcedStereoOut = forcedStereoShared = false;
 
         bool needsCtrlIn, needsCtrlOut, hasPatchParameterOutputs;
         needsCtrlIn = needsCtrlOut = hasPatchParameterOutputs = false;
@@ -2417,14 +2725,18 @@ public:
 
         if ((pData->options & PLUGIN_OPTION_FORCE_STEREO) != 0 && aIns <= 1 && aOuts <= 1 && evOuts.count() == 0 && fExt.state == nullptr && fExt.worker == nullptr)
         {
-            if (fHandle2 == nullptr)
+            // mono effects without event inputs can run both channels through the same instance
+            if ((pData->options & PLUGIN_OPTION_FORCE_STEREO_SHARED) != 0 && fHandle2 == nullptr)
+                forcedStereoShared = aIns == 1 && aOuts == 1 && evIns.count() == 0;
+
+            if (fHandle2 == nullptr && ! forcedStereoShared)
             {
                 try {
                     fHandle2 = fDescriptor->instantiate(fDescriptor, sampleRate, fRdfDescriptor->Bundle, fFeatures);
                 } catch(...) {}
             }
 
-            if (fHandle2 != nullptr)
+            if (fHandle2 != nullptr || forcedStereoShared)
             {
                 if (aIns == 1)
                 {
@@ -3248,6 +3560,11 @@ public:
             fAtomBufferRealtime = static_cast<LV2_Atom*>(std::malloc(fAtomBufferRealtimeSize));
             fAtomBufferWorkerInTmpData = new uint8_t[fAtomBufferRealtimeSize];
             carla_mlock(fAtomBufferRealtime, fAtomBufferRealtimeSize);
+
+            fWorkerPoolRegistered = CarlaPluginLV2WorkerPool::getInstance().registerClient(this);
+
+            if (! fWorkerPoolRegistered)
+                carla_stderr2("CarlaPluginLV2::reload() - failed to start worker threads, requests will be served on idle");
         }
 
         if (fRdfDescriptor->ParameterCount > 0 ||
@@ -3292,6 +3609,8 @@ public:
         else
             pData->options &= ~PLUGIN_OPTION_FORCE_STEREO;
 
+        fForcedStereoShared = forcedStereoShared;
+
         // plugin hints
         pData->hints = (pData->hints & PLUGIN_HAS_INLINE_DISPLAY) ? PLUGIN_HAS_INLINE_DISPLAY : 0
                      | (pData->hints & PLUGIN_NEEDS_UI_MAIN_THREAD) ? PLUGIN_NEEDS_UI_MAIN_THREAD : 0;
@@ -3352,8 +3671,23 @@ public:
         // extra plugin hints
         pData->extraHints = 0x0;
 
-        // check initial latency
-        findInitialLatencyValue(aIns, cvIns, aOuts, cvOuts);
+        // check initial latency, the plugin is activated for it
+        {
+            const CarlaPluginLV2WorkerPool::ScopedClientHold scwh(this);
+            findInitialLatencyValue(aIns, cvIns, aOuts, cvOuts);
+        }
+
+        // check if any input parameter is a control port, as those cannot be changed mid-block
+        fHasControlPortInputs = false;
+
+        for (uint32_t i=0; i < pData->param.count; ++i)
+        {
+            if (pData->param.data[i].type == PARAMETER_INPUT && pData->param.data[i].rindex < static_cast<int32_t>(fRdfDescriptor->PortCount))
+            {
+                fHasControlPortInputs = true;
+                break;
+            }
+        }
 
         bufferSizeChanged(pData->engine->getBufferSize());
         reloadPrograms(true);
@@ -3584,6 +3918,8 @@ public:
 
         if (fDescriptor->activate != nullptr)
         {
+            const CarlaPluginLV2WorkerPool::ScopedClientHold scwh(this);
+
             try {
                 fDescriptor->activate(fHandle);
             } CARLA_SAFE_EXCEPTION("LV2 activate");
@@ -3606,6 +3942,8 @@ public:
 
         if (fDescriptor->deactivate != nullptr)
         {
+            const CarlaPluginLV2WorkerPool::ScopedClientHold scwh(this);
+
             try {
                 fDescriptor->deactivate(fHandle);
             } CARLA_SAFE_EXCEPTION("LV2 deactivate");
@@ -3990,7 +4328,9 @@ public:
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
             bool allNotesOffSent  = false;
 #endif
-            bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
+            // splitting is only needed for control ports, events and atom parameters are timestamped
+            bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0 && fHasControlPortInputs;
+            const uint32_t minSubBlockSize = std::max(1U, pData->engine->getOptions().minSubBlockSize);
 
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
@@ -4022,12 +4362,15 @@ public:
                     eventTime = timeOffset;
                 }
 
-                if (isSampleAccurate && eventTime > timeOffset)
+                // avoid tiny sub-blocks, splits only happen on a grid of minSubBlockSize frames
+                const uint32_t splitTime = eventTime - eventTime % minSubBlockSize;
+
+                if (isSampleAccurate && splitTime > timeOffset)
                 {
-                    if (processSingle(audioIn, audioOut, cvIn, cvOut, eventTime - timeOffset, timeOffset))
+                    if (processSingle(audioIn, audioOut, cvIn, cvOut, splitTime - timeOffset, timeOffset))
                     {
                         startTime  = 0;
-                        timeOffset = eventTime;
+                        timeOffset = splitTime;
 
                         if (pData->midiprog.current >= 0 && pData->midiprog.count > 0)
                             nextBankId = pData->midiprog.data[pData->midiprog.current].bank;
@@ -4050,7 +4393,7 @@ public:
                             {
                                 fEventsIn.data[j].midi.event_count = 0;
                                 fEventsIn.data[j].midi.size        = 0;
-                                fEventsIn.iters[j].midiState.position = eventTime;
+                                fEventsIn.iters[j].midiState.position = splitTime;
                             }
                         }
 
@@ -4177,7 +4520,7 @@ public:
                             midiData[1] = uint8_t(ctrlEvent.param);
                             midiData[2] = uint8_t(ctrlEvent.normalizedValue*127.0f + 0.5f);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : eventTime);
+                            const uint32_t mtime(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&fEventsIn.iters[fEventsIn.ctrlIndex].atom, mtime, 0, kUridMidiEvent, 3, midiData);
@@ -4209,7 +4552,7 @@ public:
                             midiData[1] = MIDI_CONTROL_BANK_SELECT;
                             midiData[2] = uint8_t(ctrlEvent.param);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : eventTime);
+                            const uint32_t mtime(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&fEventsIn.iters[fEventsIn.ctrlIndex].atom, mtime, 0, kUridMidiEvent, 3, midiData);
@@ -4245,7 +4588,7 @@ public:
                             midiData[0] = uint8_t(MIDI_STATUS_PROGRAM_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             midiData[1] = uint8_t(ctrlEvent.param);
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : eventTime);
+                            const uint32_t mtime(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
 
                             if (fEventsIn.ctrl->type & CARLA_EVENT_DATA_ATOM)
                                 lv2_atom_buffer_write(&fEventsIn.iters[fEventsIn.ctrlIndex].atom, mtime, 0, kUridMidiEvent, 2, midiData);
@@ -4261,7 +4604,7 @@ public:
                     case kEngineControlEventTypeAllSoundOff:
                         if (pData->options & PLUGIN_OPTION_SEND_ALL_SOUND_OFF)
                         {
-                            const uint32_t mtime(isSampleAccurate ? startTime : eventTime);
+                            const uint32_t mtime(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
 
                             uint8_t midiData[3];
                             midiData[0] = uint8_t(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
@@ -4290,7 +4633,7 @@ public:
                             }
 #endif
 
-                            const uint32_t mtime(isSampleAccurate ? startTime : eventTime);
+                            const uint32_t mtime(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
 
                             uint8_t midiData[3];
                             midiData[0] = uint8_t(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
@@ -4334,7 +4677,7 @@ public:
                         status = MIDI_STATUS_NOTE_OFF;
 
                     const uint32_t j     = fEventsIn.ctrlIndex;
-                    const uint32_t mtime = isSampleAccurate ? startTime : eventTime;
+                    const uint32_t mtime = isSampleAccurate ? startTime + eventTime - timeOffset : eventTime;
 
                     // put back channel in data
                     uint8_t midiData2[4]; // FIXME
@@ -4628,7 +4971,16 @@ public:
         fDescriptor->run(fHandle, frames);
 
         if (fHandle2 != nullptr)
+        {
             fDescriptor->run(fHandle2, frames);
+        }
+        else if (fForcedStereoShared)
+        {
+            // run the right channel through the same instance
+            connectSharedStereoPorts(1);
+            fDescriptor->run(fHandle, frames);
+            connectSharedStereoPorts(0);
+        }
 
         // --------------------------------------------------------------------------------------------------------
         // Handle trigger parameters
@@ -4775,6 +5127,33 @@ public:
         return true;
     }
 
+    bool hasEventInputPorts() const noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(fRdfDescriptor != nullptr, false);
+
+        for (uint32_t i=0; i < fRdfDescriptor->PortCount; ++i)
+        {
+            const LV2_Property portTypes(fRdfDescriptor->Ports[i].Types);
+
+            if (! LV2_IS_PORT_INPUT(portTypes))
+                continue;
+
+            if (LV2_IS_PORT_ATOM_SEQUENCE(portTypes) || LV2_IS_PORT_EVENT(portTypes) || LV2_IS_PORT_MIDI_LL(portTypes))
+                return true;
+        }
+
+        return false;
+    }
+
+    void connectSharedStereoPorts(const uint32_t channel) const noexcept
+    {
+        if (pData->audioIn.count > 0)
+            fDescriptor->connect_port(fHandle, pData->audioIn.ports[channel].rindex, fAudioInBuffers[channel]);
+
+        if (pData->audioOut.count > 0)
+            fDescriptor->connect_port(fHandle, pData->audioOut.ports[channel].rindex, fAudioOutBuffers[channel]);
+    }
+
     void bufferSizeChanged(const uint32_t newBufferSize) override
     {
         CARLA_ASSERT_INT(newBufferSize > 0, newBufferSize);
@@ -4794,7 +5173,11 @@ public:
             fAudioOutBuffers[i] = new float[newBufferSize];
         }
 
-        if (fHandle2 == nullptr)
+        if (fForcedStereoShared)
+        {
+            connectSharedStereoPorts(0);
+        }
+        else if (fHandle2 == nullptr)
         {
             for (uint32_t i=0; i < pData->audioIn.count; ++i)
             {
@@ -5256,6 +5639,7 @@ public:
 
         {
             const ScopedSingleProcessLocker spl(this, !fHasThreadSafeRestore);
+            const CarlaPluginLV2WorkerPool::ScopedClientHold scwh(this);
 
             try {
                 status = fExt.state->restore(fHandle,
@@ -6079,7 +6463,20 @@ public:
 
         if (pData->engine->isOffline())
         {
-            fExt.worker->work(fHandle, carla_lv2_worker_respond, this, size, data);
+            if (fWorkerPoolRegistered)
+            {
+                // wait for the pool to finish with this plugin, then serve its queued requests first to keep them in order
+                const CarlaPluginLV2WorkerPool::ScopedClientHold scwh(this);
+                runWorkerRequests();
+                fExt.worker->work(fHandle, carla_lv2_worker_respond, this, size, data);
+            }
+            else
+            {
+                const CarlaMutexLocker cml(fWorkerFallbackMutex);
+                runWorkerRequests();
+                fExt.worker->work(fHandle, carla_lv2_worker_respond, this, size, data);
+            }
+
             return LV2_WORKER_SUCCESS;
         }
 
@@ -6087,7 +6484,46 @@ public:
         atom.size = size;
         atom.type = kUridCarlaAtomWorkerIn;
 
-        return fAtomBufferWorkerIn.putChunk(&atom, data, fEventsOut.ctrlIndex) ? LV2_WORKER_SUCCESS : LV2_WORKER_ERR_NO_SPACE;
+        if (! fAtomBufferWorkerIn.putChunk(&atom, data, fEventsOut.ctrlIndex))
+            return LV2_WORKER_ERR_NO_SPACE;
+
+        if (fWorkerPoolRegistered)
+            CarlaPluginLV2WorkerPool::getInstance().schedule(this);
+
+        return LV2_WORKER_SUCCESS;
+    }
+
+    void runWorkerRequests() override
+    {
+        if (! fAtomBufferWorkerIn.isDataAvailableForReading())
+            return;
+
+        Lv2AtomRingBuffer tmpRingBuffer(fAtomBufferWorkerIn, fAtomBufferWorkerInTmpData);
+        CARLA_SAFE_ASSERT_RETURN(tmpRingBuffer.isDataAvailableForReading(),);
+        CARLA_SAFE_ASSERT_RETURN(fExt.worker != nullptr && fExt.worker->work != nullptr,);
+
+        const size_t localSize = fAtomBufferWorkerIn.getSize();
+        uint8_t* const localData = new uint8_t[localSize];
+        LV2_Atom* const localAtom = static_cast<LV2_Atom*>(static_cast<void*>(localData));
+        localAtom->size = localSize;
+        uint32_t portIndex;
+
+        for (; tmpRingBuffer.get(portIndex, localAtom); localAtom->size = localSize)
+        {
+            CARLA_SAFE_ASSERT_CONTINUE(localAtom->type == kUridCarlaAtomWorkerIn);
+            fExt.worker->work(fHandle, carla_lv2_worker_respond, this, localAtom->size, LV2_ATOM_BODY_CONST(localAtom));
+        }
+
+        delete[] localData;
+    }
+
+    void unregisterFromWorkerPool()
+    {
+        if (! fWorkerPoolRegistered)
+            return;
+
+        fWorkerPoolRegistered = false;
+        CarlaPluginLV2WorkerPool::getInstance().unregisterClient(this);
     }
 
     LV2_Worker_Status handleWorkerRespond(const uint32_t size, const void* const data)
@@ -6950,6 +7386,9 @@ public:
         else if (options & PLUGIN_OPTION_FORCE_STEREO)
             pData->options |= PLUGIN_OPTION_FORCE_STEREO;
 
+        if (options & PLUGIN_OPTION_FORCE_STEREO_SHARED)
+            pData->options |= PLUGIN_OPTION_FORCE_STEREO_SHARED;
+
         if (getMidiInCount() != 0)
         {
             if (isPluginOptionEnabled(options, PLUGIN_OPTION_SEND_CONTROL_CHANGES))
@@ -7525,6 +7964,7 @@ public:
 private:
     LV2_Handle   fHandle;
     LV2_Handle   fHandle2;
+    bool         fForcedStereoShared; // both channels run through fHandle
     LV2_Feature* fFeatures[kFeatureCountAll+1];
     LV2_Feature* fStateFeatures[kStateFeatureCountAll+1];
     const LV2_Descriptor*     fDescriptor;
@@ -7540,6 +7980,7 @@ private:
     bool    fHasThreadSafeRestore : 1;
     bool    fNeedsFixedBuffers : 1;
     bool    fNeedsUiClose  : 1;
+    bool    fHasControlPortInputs : 1;
     bool    fInlineDisplayNeedsRedraw : 1;
     int64_t fInlineDisplayLastRedrawTime;
     int32_t fLatencyIndex; // -1 if invalid
@@ -7551,6 +7992,8 @@ private:
     Lv2AtomRingBuffer fAtomBufferWorkerResp;
     uint8_t*          fAtomBufferUiOutTmpData;
     uint8_t*          fAtomBufferWorkerInTmpData;
+    bool              fWorkerPoolRegistered;
+    CarlaMutex        fWorkerFallbackMutex; // serializes work() when idle() serves the requests
     LV2_Atom*         fAtomBufferRealtime;
     uint32_t          fAtomBufferRealtimeSize;
 
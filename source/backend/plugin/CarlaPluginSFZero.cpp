@@ -686,7 +686,10 @@ public:
         };
 
         sound->loadRegions();
-        sound->loadSamples(cb);
+        sound->loadSamples(cb, pData->engine->getOptions().sfzStreamingPreload);
+
+        if (sound->hasStreamedSamples())
+            fSynth.setupStreaming();
 
         if (fSynth.addSound(sound) == nullptr)
         {
@@ -795,4 +798,19 @@ CarlaPluginPtr CarlaPlugin::newSFZero(const Initializer& init)
 
 // -------------------------------------------------------------------------------------------------------------------
 
+void carla_get_sfzero_sample_store_usage(uint32_t& sampleCount, uint64_t& memoryUsage)
+{
+#ifdef HAVE_SFZ
+    const water::SharedResourcePointer<sfzero::SampleStore> sampleStore;
+
+    sampleCount = static_cast<uint32_t>(sampleStore->getNumSamples());
+    memoryUsage = static_cast<uint64_t>(sampleStore->getMemoryUsage());
+#else
+    sampleCount = 0;
+    memoryUsage = 0;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------------------------
+
 CARLA_BACKEND_END_NAMESPACE
@@ -1335,6 +1335,7 @@ public:
             bool allNotesOffSent = false;
 #endif
             bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
+            const uint32_t minSubBlockSize = std::max(1U, pData->engine->getOptions().minSubBlockSize);
 
             uint32_t startTime  = 0;
             uint32_t timeOffset = 0;
@@ -1358,12 +1359,15 @@ public:
                     eventTime = timeOffset;
                 }
 
-                if (isSampleAccurate && eventTime > timeOffset)
+                // avoid tiny sub-blocks, splits only happen on a grid of minSubBlockSize frames
+                const uint32_t splitTime = eventTime - eventTime % minSubBlockSize;
+
+                if (isSampleAccurate && splitTime > timeOffset)
                 {
-                    if (processSingle(audioIn, audioOut, eventTime - timeOffset, timeOffset))
+                    if (processSingle(audioIn, audioOut, splitTime - timeOffset, timeOffset))
                     {
                         startTime  = 0;
-                        timeOffset = eventTime;
+                        timeOffset = splitTime;
 
                         if (fMidiEventCount > 0)
                         {
@@ -1474,7 +1478,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = char(ctrlEvent.param);
                             vstMidiEvent.midiData[2] = char(ctrlEvent.normalizedValue*127.0f + 0.5f);
@@ -1497,7 +1501,7 @@ public:
                             carla_zeroStruct(vstMidiEvent_MSB);
                             vstMidiEvent_MSB.type = kVstMidiType;
                             vstMidiEvent_MSB.byteSize = kVstMidiEventSize;
-                            vstMidiEvent_MSB.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : event.time);
+                            vstMidiEvent_MSB.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : event.time);
                             vstMidiEvent_MSB.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent_MSB.midiData[1] = MIDI_CONTROL_BANK_SELECT;
                             vstMidiEvent_MSB.midiData[2] = 0;
@@ -1506,7 +1510,7 @@ public:
                             carla_zeroStruct(vstMidiEvent_LSB);
                             vstMidiEvent_LSB.type        = kVstMidiType;
                             vstMidiEvent_LSB.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent_LSB.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                            vstMidiEvent_LSB.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                             vstMidiEvent_LSB.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent_LSB.midiData[1] = MIDI_CONTROL_BANK_SELECT__LSB;
                             vstMidiEvent_LSB.midiData[2] = char(ctrlEvent.param);
@@ -1532,7 +1536,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_PROGRAM_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = char(ctrlEvent.param);
                         }
@@ -1549,7 +1553,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = MIDI_CONTROL_ALL_SOUND_OFF;
                         }
@@ -1574,7 +1578,7 @@ public:
 
                             vstMidiEvent.type        = kVstMidiType;
                             vstMidiEvent.byteSize    = kVstMidiEventSize;
-                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                            vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                             vstMidiEvent.midiData[0] = char(MIDI_STATUS_CONTROL_CHANGE | (event.channel & MIDI_CHANNEL_BIT));
                             vstMidiEvent.midiData[1] = MIDI_CONTROL_ALL_NOTES_OFF;
                         }
@@ -1617,7 +1621,7 @@ public:
 
                     vstMidiEvent.type        = kVstMidiType;
                     vstMidiEvent.byteSize    = kVstMidiEventSize;
-                    vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime : eventTime);
+                    vstMidiEvent.deltaFrames = static_cast<int32_t>(isSampleAccurate ? startTime + eventTime - timeOffset : eventTime);
                     vstMidiEvent.midiData[0] = char(status | (event.channel & MIDI_CHANNEL_BIT));
                     vstMidiEvent.midiData[1] = char(midiEvent.size >= 2 ? midiEvent.data[1] : 0);
                     vstMidiEvent.midiData[2] = char(midiEvent.size >= 3 ? midiEvent.data[2] : 0);
@@ -2359,6 +2363,10 @@ protected:
                                         pData->id, 0, 0, 0, 0.0f, nullptr);
             }
 
+            // this is also the only way for plugins to tell their chunk changed
+            if (! fIsInitializing)
+                pData->stateChanged();
+
             ret = 1;
             break;
         }
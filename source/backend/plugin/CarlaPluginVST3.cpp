@@ -511,16 +511,17 @@ private:
 
 struct carla_v3_input_param_value_queue : v3_param_value_queue_cpp {
     const v3_param_id paramId;
-    int8_t numUsed;
+    int32_t numUsed;
 
     struct Point {
         int32_t offset;
         float value;
-    } points[32];
+    }* points; // range of the shared point storage, see carla_v3_input_param_changes::prepare()
 
     carla_v3_input_param_value_queue(const v3_param_id pId)
         : paramId(pId),
-          numUsed(0)
+          numUsed(0),
+          points(nullptr)
     {
         query_interface = v3_query_interface_static<v3_param_value_queue_iid>;
         ref = v3_ref_static;
@@ -548,7 +549,7 @@ private:
                                       const int32_t idx, int32_t* const sample_offset, double* const value)
     {
         carla_v3_input_param_value_queue* const me = *static_cast<carla_v3_input_param_value_queue**>(self);
-        CARLA_SAFE_ASSERT_INT2_RETURN(idx < me->numUsed, idx, me->numUsed, V3_INVALID_ARG);
+        CARLA_SAFE_ASSERT_INT2_RETURN(idx >= 0 && idx < me->numUsed, idx, me->numUsed, V3_INVALID_ARG);
 
         *sample_offset = me->points[idx].offset;
         *value = me->points[idx].value;
@@ -578,12 +579,57 @@ struct carla_v3_input_param_changes : v3_param_changes_cpp {
     v3_param_value_queue*** pluginExposedQueue;
     int32_t pluginExposedCount;
 
+    // Storage for the points of all parameters, allocated outside of the audio thread.
+    // Points are first stored in the order they arrive, then moved into a contiguous range per parameter.
+    // One point per parameter is always reserved, so the latest value of every parameter can be sent.
+    struct PointStorage {
+        struct PendingPoint {
+            uint32_t index;
+            carla_v3_input_param_value_queue::Point point;
+        }* pending;
+        carla_v3_input_param_value_queue::Point* sorted;
+        uint32_t capacity;
+
+        PointStorage() noexcept
+            : pending(nullptr),
+              sorted(nullptr),
+              capacity(0) {}
+
+        PointStorage(const uint32_t size)
+            : pending(new PendingPoint[size]),
+              sorted(new carla_v3_input_param_value_queue::Point[size]),
+              capacity(size) {}
+
+        ~PointStorage()
+        {
+            delete[] pending;
+            delete[] sorted;
+        }
+
+        void swap(PointStorage& other) noexcept
+        {
+            std::swap(pending, other.pending);
+            std::swap(sorted, other.sorted);
+            std::swap(capacity, other.capacity);
+        }
+
+        CARLA_DECLARE_NON_COPYABLE(PointStorage)
+    } points;
+
+    uint32_t numPendingPoints;
+    uint32_t numParamsWithPoints;
+    volatile bool needsMorePoints;
+
     carla_v3_input_param_changes(const PluginParameterData& paramData)
         : paramCount(paramData.count),
           updatedParams(new UpdatedParam[paramData.count]),
           queue(new carla_v3_input_param_value_queue*[paramData.count]),
           pluginExposedQueue(new v3_param_value_queue**[paramData.count]),
-          pluginExposedCount(0)
+          pluginExposedCount(0),
+          points(),
+          numPendingPoints(0),
+          numParamsWithPoints(0),
+          needsMorePoints(false)
     {
         query_interface = v3_query_interface_static<v3_param_changes_iid>;
         ref = v3_ref_static;
@@ -610,21 +656,37 @@ struct carla_v3_input_param_changes : v3_param_changes_cpp {
         delete[] queue;
     }
 
+    // number of points available on top of the reserved ones
+    uint32_t getAutomationPointCapacity() const noexcept
+    {
+        return points.capacity > paramCount ? points.capacity - paramCount : 0;
+    }
+
+    // must not be called while processing, the new storage is swapped in and the old one returned
+    void swapPointStorage(PointStorage& storage) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(storage.capacity >= paramCount,);
+
+        points.swap(storage);
+        numPendingPoints = numParamsWithPoints = 0;
+        needsMorePoints = false;
+
+        for (uint32_t i=0; i<paramCount; ++i)
+            queue[i]->numUsed = 0;
+    }
+
     // called during start of process, gathering all parameter update requests so far
     void init()
     {
+        numPendingPoints = numParamsWithPoints = 0;
+
+        for (uint32_t i=0; i<paramCount; ++i)
+            queue[i]->numUsed = 0;
+
         for (uint32_t i=0; i<paramCount; ++i)
         {
             if (updatedParams[i].updated)
-            {
-                queue[i]->numUsed = 1;
-                queue[i]->points[0].offset = 0;
-                queue[i]->points[0].value = updatedParams[i].value;
-            }
-            else
-            {
-                queue[i]->numUsed = 0;
-            }
+                addPoint(i, 0, updatedParams[i].value);
         }
     }
 
@@ -632,11 +694,27 @@ struct carla_v3_input_param_changes : v3_param_changes_cpp {
     void prepare()
     {
         int32_t count = 0;
+        uint32_t start = 0;
 
         for (uint32_t i=0; i<paramCount; ++i)
         {
-            if (queue[i]->numUsed)
-                pluginExposedQueue[count++] = (v3_param_value_queue**)&queue[i];
+            if (queue[i]->numUsed == 0)
+                continue;
+
+            queue[i]->points = points.sorted + start;
+            start += static_cast<uint32_t>(queue[i]->numUsed);
+
+            // used as write position below
+            queue[i]->numUsed = 0;
+
+            pluginExposedQueue[count++] = (v3_param_value_queue**)&queue[i];
+        }
+
+        // stable, so each parameter keeps its points ordered by time
+        for (uint32_t i=0; i<numPendingPoints; ++i)
+        {
+            carla_v3_input_param_value_queue* const q = queue[points.pending[i].index];
+            q->points[q->numUsed++] = points.pending[i].point;
         }
 
         pluginExposedCount = count;
@@ -652,25 +730,44 @@ struct carla_v3_input_param_changes : v3_param_changes_cpp {
     // called as response to MIDI CC
     void setParamValueRT(const uint32_t index, const int32_t offset, const float value) noexcept
     {
-        static constexpr const int8_t kQueuePointSize = sizeof(queue[0]->points)/sizeof(queue[0]->points[0]);
+        addPoint(index, offset, value);
+    }
+
+private:
+    void addPoint(const uint32_t index, const int32_t offset, const float value) noexcept
+    {
+        CARLA_SAFE_ASSERT_UINT2_RETURN(index < paramCount, index, paramCount,);
+
+        carla_v3_input_param_value_queue* const q = queue[index];
 
-        if (queue[index]->numUsed < kQueuePointSize)
+        // first point of a parameter always fits, others only if not taking the space reserved for the rest
+        if (q->numUsed == 0 ? numPendingPoints < points.capacity
+                            : numPendingPoints + (paramCount - numParamsWithPoints) < points.capacity)
         {
-            // still has space, add in queue
-            carla_v3_input_param_value_queue::Point& point(queue[index]->points[queue[index]->numUsed++]);
-            point.offset = offset;
-            point.value = value;
+            if (q->numUsed++ == 0)
+                ++numParamsWithPoints;
+
+            PointStorage::PendingPoint& pending(points.pending[numPendingPoints++]);
+            pending.index = index;
+            pending.point.offset = offset;
+            pending.point.value = value;
+            return;
         }
-        else
+
+        // points are full, replace last one of this parameter and ask for more space
+        needsMorePoints = true;
+
+        for (uint32_t i=numPendingPoints; i-- != 0;)
         {
-            // points are full, replace last one
-            carla_v3_input_param_value_queue::Point& point(queue[index]->points[queue[index]->numUsed - 1]);
-            point.offset = offset;
-            point.value = value;
+            if (points.pending[i].index != index)
+                continue;
+
+            points.pending[i].point.offset = offset;
+            points.pending[i].point.value = value;
+            break;
         }
     }
 
-private:
     static int32_t V3_API get_param_count(void* const self)
     {
         carla_v3_input_param_changes* const me = *static_cast<carla_v3_input_param_changes**>(self);
@@ -1200,7 +1297,10 @@ public:
         : CarlaPlugin(engine, id),
           kEngineHasIdleOnMainThread(engine->hasIdleOnMainThread()),
           fFirstActive(true),
+          fUse64BitSamples(false),
           fAudioAndCvOutBuffers(nullptr),
+          fAudioOutBuffers64(nullptr),
+          fExtraBuffer64(nullptr),
           fLastKnownLatency(0),
           fRestartFlags(0),
           fLastChunk(nullptr),
@@ -1910,6 +2010,9 @@ public:
         if (kEngineHasIdleOnMainThread)
             runIdleCallbacksAsNeeded(true);
 
+        if (fEvents.paramInputs != nullptr && fEvents.paramInputs->needsMorePoints)
+            growParameterPoints();
+
         CarlaPlugin::idle();
     }
 
@@ -2072,6 +2175,18 @@ public:
                 fAudioAndCvOutBuffers[i] = nullptr;
         }
 
+        // use 64-bit processing when the engine has double-precision buffers, CV needs 32-bit
+        fUse64BitSamples = pData->engine->usesDoublePrecision() && cvIns == 0 && cvOuts == 0
+            && v3_cpp_obj(fV3.processor)->can_process_sample_size(fV3.processor, V3_SAMPLE_64) == V3_OK;
+
+        if (fUse64BitSamples && aOuts > 0)
+        {
+            fAudioOutBuffers64 = new double*[aOuts];
+
+            for (uint32_t i=0; i < aOuts; ++i)
+                fAudioOutBuffers64[i] = nullptr;
+        }
+
         const EngineProcessMode processMode = pData->engine->getProccessMode();
         const uint portNameSize = pData->engine->getMaxPortNameSize();
         String portName;
@@ -2354,7 +2469,7 @@ public:
         // initial audio setup
         v3_process_setup setup = {
             pData->engine->isOffline() ? V3_OFFLINE : V3_REALTIME,
-            V3_SAMPLE_32,
+            getSymbolicSampleSize(),
             static_cast<int32_t>(pData->engine->getBufferSize()),
             pData->engine->getSampleRate()
         };
@@ -2437,6 +2552,27 @@ public:
 
     void process(const float* const* const audioIn, float** const audioOut,
                  const float* const* const cvIn, float** const cvOut, const uint32_t frames) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(! fUse64BitSamples,);
+
+        processWithSampleType(audioIn, audioOut, cvIn, cvOut, frames);
+    }
+
+    bool canProcessDouble() const noexcept override
+    {
+        return fUse64BitSamples;
+    }
+
+    void processDouble(const double* const* const audioIn, double** const audioOut, const uint32_t frames) override
+    {
+        CARLA_SAFE_ASSERT_RETURN(fUse64BitSamples,);
+
+        processWithSampleType(audioIn, audioOut, nullptr, nullptr, frames);
+    }
+
+    template <typename SampleType>
+    void processWithSampleType(const SampleType* const* const audioIn, SampleType** const audioOut,
+                               const float* const* const cvIn, float** const cvOut, const uint32_t frames)
     {
         // ------------------------------------------------------------------------------------------------------------
         // Check if active
@@ -2445,7 +2581,7 @@ public:
         {
             // disable any output sound
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
-                carla_zeroFloats(audioOut[i], frames);
+                carla_zeroStructs(audioOut[i], frames);
             for (uint32_t i=0; i < pData->cvOut.count; ++i)
                 carla_zeroFloats(cvOut[i], frames);
             return;
@@ -2614,14 +2750,12 @@ public:
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
             bool allNotesOffSent  = false;
 #endif
-            bool isSampleAccurate = (pData->options & PLUGIN_OPTION_FIXED_BUFFERS) == 0;
-
-            uint32_t startTime = 0;
-            uint32_t timeOffset = 0;
+            // parameter changes and events are timestamped, so the whole block is processed at once
+            uint32_t previousEventTime = 0;
 
 #ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
             if (cvIn != nullptr && pData->event.cvSourcePorts != nullptr)
-                pData->event.cvSourcePorts->initPortBuffers(cvIn, frames, isSampleAccurate, pData->event.portIn);
+                pData->event.cvSourcePorts->initPortBuffers(cvIn, frames, true, pData->event.portIn);
 #endif
 
             for (uint32_t i=0, numEvents = pData->event.portIn->getEventCount(); i < numEvents; ++i)
@@ -2631,27 +2765,14 @@ public:
                 uint32_t eventTime = event.time;
                 CARLA_SAFE_ASSERT_UINT2_CONTINUE(eventTime < frames, eventTime, frames);
 
-                if (eventTime < timeOffset)
+                if (eventTime < previousEventTime)
                 {
-                    carla_stderr2("Timing error, eventTime:%u < timeOffset:%u for '%s'",
-                                  eventTime, timeOffset, pData->name);
-                    eventTime = timeOffset;
+                    carla_stderr2("Timing error, eventTime:%u < previousEventTime:%u for '%s'",
+                                  eventTime, previousEventTime, pData->name);
+                    eventTime = previousEventTime;
                 }
 
-                if (isSampleAccurate && eventTime > timeOffset)
-                {
-                    if (processSingle(audioIn, audioOut, cvIn, cvOut, eventTime - timeOffset, timeOffset))
-                    {
-                        startTime  = 0;
-                        timeOffset = eventTime;
-
-                        // TODO
-                    }
-                    else
-                    {
-                        startTime += timeOffset;
-                    }
-                }
+                previousEventTime = eventTime;
 
                 switch (event.type)
                 {
@@ -2678,7 +2799,7 @@ public:
 
                             ctrlEvent.handled = true;
                             value = pData->param.getFinalUnnormalizedValue(k, ctrlEvent.normalizedValue);
-                            setParameterValueRT(k, value, event.time, true);
+                            setParameterValueRT(k, value, eventTime, true);
                             continue;
                         }
 
@@ -2739,7 +2860,7 @@ public:
 
                             ctrlEvent.handled = true;
                             value = pData->param.getFinalUnnormalizedValue(k, ctrlEvent.normalizedValue);
-                            setParameterValueRT(k, value, event.time, true);
+                            setParameterValueRT(k, value, eventTime, true);
                         }
 
                         if ((pData->options & PLUGIN_OPTION_SEND_CONTROL_CHANGES) != 0 && ctrlEvent.param < MAX_MIDI_VALUE)
@@ -2761,7 +2882,7 @@ public:
                                 if (index == UINT32_MAX)
                                     break;
 
-                                fEvents.paramInputs->setParamValueRT(index, event.time, ctrlEvent.normalizedValue);
+                                fEvents.paramInputs->setParamValueRT(index, eventTime, ctrlEvent.normalizedValue);
                             }
                         }
 
@@ -2806,7 +2927,7 @@ public:
                                 if (index == UINT32_MAX)
                                     break;
 
-                                fEvents.paramInputs->setParamValueRT(index, event.time, 0.f);
+                                fEvents.paramInputs->setParamValueRT(index, eventTime, 0.f);
                             }
                         }
                         break;
@@ -2839,7 +2960,7 @@ public:
                                 if (index == UINT32_MAX)
                                     break;
 
-                                fEvents.paramInputs->setParamValueRT(index, event.time, 0.f);
+                                fEvents.paramInputs->setParamValueRT(index, eventTime, 0.f);
                             }
                         }
                         break;
@@ -2884,6 +3005,7 @@ public:
                             carla_zeroStruct(v3event);
 
                             v3event.type = V3_EVENT_NOTE_OFF;
+                            v3event.sample_offset = static_cast<int32_t>(eventTime);
                             v3event.note_off.channel = event.channel & MIDI_CHANNEL_BIT;
                             v3event.note_off.pitch   = note;
 
@@ -2901,6 +3023,7 @@ public:
                             carla_zeroStruct(v3event);
 
                             v3event.type = V3_EVENT_NOTE_ON;
+                            v3event.sample_offset = static_cast<int32_t>(eventTime);
                             v3event.note_on.channel  = event.channel & MIDI_CHANNEL_BIT;
                             v3event.note_on.pitch    = note;
                             v3event.note_on.velocity = static_cast<float>(velo) / 127.f;
@@ -2919,6 +3042,7 @@ public:
                             carla_zeroStruct(v3event);
 
                             v3event.type = V3_EVENT_POLY_PRESSURE;
+                            v3event.sample_offset = static_cast<int32_t>(eventTime);
                             v3event.poly_pressure.channel  = event.channel;
                             v3event.poly_pressure.pitch    = note;
                             v3event.poly_pressure.pressure = static_cast<float>(pressure) / 127.f;
@@ -2948,7 +3072,7 @@ public:
                                     break;
 
                                 fEvents.paramInputs->setParamValueRT(index,
-                                                                     event.time,
+                                                                     eventTime,
                                                                      static_cast<float>(value) / 127.f);
                             }
                         }
@@ -2976,7 +3100,7 @@ public:
                                     break;
 
                                 fEvents.paramInputs->setParamValueRT(index,
-                                                                     event.time,
+                                                                     eventTime,
                                                                      static_cast<float>(pressure) / 127.f);
                             }
                         }
@@ -3004,7 +3128,7 @@ public:
                                     break;
 
                                 fEvents.paramInputs->setParamValueRT(index,
-                                                                     event.time,
+                                                                     eventTime,
                                                                      static_cast<float>(pitchbend) / 16384.f);
                             }
                         }
@@ -3018,8 +3142,7 @@ public:
 
             pData->postRtEvents.trySplice();
 
-            if (frames > timeOffset)
-                processSingle(audioIn, audioOut, cvIn, cvOut, frames - timeOffset, timeOffset);
+            processSingle(audioIn, audioOut, cvIn, cvOut, frames, 0);
 
         } // End of Event Input and Processing
 
@@ -3037,12 +3160,15 @@ public:
         // ------------------------------------------------------------------------------------------------------------
     }
 
-    bool processSingle(const float* const* const inBuffer, float** const outBuffer,
+    template <typename SampleType>
+    bool processSingle(const SampleType* const* const inBuffer, SampleType** const outBuffer,
                        const float* const* const cvIn, float** const cvOut,
                        const uint32_t frames, const uint32_t timeOffset)
     {
         CARLA_SAFE_ASSERT_RETURN(frames > 0, false);
 
+        SampleType** const audioOutBuffers = getAudioOutBuffers(static_cast<SampleType*>(nullptr));
+
         if (pData->audioIn.count > 0)
         {
             CARLA_SAFE_ASSERT_RETURN(inBuffer != nullptr, false);
@@ -3050,7 +3176,7 @@ public:
         if (pData->audioOut.count > 0)
         {
             CARLA_SAFE_ASSERT_RETURN(outBuffer != nullptr, false);
-            CARLA_SAFE_ASSERT_RETURN(fAudioAndCvOutBuffers != nullptr, false);
+            CARLA_SAFE_ASSERT_RETURN(audioOutBuffers != nullptr, false);
         }
 
         // ------------------------------------------------------------------------------------------------------------
@@ -3082,19 +3208,26 @@ public:
         // ------------------------------------------------------------------------------------------------------------
         // Set audio buffers
 
-        float* bufferAudioIn[96]; // std::max(1u, pData->audioIn.count + pData->cvIn.count)
-        float* bufferAudioOut[96]; // std::max(1u, pData->audioOut.count + pData->cvOut.count)
+        SampleType* bufferAudioIn[96]; // std::max(1u, pData->audioIn.count + pData->cvIn.count)
+        SampleType* bufferAudioOut[96]; // std::max(1u, pData->audioOut.count + pData->cvOut.count)
 
         for (uint32_t i=0; i < pData->audioIn.count; ++i)
-            bufferAudioIn[i] = const_cast<float*>(inBuffer[i]+timeOffset);
+            bufferAudioIn[i] = const_cast<SampleType*>(inBuffer[i]+timeOffset);
 
+        // plugins with CV ports always use 32-bit processing
         for (uint32_t i=0, j=pData->audioIn.count; i < pData->cvIn.count; ++i, ++j)
-            bufferAudioIn[j] = const_cast<float*>(cvIn[i]+timeOffset);
+            bufferAudioIn[j] = static_cast<SampleType*>(const_cast<void*>(static_cast<const void*>(cvIn[i]+timeOffset)));
 
-        for (uint32_t i=0; i < pData->audioOut.count + pData->cvOut.count; ++i)
+        for (uint32_t i=0; i < pData->audioOut.count; ++i)
         {
-            bufferAudioOut[i] = fAudioAndCvOutBuffers[i]+timeOffset;
-            carla_zeroFloats(bufferAudioOut[i], frames);
+            bufferAudioOut[i] = audioOutBuffers[i]+timeOffset;
+            carla_zeroStructs(bufferAudioOut[i], frames);
+        }
+
+        for (uint32_t i=pData->audioOut.count; i < pData->audioOut.count + pData->cvOut.count; ++i)
+        {
+            bufferAudioOut[i] = static_cast<SampleType*>(static_cast<void*>(fAudioAndCvOutBuffers[i]+timeOffset));
+            carla_zeroFloats(fAudioAndCvOutBuffers[i]+timeOffset, frames);
         }
 
         // ------------------------------------------------------------------------------------------------------------
@@ -3109,19 +3242,19 @@ public:
 
         for (int32_t b = 0, j = 0; b < fBuses.numInputs; ++b)
         {
-            fBuses.inputs[b].channel_buffers_32 = const_cast<float**>(bufferAudioIn + j);
+            setBusChannelBuffers(fBuses.inputs[b], bufferAudioIn + j);
             j += fBuses.inputs[b].num_channels;
         }
 
         for (int32_t b = 0, j = 0; b < fBuses.numOutputs; ++b)
         {
-            fBuses.outputs[b].channel_buffers_32 = bufferAudioOut + j;
+            setBusChannelBuffers(fBuses.outputs[b], bufferAudioOut + j);
             j += fBuses.outputs[b].num_channels;
         }
 
         v3_process_data processData = {
             pData->engine->isOffline() ? V3_OFFLINE : V3_REALTIME,
-            V3_SAMPLE_32,
+            getSymbolicSampleSize(),
             static_cast<int32_t>(frames),
             fBuses.numInputs,
             fBuses.numOutputs,
@@ -3253,8 +3386,8 @@ public:
             const bool isMono    = (pData->audioIn.count == 1);
 
             bool isPair;
-            float bufValue;
-            float* const oldBufLeft = pData->postProc.extraBuffer;
+            SampleType bufValue;
+            SampleType* const oldBufLeft = getPostProcExtraBuffer(static_cast<SampleType*>(nullptr));
 
             for (uint32_t i=0; i < pData->audioOut.count; ++i)
             {
@@ -3266,7 +3399,7 @@ public:
                     for (uint32_t k=0; k < frames; ++k)
                     {
                         bufValue = inBuffer[c][k+timeOffset];
-                        fAudioAndCvOutBuffers[i][k] = (fAudioAndCvOutBuffers[i][k] * pData->postProc.dryWet)
+                        audioOutBuffers[i][k] = (audioOutBuffers[i][k] * pData->postProc.dryWet)
                                                     + (bufValue * (1.0f - pData->postProc.dryWet));
                     }
                 }
@@ -3279,7 +3412,7 @@ public:
                     if (isPair)
                     {
                         CARLA_ASSERT(i+1 < pData->audioOut.count);
-                        carla_copyFloats(oldBufLeft, fAudioAndCvOutBuffers[i], frames);
+                        carla_copyStructs(oldBufLeft, audioOutBuffers[i], frames);
                     }
 
                     float balRangeL = (pData->postProc.balanceLeft  + 1.0f)/2.0f;
@@ -3290,14 +3423,14 @@ public:
                         if (isPair)
                         {
                             // left
-                            fAudioAndCvOutBuffers[i][k]  = oldBufLeft[k]                 * (1.0f - balRangeL);
-                            fAudioAndCvOutBuffers[i][k] += fAudioAndCvOutBuffers[i+1][k] * (1.0f - balRangeR);
+                            audioOutBuffers[i][k]  = oldBufLeft[k]            * (1.0f - balRangeL);
+                            audioOutBuffers[i][k] += audioOutBuffers[i+1][k] * (1.0f - balRangeR);
                         }
                         else
                         {
                             // right
-                            fAudioAndCvOutBuffers[i][k]  = fAudioAndCvOutBuffers[i][k] * balRangeR;
-                            fAudioAndCvOutBuffers[i][k] += oldBufLeft[k]               * balRangeL;
+                            audioOutBuffers[i][k]  = audioOutBuffers[i][k] * balRangeR;
+                            audioOutBuffers[i][k] += oldBufLeft[k]          * balRangeL;
                         }
                     }
                 }
@@ -3305,7 +3438,7 @@ public:
                 // Volume (and buffer copy)
                 {
                     for (uint32_t k=0; k < frames; ++k)
-                        outBuffer[i][k+timeOffset] = fAudioAndCvOutBuffers[i][k] * pData->postProc.volume;
+                        outBuffer[i][k+timeOffset] = audioOutBuffers[i][k] * pData->postProc.volume;
                 }
             }
 
@@ -3315,7 +3448,7 @@ public:
         } // End of Post-processing
 #else // BUILD_BRIDGE_ALTERNATIVE_ARCH
         for (uint32_t i=0; i < pData->audioOut.count; ++i)
-            carla_copyFloats(outBuffer[i] + timeOffset, fAudioAndCvOutBuffers[i] + timeOffset, frames);
+            carla_copyStructs(outBuffer[i] + timeOffset, audioOutBuffers[i] + timeOffset, frames);
 
         for (uint32_t i=0, j=pData->audioOut.count; i < pData->cvOut.count; ++i, ++j)
             carla_copyFloats(cvOut[i] + timeOffset, fAudioAndCvOutBuffers[j] + timeOffset, frames);
@@ -3327,6 +3460,67 @@ public:
         return true;
     }
 
+    // called when a block had more parameter points than the storage could hold
+    void growParameterPoints()
+    {
+        static const uint32_t kMaxAutomationPoints = 65536;
+
+        const uint32_t oldSize = fEvents.paramInputs->getAutomationPointCapacity();
+
+        if (oldSize >= kMaxAutomationPoints)
+        {
+            fEvents.paramInputs->needsMorePoints = false;
+            return;
+        }
+
+        const uint32_t newSize = std::min(kMaxAutomationPoints, std::max(oldSize * 2, 64U));
+        carla_debug("CarlaPluginVST3::growParameterPoints() - %u -> %u", oldSize, newSize);
+
+        carla_v3_input_param_changes::PointStorage storage(fEvents.paramInputs->paramCount + newSize);
+
+        // old storage is deleted after unlocking
+        const CarlaMutexLocker cml(pData->masterMutex);
+        fEvents.paramInputs->swapPointStorage(storage);
+    }
+
+    int32_t getSymbolicSampleSize() const noexcept
+    {
+        return fUse64BitSamples ? V3_SAMPLE_64 : V3_SAMPLE_32;
+    }
+
+    // buffers for processWithSampleType(), the argument only selects the sample type
+    float** getAudioOutBuffers(float*) const noexcept
+    {
+        return fAudioAndCvOutBuffers;
+    }
+
+    double** getAudioOutBuffers(double*) const noexcept
+    {
+        return fAudioOutBuffers64;
+    }
+
+#ifndef BUILD_BRIDGE_ALTERNATIVE_ARCH
+    float* getPostProcExtraBuffer(float*) const noexcept
+    {
+        return pData->postProc.extraBuffer;
+    }
+
+    double* getPostProcExtraBuffer(double*) const noexcept
+    {
+        return fExtraBuffer64;
+    }
+#endif
+
+    static void setBusChannelBuffers(v3_audio_bus_buffers& bus, float** const buffers) noexcept
+    {
+        bus.channel_buffers_32 = buffers;
+    }
+
+    static void setBusChannelBuffers(v3_audio_bus_buffers& bus, double** const buffers) noexcept
+    {
+        bus.channel_buffers_64 = buffers;
+    }
+
     void bufferSizeChanged(const uint32_t newBufferSize) override
     {
         CARLA_ASSERT_INT(newBufferSize > 0, newBufferSize);
@@ -3342,9 +3536,29 @@ public:
             fAudioAndCvOutBuffers[i] = new float[newBufferSize];
         }
 
+        if (fUse64BitSamples)
+        {
+            for (uint32_t i=0; i < pData->audioOut.count; ++i)
+            {
+                if (fAudioOutBuffers64[i] != nullptr)
+                    delete[] fAudioOutBuffers64[i];
+                fAudioOutBuffers64[i] = new double[newBufferSize];
+            }
+
+            delete[] fExtraBuffer64;
+            fExtraBuffer64 = new double[newBufferSize];
+        }
+
+        // start with room for one automation point per frame, grows later if needed
+        if (fEvents.paramInputs != nullptr && fEvents.paramInputs->getAutomationPointCapacity() < newBufferSize)
+        {
+            carla_v3_input_param_changes::PointStorage storage(fEvents.paramInputs->paramCount + newBufferSize);
+            fEvents.paramInputs->swapPointStorage(storage);
+        }
+
         v3_process_setup setup = {
             pData->engine->isOffline() ? V3_OFFLINE : V3_REALTIME,
-            V3_SAMPLE_32,
+            getSymbolicSampleSize(),
             static_cast<int32_t>(newBufferSize),
             pData->engine->getSampleRate()
         };
@@ -3366,7 +3580,7 @@ public:
 
         v3_process_setup setup = {
             pData->engine->isOffline() ? V3_OFFLINE : V3_REALTIME,
-            V3_SAMPLE_32,
+            getSymbolicSampleSize(),
             static_cast<int32_t>(pData->engine->getBufferSize()),
             newSampleRate
         };
@@ -3385,7 +3599,7 @@ public:
 
         v3_process_setup setup = {
             isOffline ? V3_OFFLINE : V3_REALTIME,
-            V3_SAMPLE_32,
+            getSymbolicSampleSize(),
             static_cast<int32_t>(pData->engine->getBufferSize()),
             pData->engine->getSampleRate()
         };
@@ -3417,6 +3631,29 @@ public:
             fAudioAndCvOutBuffers = nullptr;
         }
 
+        if (fAudioOutBuffers64 != nullptr)
+        {
+            for (uint32_t i=0; i < pData->audioOut.count; ++i)
+            {
+                if (fAudioOutBuffers64[i] != nullptr)
+                {
+                    delete[] fAudioOutBuffers64[i];
+                    fAudioOutBuffers64[i] = nullptr;
+                }
+            }
+
+            delete[] fAudioOutBuffers64;
+            fAudioOutBuffers64 = nullptr;
+        }
+
+        if (fExtraBuffer64 != nullptr)
+        {
+            delete[] fExtraBuffer64;
+            fExtraBuffer64 = nullptr;
+        }
+
+        fUse64BitSamples = false;
+
         CarlaPlugin::clearBuffers();
 
         carla_debug("CarlaPluginVST3::clearBuffers() - end");
@@ -3850,7 +4087,10 @@ private:
    #endif
     const bool kEngineHasIdleOnMainThread;
     bool fFirstActive; // first process() call after activate()
+    bool fUse64BitSamples;
     float** fAudioAndCvOutBuffers;
+    double** fAudioOutBuffers64;
+    double* fExtraBuffer64;
     uint32_t fLastKnownLatency;
     int32_t fRestartFlags;
     void* fLastChunk;
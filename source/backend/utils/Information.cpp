@@ -103,7 +103,7 @@ const char* const* carla_get_supported_file_extensions()
     // NOTE: please keep in sync with CarlaEngine::loadFile!!
     static const char* const extensions[] = {
         // Base types
-        "carxp", "carxs",
+        "carxp", "carxs", "carxb",
 
         // plugin files and resources
        #ifdef HAVE_FLUIDSYNTH
@@ -35,6 +35,8 @@ CarlaBridgeFormat::CarlaBridgeFormat() noexcept
 {
     carla_debug("CarlaBridgeFormat::CarlaBridgeFormat()");
 
+    setBinaryModeAllowed(true);
+
     try {
         fToolkit = CarlaBridgeToolkit::createNew(this);
     } CARLA_SAFE_EXCEPTION_RETURN("CarlaBridgeToolkit::createNew",);
@@ -14,7 +14,7 @@ from struct import pack
 from ctypes import (
     c_bool, c_char_p, c_double, c_float, c_int, c_long, c_longdouble, c_longlong, c_ubyte, c_uint, c_void_p,
     c_int8, c_int16, c_int32, c_int64, c_uint8, c_uint16, c_uint32, c_uint64,
-    cast, Structure,
+    byref, cast, Structure,
     CDLL, CFUNCTYPE, RTLD_GLOBAL, RTLD_LOCAL, POINTER
 )
 
@@ -263,6 +263,12 @@ PLUGIN_OPTION_SEND_PROGRAM_CHANGES = 0x200
 # We always want notes enabled by default, not the contrary.
 PLUGIN_OPTION_SKIP_SENDING_NOTES = 0x400
 
+# When forcing a mono effect as stereo, process both channels through the same plugin instance.
+# The plugin is run once per channel, so this is only meant for plugins without internal DSP state.
+# Not available for LV2 plugins with event inputs, as their events would be delivered twice.
+# @see PLUGIN_OPTION_FORCE_STEREO
+PLUGIN_OPTION_FORCE_STEREO_SHARED = 0x800
+
 # Special flag to indicate that plugin options are not yet set.
 # This flag exists because 0x0 as an option value is a valid one, so we need something else to indicate "null-ness".
 PLUGIN_OPTIONS_NULL = 0x10000
@@ -1040,6 +1046,40 @@ ENGINE_OPTION_CLIENT_NAME_PREFIX = 34
 # Treat loaded plugins as standalone (that is, there is no host UI to manage them)
 ENGINE_OPTION_PLUGINS_ARE_STANDALONE = 35
 
+# Number of frames of each SFZ sample to keep in memory, with the rest streamed from disk during playback.
+# Default is 0, which loads samples entirely into memory.
+ENGINE_OPTION_SFZ_STREAMING_PRELOAD = 36
+
+# Interval in seconds between autosaves of the current project, 0 to disable.
+# Only plugins that changed since the previous autosave are written, into a journal next to the project.
+ENGINE_OPTION_AUTOSAVE_INTERVAL = 37
+
+# Minimum size in frames of the sub-blocks used for sample accurate events, 1 for full accuracy.
+# Events that would split the audio block of a plugin are quantized to this granularity.
+# Does not apply to plugins with fixed buffers, nor to formats with timestamped parameter changes (VST3 and CLAP).
+# Default is 32.
+ENGINE_OPTION_MIN_SUB_BLOCK_SIZE = 38
+
+# Use 64-bit double-precision audio buffers between plugins.
+# Plugins that support it (VST3 and CLAP) process doubles directly, others are converted at their edges.
+# Only applies to rack mode, the patchbay graph always uses 32-bit buffers.
+# Cannot be changed while the engine is running.
+# Default is false.
+ENGINE_OPTION_DOUBLE_PRECISION = 39
+
+# Audio file written by the "Offline" driver, as 32-bit float WAV.
+# Rendering starts when the transport is played and runs as fast as possible, the transport stops once done.
+# The "Offline" driver only supports rack mode, see ENGINE_PROCESS_MODE_CONTINUOUS_RACK.
+ENGINE_OPTION_OFFLINE_RENDER_FILE = 40
+
+# Optional Standard MIDI File used as MIDI input of the "Offline" driver.
+# Control changes in it are also applied to plugin parameters mapped to them.
+ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE = 41
+
+# Length of the "Offline" driver render in milliseconds.
+# Default is 0, which renders until the end of the MIDI file.
+ENGINE_OPTION_OFFLINE_RENDER_LENGTH = 42
+
 # ---------------------------------------------------------------------------------------------------------------------
 # Engine Process Mode
 # Engine process mode.
@@ -1354,6 +1394,52 @@ class CarlaPortCountInfo(Structure):
         ("outs", c_uint32)
     ]
 
+# Plugin DSP load statistics, over the last second of processed audio.
+# Loads are a percentage of the audio block duration.
+# @see carla_get_plugin_process_time_info()
+class CarlaPluginProcessTimeInfo(Structure):
+    _fields_ = [
+        # Average load.
+        ("meanLoad", c_float),
+
+        # Load that 99% of the processed blocks stay under.
+        ("p99Load", c_float),
+
+        # Highest load.
+        ("maxLoad", c_float),
+
+        # Number of processed blocks these values are based on.
+        ("blockCount", c_uint32)
+    ]
+
+# Statistics about parameter changes received over OSC, since the engine started.
+# @see carla_get_osc_parameter_stats()
+class CarlaOscParameterStats(Structure):
+    _fields_ = [
+        # Number of changes applied in the audio thread.
+        ("applied", c_uint32),
+
+        # Number of changes dropped, because their plugin or parameter no longer exists or stayed busy for too long.
+        ("dropped", c_uint32),
+
+        # Time between receiving the last applied change and applying it, in microseconds.
+        ("lastLatency", c_uint32),
+
+        # Highest time between receiving a change and applying it, in microseconds.
+        ("maxLatency", c_uint32)
+    ]
+
+# Usage of the sample data shared by all SFZ plugins in this process.
+# @see carla_get_sfzero_sample_store_info()
+class CarlaSFZeroSampleStoreInfo(Structure):
+    _fields_ = [
+        # Number of samples currently kept in memory.
+        ("sampleCount", c_uint32),
+
+        # Memory used by those samples, in bytes.
+        ("memoryUsage", c_uint64)
+    ]
+
 # Parameter information.
 # @see carla_get_parameter_info()
 class CarlaParameterInfo(Structure):
@@ -1482,6 +1568,28 @@ PyCarlaPortCountInfo = {
     'outs': 0
 }
 
+# @see CarlaPluginProcessTimeInfo
+PyCarlaPluginProcessTimeInfo = {
+    'meanLoad': 0.0,
+    'p99Load': 0.0,
+    'maxLoad': 0.0,
+    'blockCount': 0
+}
+
+# @see CarlaOscParameterStats
+PyCarlaOscParameterStats = {
+    'applied': 0,
+    'dropped': 0,
+    'lastLatency': 0,
+    'maxLatency': 0
+}
+
+# @see CarlaSFZeroSampleStoreInfo
+PyCarlaSFZeroSampleStoreInfo = {
+    'sampleCount': 0,
+    'memoryUsage': 0
+}
+
 # @see CarlaParameterInfo
 PyCarlaParameterInfo = {
     'name': "",
@@ -2039,6 +2147,20 @@ class CarlaHostMeta():
     def get_current_parameter_value(self, pluginId, parameterId):
         raise NotImplementedError
 
+    # Get all of a plugin's current parameter values at once.
+    # @param pluginId Plugin
+    @abstractmethod
+    def get_parameter_values(self, pluginId):
+        raise NotImplementedError
+
+    # Get a plugin's parameter values that changed since a previous call.
+    # Returns a tuple of the new sequence number and a list of (index, value) pairs.
+    # @param pluginId Plugin
+    # @param sequence Sequence number returned by the previous call, 0 to get all values
+    @abstractmethod
+    def get_parameter_value_changes(self, pluginId, sequence):
+        raise NotImplementedError
+
     # Get a plugin's internal parameter value.
     # @param pluginId    Plugin
     # @param parameterId Parameter index, maybe be negative
@@ -2047,6 +2169,12 @@ class CarlaHostMeta():
     def get_internal_parameter_value(self, pluginId, parameterId):
         raise NotImplementedError
 
+    # Get the peak values of all plugins at once.
+    # Returns a list with 4 values per plugin (input left, input right, output left, output right).
+    @abstractmethod
+    def get_all_peak_values(self):
+        raise NotImplementedError
+
     # Get a plugin's input peak value.
     # @param pluginId Plugin
     # @param isLeft   Wherever to get the left/mono value, otherwise right.
@@ -2061,6 +2189,13 @@ class CarlaHostMeta():
     def get_output_peak_value(self, pluginId, isLeft):
         raise NotImplementedError
 
+    # Get a plugin's DSP load statistics, as measured by the engine around each process call.
+    # Values are zero if the plugin did not process any audio during the last second.
+    # @param pluginId Plugin
+    @abstractmethod
+    def get_plugin_process_time_info(self, pluginId):
+        raise NotImplementedError
+
     # Render a plugin's inline display.
     # @param pluginId Plugin
     @abstractmethod
@@ -2260,6 +2395,19 @@ class CarlaHostMeta():
     def get_host_osc_url_udp(self):
         raise NotImplementedError
 
+    # Get statistics about parameter changes received over OSC.
+    # Values are zero if OSC is not available.
+    @abstractmethod
+    def get_osc_parameter_stats(self):
+        raise NotImplementedError
+
+    # Get the usage of the sample data shared by all SFZ plugins.
+    # Samples are shared by the whole process, not only this engine.
+    # Values are zero if SFZ support is not available.
+    @abstractmethod
+    def get_sfzero_sample_store_info(self):
+        raise NotImplementedError
+
     # Initialize NSM (that is, announce ourselves to it).
     # Must be called as early as possible in the program's lifecycle.
     # Returns true if NSM is available and initialized correctly.
@@ -2502,15 +2650,27 @@ class CarlaHostNull(CarlaHostMeta):
     def get_current_parameter_value(self, pluginId, parameterId):
         return 0.0
 
+    def get_parameter_values(self, pluginId):
+        return []
+
+    def get_parameter_value_changes(self, pluginId, sequence):
+        return (sequence, [])
+
     def get_internal_parameter_value(self, pluginId, parameterId):
         return 0.0
 
+    def get_all_peak_values(self):
+        return []
+
     def get_input_peak_value(self, pluginId, isLeft):
         return 0.0
 
     def get_output_peak_value(self, pluginId, isLeft):
         return 0.0
 
+    def get_plugin_process_time_info(self, pluginId):
+        return PyCarlaPluginProcessTimeInfo
+
     def render_inline_display(self, pluginId, width, height):
         return None
 
@@ -2595,6 +2755,12 @@ class CarlaHostNull(CarlaHostMeta):
     def get_host_osc_url_udp(self):
         return ""
 
+    def get_osc_parameter_stats(self):
+        return PyCarlaOscParameterStats
+
+    def get_sfzero_sample_store_info(self):
+        return PyCarlaSFZeroSampleStoreInfo
+
     def nsm_init(self, pid, executableName):
         return False
 
@@ -2824,15 +2990,28 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_get_current_parameter_value.argtypes = (c_void_p, c_uint, c_uint32)
         self.lib.carla_get_current_parameter_value.restype = c_float
 
+        self.lib.carla_get_parameter_values.argtypes = (c_void_p, c_uint, POINTER(c_float), c_uint32)
+        self.lib.carla_get_parameter_values.restype = c_uint32
+
+        self.lib.carla_get_parameter_value_changes.argtypes = (c_void_p, c_uint, POINTER(c_uint64),
+                                                               POINTER(c_uint32), POINTER(c_float), c_uint32)
+        self.lib.carla_get_parameter_value_changes.restype = c_uint32
+
         self.lib.carla_get_internal_parameter_value.argtypes = (c_void_p, c_uint, c_int32)
         self.lib.carla_get_internal_parameter_value.restype = c_float
 
+        self.lib.carla_get_all_peak_values.argtypes = (c_void_p, POINTER(c_float), c_uint)
+        self.lib.carla_get_all_peak_values.restype = c_uint
+
         self.lib.carla_get_input_peak_value.argtypes = (c_void_p, c_uint, c_bool)
         self.lib.carla_get_input_peak_value.restype = c_float
 
         self.lib.carla_get_output_peak_value.argtypes = (c_void_p, c_uint, c_bool)
         self.lib.carla_get_output_peak_value.restype = c_float
 
+        self.lib.carla_get_plugin_process_time_info.argtypes = (c_void_p, c_uint)
+        self.lib.carla_get_plugin_process_time_info.restype = POINTER(CarlaPluginProcessTimeInfo)
+
         self.lib.carla_render_inline_display.argtypes = (c_void_p, c_uint, c_uint, c_uint)
         self.lib.carla_render_inline_display.restype = POINTER(CarlaInlineDisplayImageSurface)
 
@@ -2917,6 +3096,12 @@ class CarlaHostDLL(CarlaHostMeta):
         self.lib.carla_get_host_osc_url_udp.argtypes = (c_void_p,)
         self.lib.carla_get_host_osc_url_udp.restype = c_char_p
 
+        self.lib.carla_get_osc_parameter_stats.argtypes = (c_void_p,)
+        self.lib.carla_get_osc_parameter_stats.restype = POINTER(CarlaOscParameterStats)
+
+        self.lib.carla_get_sfzero_sample_store_info.argtypes = (c_void_p,)
+        self.lib.carla_get_sfzero_sample_store_info.restype = POINTER(CarlaSFZeroSampleStoreInfo)
+
         self.lib.carla_nsm_init.argtypes = (c_void_p, c_uint64, c_char_p)
         self.lib.carla_nsm_init.restype = c_bool
 
@@ -3153,15 +3338,39 @@ class CarlaHostDLL(CarlaHostMeta):
     def get_current_parameter_value(self, pluginId, parameterId):
         return float(self.lib.carla_get_current_parameter_value(self.handle, pluginId, parameterId))
 
+    def get_parameter_values(self, pluginId):
+        count  = self.get_parameter_count(pluginId)
+        values = (c_float * count)()
+        count  = int(self.lib.carla_get_parameter_values(self.handle, pluginId, values, count))
+        return list(values[:count])
+
+    def get_parameter_value_changes(self, pluginId, sequence):
+        count   = self.get_parameter_count(pluginId)
+        indexes = (c_uint32 * count)()
+        values  = (c_float * count)()
+        cseq    = c_uint64(sequence)
+        count   = int(self.lib.carla_get_parameter_value_changes(self.handle, pluginId, byref(cseq),
+                                                                 indexes, values, count))
+        return (int(cseq.value), list(zip(indexes[:count], values[:count])))
+
     def get_internal_parameter_value(self, pluginId, parameterId):
         return float(self.lib.carla_get_internal_parameter_value(self.handle, pluginId, parameterId))
 
+    def get_all_peak_values(self):
+        count = self.get_current_plugin_count()
+        peaks = (c_float * (count * 4))()
+        count = int(self.lib.carla_get_all_peak_values(self.handle, peaks, count))
+        return list(peaks[:count * 4])
+
     def get_input_peak_value(self, pluginId, isLeft):
         return float(self.lib.carla_get_input_peak_value(self.handle, pluginId, isLeft))
 
     def get_output_peak_value(self, pluginId, isLeft):
         return float(self.lib.carla_get_output_peak_value(self.handle, pluginId, isLeft))
 
+    def get_plugin_process_time_info(self, pluginId):
+        return structToDict(self.lib.carla_get_plugin_process_time_info(self.handle, pluginId).contents)
+
     def render_inline_display(self, pluginId, width, height):
         ptr = self.lib.carla_render_inline_display(self.handle, pluginId, width, height)
         if not ptr or not ptr.contents:
@@ -3262,6 +3471,12 @@ class CarlaHostDLL(CarlaHostMeta):
     def get_host_osc_url_udp(self):
         return charPtrToString(self.lib.carla_get_host_osc_url_udp(self.handle))
 
+    def get_osc_parameter_stats(self):
+        return structToDict(self.lib.carla_get_osc_parameter_stats(self.handle).contents)
+
+    def get_sfzero_sample_store_info(self):
+        return structToDict(self.lib.carla_get_sfzero_sample_store_info(self.handle).contents)
+
     def nsm_init(self, pid, executableName):
         return bool(self.lib.carla_nsm_init(self.handle, pid, executableName.encode("utf-8")))
 
@@ -3296,6 +3511,7 @@ class PluginStoreInfo():
         self.customDataCount = 0
         self.customData      = []
         self.peaks = [0.0, 0.0, 0.0, 0.0]
+        self.processTimeInfo = PyCarlaPluginProcessTimeInfo.copy()
 
 # ---------------------------------------------------------------------------------------------------------------------
 # Carla Host object for plugins (using pipes)
@@ -3315,6 +3531,7 @@ class CarlaHostPlugin(CarlaHostMeta):
         # plugin info
         self.fPluginsInfo = {}
         self.fFallbackPluginInfo = PluginStoreInfo()
+        self.fPluginCount = 0
 
         # runtime engine info
         self.fRuntimeEngineInfo = {
@@ -3561,6 +3778,14 @@ class CarlaHostPlugin(CarlaHostMeta):
     def get_current_parameter_value(self, pluginId, parameterId):
         return self.fPluginsInfo[pluginId].parameterValues[parameterId]
 
+    def get_parameter_values(self, pluginId):
+        return list(self.fPluginsInfo[pluginId].parameterValues)
+
+    def get_parameter_value_changes(self, pluginId, sequence):
+        # values are pushed by the engine, so there is no change tracking here
+        values = self.fPluginsInfo[pluginId].parameterValues
+        return (sequence + 1, list(enumerate(values)))
+
     def get_internal_parameter_value(self, pluginId, parameterId):
         if parameterId == PARAMETER_NULL or parameterId <= PARAMETER_MAX:
             return 0.0
@@ -3569,12 +3794,22 @@ class CarlaHostPlugin(CarlaHostMeta):
 
         return self.fPluginsInfo[pluginId].parameterValues[parameterId]
 
+    def get_all_peak_values(self):
+        # fPluginsInfo is allocated for the maximum number of plugins, only report the loaded ones
+        peaks = []
+        for pluginId in range(self.fPluginCount):
+            peaks += self.fPluginsInfo.get(pluginId, self.fFallbackPluginInfo).peaks
+        return peaks
+
     def get_input_peak_value(self, pluginId, isLeft):
         return self.fPluginsInfo[pluginId].peaks[0 if isLeft else 1]
 
     def get_output_peak_value(self, pluginId, isLeft):
         return self.fPluginsInfo[pluginId].peaks[2 if isLeft else 3]
 
+    def get_plugin_process_time_info(self, pluginId):
+        return self.fPluginsInfo[pluginId].processTimeInfo
+
     def render_inline_display(self, pluginId, width, height):
         return None
 
@@ -3681,6 +3916,12 @@ class CarlaHostPlugin(CarlaHostMeta):
     def get_host_osc_url_udp(self):
         return self.fOscUDP
 
+    def get_osc_parameter_stats(self):
+        return PyCarlaOscParameterStats
+
+    def get_sfzero_sample_store_info(self):
+        return PyCarlaSFZeroSampleStoreInfo
+
     # --------------------------------------------------------------------------------------------------------
 
     def _set_runtime_info(self, load, xruns):
@@ -3703,6 +3944,7 @@ class CarlaHostPlugin(CarlaHostMeta):
         self.fPluginsInfo[pluginId] = PluginStoreInfo()
 
     def _reset(self, maxPluginId):
+        self.fPluginCount = 0
         self.fPluginsInfo = {}
         for i in range(maxPluginId):
             self.fPluginsInfo[i] = PluginStoreInfo()
@@ -3955,6 +4197,16 @@ class CarlaHostPlugin(CarlaHostMeta):
         if pluginInfo is not None:
             pluginInfo.peaks = [in1, in2, out1, out2]
 
+    def _set_processTimeInfo(self, pluginId, meanLoad, p99Load, maxLoad, blockCount):
+        pluginInfo = self.fPluginsInfo.get(pluginId, None)
+        if pluginInfo is not None:
+            pluginInfo.processTimeInfo = {
+                'meanLoad': meanLoad,
+                'p99Load': p99Load,
+                'maxLoad': maxLoad,
+                'blockCount': blockCount
+            }
+
     def _removePlugin(self, pluginId):
         pluginCountM1 = len(self.fPluginsInfo)-1
 
@@ -3991,8 +4243,12 @@ class CarlaHostPlugin(CarlaHostMeta):
         elif action == ENGINE_CALLBACK_SAMPLE_RATE_CHANGED:
             self.fSampleRate = valuef
 
+        elif action == ENGINE_CALLBACK_PLUGIN_ADDED:
+            self.fPluginCount = max(self.fPluginCount, pluginId + 1)
+
         elif action == ENGINE_CALLBACK_PLUGIN_REMOVED:
             self._removePlugin(pluginId)
+            self.fPluginCount = max(self.fPluginCount - 1, 0)
 
         elif action == ENGINE_CALLBACK_PLUGIN_RENAMED:
             self._set_pluginName(pluginId, valueStr)
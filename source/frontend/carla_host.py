@@ -910,7 +910,7 @@ class HostWindow(QMainWindow):
 
     @pyqtSlot()
     def slot_fileOpen(self):
-        fileFilter = self.tr("Carla Project File (*.carxp);;Carla Preset File (*.carxs)")
+        fileFilter = self.tr("Carla Project File (*.carxp *.carxb);;Carla Preset File (*.carxs)")
         filename, ok = QFileDialog.getOpenFileName(self, self.tr("Open Carla Project File"), self.fSavedSettings[CARLA_KEY_MAIN_PROJECT_FOLDER], filter=fileFilter)
 
         # FIXME use ok value, test if it works as expected
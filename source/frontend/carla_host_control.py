@@ -157,6 +157,7 @@ class CarlaHostOSC(CarlaHostQtPlugin):
 
         if method in ("clear_engine_xruns",
                       "cancel_engine_action",
+                      "set_update_rates",
                       #"load_file",
                       #"load_project",
                       #"save_project",
@@ -266,6 +267,11 @@ class CarlaHostOSC(CarlaHostQtPlugin):
     def set_engine_about_to_close(self):
         return
 
+    # Set how often meters (peaks and runtime info) and output parameter values are sent to us, in Hz.
+    # Updates are coalesced into bundles, 0 disables them.
+    def set_update_rates(self, meterRate, parameterRate):
+        return self.sendMsg(["set_update_rates", meterRate, parameterRate])
+
 # ---------------------------------------------------------------------------------------------------------------------
 # OSC Control server
 
@@ -507,6 +513,12 @@ class CarlaControlServerUDP(Server):
         pluginId, in1, in2, out1, out2 = args
         self.host._set_peaks(pluginId, in1, in2, out1, out2)
 
+    @make_method('/ctrl/ptime', 'ifffi')
+    def carla_ptime(self, path, args):
+        self.fReceivedMsgs = True
+        pluginId, meanLoad, p99Load, maxLoad, blockCount = args
+        self.host._set_processTimeInfo(pluginId, meanLoad, p99Load, maxLoad, blockCount)
+
     @make_method(None, None)
     def fallback(self, path, args):
         print("ControlServerUDP::fallback(\"%s\") - unknown message, args =" % path, args)
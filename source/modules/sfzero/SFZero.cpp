@@ -7,6 +7,8 @@
 #include "sfzero/SFZReader.cpp" 
 #include "sfzero/SFZRegion.cpp" 
 #include "sfzero/SFZSample.cpp" 
+#include "sfzero/SFZSampleStore.cpp"
 #include "sfzero/SFZSound.cpp"
+#include "sfzero/SFZStreamer.cpp"
 #include "sfzero/SFZSynth.cpp"
 #include "sfzero/SFZVoice.cpp"
@@ -20,7 +20,9 @@ END_JUCE_MODULE_DECLARATION
 #include "sfzero/SFZReader.h"
 #include "sfzero/SFZRegion.h"
 #include "sfzero/SFZSample.h"
+#include "sfzero/SFZSampleStore.h"
 #include "sfzero/SFZSound.h"
+#include "sfzero/SFZStreamer.h"
 #include "sfzero/SFZSynth.h"
 #include "sfzero/SFZVoice.h"
 
@@ -57,6 +57,17 @@ bool Sample::load()
 #else
     const water::String filename(file_.getFullPathName());
 
+    // reuse audio already decoded for another sound, or another region path resolving to the same file
+    const water::File target(file_.getLinkedTarget());
+    const water::String canonicalPath(target.getFullPathName());
+    const water::int64 modificationTime = target.getLastModificationTime();
+
+    if (SampleData* const data = store_->acquire(canonicalPath, modificationTime, preloadFrames_))
+    {
+        setData(data);
+        return true;
+    }
+
     struct adinfo info;
     carla_zeroStruct(info);
 
@@ -70,12 +81,25 @@ bool Sample::load()
         return false;
     }
 
-    sampleRate_ = info.sample_rate;
-    sampleLength_ = info.frames/info.channels;
+    ScopedPointer<SampleData> newData(new SampleData(canonicalPath, modificationTime, preloadFrames_));
+    newData->sampleRate = info.sample_rate;
+    newData->sampleLength = info.frames/info.channels;
     // TODO loopStart_, loopEnd_
 
+    // Fix for misinformation using libsndfile
+    if (info.frames % info.channels)
+        --info.frames;
+
+    // when streaming, only read the beginning of the sample, the rest is read from disk during playback
+    int64_t samplesToRead = info.frames;
+
+    if (preloadFrames_ != 0 && preloadFrames_ < newData->sampleLength)
+        samplesToRead = static_cast<int64_t>(preloadFrames_ * info.channels);
+
+    newData->preloadLength = static_cast<water::uint64>(samplesToRead / info.channels);
+
     // read interleaved buffer
-    float* const rbuffer = (float*)std::calloc(1, sizeof(float)*info.frames);
+    float* const rbuffer = (float*)std::calloc(1, sizeof(float)*samplesToRead);
 
     if (rbuffer == nullptr)
     {
@@ -84,46 +108,68 @@ bool Sample::load()
         return false;
     }
 
-    // Fix for misinformation using libsndfile
-    if (info.frames % info.channels)
-        --info.frames;
-
-    const ssize_t r = ad_read(handle, rbuffer, info.frames);
-    if (r != info.frames)
+    const ssize_t r = ad_read(handle, rbuffer, samplesToRead);
+    if (r != samplesToRead)
     {
         if (r != 0)
-            carla_stderr2("sfzero::Sample::load() - failed to read complete file: " P_SSIZE " vs " P_INT64, r, info.frames);
+            carla_stderr2("sfzero::Sample::load() - failed to read complete file: " P_SSIZE " vs " P_INT64, r, samplesToRead);
         ad_close(handle);
+        std::free(rbuffer);
         return false;
     }
 
     // NOTE: We add some extra samples, which will be filled with zeros,
     // so interpolation can be done without having to check for the edge all the time.
 
-    buffer_ = new water::AudioSampleBuffer(info.channels, sampleLength_ + 4, true);
+    newData->buffer = new water::AudioSampleBuffer(info.channels, newData->preloadLength + 4, true);
 
     for (int i=info.channels; --i >= 0;)
-        buffer_->copyFromInterleavedSource(i, rbuffer, r);
+        newData->buffer->copyFromInterleavedSource(i, rbuffer, r);
 
     std::free(rbuffer);
     ad_close(handle);
+
+    setData(store_->publish(newData.release()));
 #endif
 
     return true;
 }
 
-Sample::~Sample() { }
+Sample::~Sample() { releaseData(); }
+
+void Sample::setData(SampleData *data)
+{
+  releaseData();
+  CARLA_SAFE_ASSERT_RETURN(data != nullptr,);
+
+  data_ = data;
+  sampleRate_ = data->sampleRate;
+  sampleLength_ = data->sampleLength;
+  preloadLength_ = data->preloadLength;
+}
+
+void Sample::releaseData()
+{
+  if (data_ == nullptr)
+    return;
+
+  store_->release(data_);
+  data_ = nullptr;
+}
 
 water::String Sample::getShortName() { return (file_.getFileName()); }
 
 void Sample::setBuffer(water::AudioSampleBuffer *newBuffer)
 {
+  releaseData();
   buffer_ = newBuffer;
-  sampleLength_ = buffer_->getNumSamples();
+  sampleLength_ = preloadLength_ = buffer_->getNumSamples();
 }
 
 water::AudioSampleBuffer *Sample::detachBuffer()
 {
+  // shared data belongs to the store
+  CARLA_SAFE_ASSERT_RETURN(data_ == nullptr, nullptr);
   return buffer_.release();
 }
 
@@ -132,6 +178,7 @@ water::String Sample::dump() { return file_.getFullPathName() + "\n"; }
 #ifdef DEBUG
 void Sample::checkIfZeroed(const char *where)
 {
+  water::AudioSampleBuffer *const buffer_ = getBuffer();
   if (buffer_ == nullptr)
   {
     dbgprintf("SFZSample::checkIfZeroed(%s): no buffer!", where);
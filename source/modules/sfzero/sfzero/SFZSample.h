@@ -8,10 +8,12 @@
 #define SFZSAMPLE_H_INCLUDED
 
 #include "SFZCommon.h"
+#include "SFZSampleStore.h"
 
 #include "extra/ScopedPointer.hpp"
 #include "water/buffers/AudioSampleBuffer.h"
 #include "water/files/File.h"
+#include "water/memory/SharedResourcePointer.h"
 
 namespace sfzero
 {
@@ -19,19 +21,24 @@ namespace sfzero
 class Sample
 {
 public:
-  explicit Sample(const water::File &fileIn) : file_(fileIn), buffer_(nullptr), sampleRate_(0), sampleLength_(0), loopStart_(0), loopEnd_(0) {}
+  explicit Sample(const water::File &fileIn) : file_(fileIn), buffer_(nullptr), data_(nullptr), sampleRate_(0), sampleLength_(0), preloadLength_(0), preloadFrames_(0), loopStart_(0), loopEnd_(0) {}
   virtual ~Sample();
 
+  // Set how many frames load() should read into memory, 0 means the entire sample.
+  // When less than the full sample is preloaded, voices stream the rest from disk during playback.
+  void setPreloadFrames(water::uint64 frames) { preloadFrames_ = frames; }
   bool load();
 
   water::File getFile() { return (file_); }
-  water::AudioSampleBuffer *getBuffer() { return (buffer_); }
+  water::AudioSampleBuffer *getBuffer() { return (data_ != nullptr ? data_->buffer.get() : buffer_.get()); }
   double getSampleRate() { return (sampleRate_); }
   water::String getShortName();
   void setBuffer(water::AudioSampleBuffer *newBuffer);
   water::AudioSampleBuffer *detachBuffer();
   water::String dump();
   water::uint64 getSampleLength() const { return sampleLength_; }
+  water::uint64 getPreloadLength() const { return preloadLength_; }
+  bool isStreamed() const { return preloadLength_ < sampleLength_; }
   water::uint64 getLoopStart() const { return loopStart_; }
   water::uint64 getLoopEnd() const { return loopEnd_; }
 
@@ -40,10 +47,16 @@ public:
 #endif
 
 private:
+  void setData(SampleData *data);
+  void releaseData();
+
   water::File file_;
   ScopedPointer<water::AudioSampleBuffer> buffer_;
+  // decoded audio shared with other samples using the same file, used instead of buffer_ when set
+  SampleData *data_;
+  water::SharedResourcePointer<SampleStore> store_;
   double sampleRate_;
-  water::uint64 sampleLength_, loopStart_, loopEnd_;
+  water::uint64 sampleLength_, preloadLength_, preloadFrames_, loopStart_, loopEnd_;
 
   CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Sample)
 };
@@ -0,0 +1,116 @@
+/*************************************************************************************
+ * Original code copyright (C) 2012 Steve Folta
+ * Converted to Juce module (C) 2016 Leo Olivers
+ * Forked from https://github.com/stevefolta/SFZero
+ * For license info please see the LICENSE file distributed with this source code
+ *************************************************************************************/
+
+#include "SFZSampleStore.h"
+
+#include <algorithm>
+
+namespace sfzero
+{
+
+SampleData::SampleData(const water::String &pathIn, water::int64 modificationTimeIn, water::uint64 preloadFramesIn)
+    : path(pathIn), modificationTime(modificationTimeIn), preloadFrames(preloadFramesIn), buffer(nullptr),
+      sampleRate(0), sampleLength(0), preloadLength(0), refCount(1)
+{
+}
+
+bool SampleData::matches(const water::String &pathIn, water::int64 modificationTimeIn,
+                         water::uint64 preloadFramesIn) const
+{
+  if (modificationTime != modificationTimeIn || path != pathIn)
+    return false;
+
+  // data loaded entirely can be used for any request
+  return preloadLength == sampleLength || preloadFrames == preloadFramesIn;
+}
+
+size_t SampleData::getMemoryUsage() const
+{
+  if (buffer == nullptr)
+    return 0;
+
+  return sizeof(float) * static_cast<size_t>(buffer->getNumChannels()) * static_cast<size_t>(buffer->getNumSamples());
+}
+
+SampleStore::SampleStore() : memoryUsage_(0) {}
+
+SampleStore::~SampleStore()
+{
+  CARLA_SAFE_ASSERT_UINT(entries_.empty(), static_cast<uint>(entries_.size()));
+}
+
+SampleData *SampleStore::acquire(const water::String &path, water::int64 modificationTime, water::uint64 preloadFrames)
+{
+  const CarlaMutexLocker cml(mutex_);
+
+  for (SampleData *const entry : entries_)
+  {
+    if (entry->matches(path, modificationTime, preloadFrames))
+    {
+      ++entry->refCount;
+      return entry;
+    }
+  }
+
+  return nullptr;
+}
+
+SampleData *SampleStore::publish(SampleData *newData)
+{
+  CARLA_SAFE_ASSERT_RETURN(newData != nullptr, nullptr);
+
+  {
+    const CarlaMutexLocker cml(mutex_);
+
+    for (SampleData *const entry : entries_)
+    {
+      if (entry->matches(newData->path, newData->modificationTime, newData->preloadFrames))
+      {
+        ++entry->refCount;
+        delete newData;
+        return entry;
+      }
+    }
+
+    entries_.push_back(newData);
+    memoryUsage_ += newData->getMemoryUsage();
+  }
+
+  return newData;
+}
+
+void SampleStore::release(SampleData *data)
+{
+  CARLA_SAFE_ASSERT_RETURN(data != nullptr,);
+
+  {
+    const CarlaMutexLocker cml(mutex_);
+    CARLA_SAFE_ASSERT_RETURN(data->refCount != 0,);
+
+    if (--data->refCount != 0)
+      return;
+
+    entries_.erase(std::remove(entries_.begin(), entries_.end(), data), entries_.end());
+    memoryUsage_ -= data->getMemoryUsage();
+  }
+
+  delete data;
+}
+
+size_t SampleStore::getMemoryUsage() const
+{
+  const CarlaMutexLocker cml(mutex_);
+  return memoryUsage_;
+}
+
+size_t SampleStore::getNumSamples() const
+{
+  const CarlaMutexLocker cml(mutex_);
+  return entries_.size();
+}
+
+}
@@ -0,0 +1,72 @@
+/*************************************************************************************
+ * Original code copyright (C) 2012 Steve Folta
+ * Converted to Juce module (C) 2016 Leo Olivers
+ * Forked from https://github.com/stevefolta/SFZero
+ * For license info please see the LICENSE file distributed with this source code
+ *************************************************************************************/
+#ifndef SFZSAMPLESTORE_H_INCLUDED
+#define SFZSAMPLESTORE_H_INCLUDED
+
+#include "SFZCommon.h"
+
+#include "CarlaMutex.hpp"
+#include "extra/ScopedPointer.hpp"
+#include "water/buffers/AudioSampleBuffer.h"
+
+#include <vector>
+
+namespace sfzero
+{
+
+// Decoded audio of a sample file, shared by all samples loaded from the same file.
+struct SampleData
+{
+  SampleData(const water::String &pathIn, water::int64 modificationTimeIn, water::uint64 preloadFramesIn);
+
+  // whether this data can be used for a sample file requesting the given preload
+  bool matches(const water::String &pathIn, water::int64 modificationTimeIn, water::uint64 preloadFramesIn) const;
+  size_t getMemoryUsage() const;
+
+  const water::String path;
+  const water::int64 modificationTime;
+  const water::uint64 preloadFrames;
+
+  ScopedPointer<water::AudioSampleBuffer> buffer;
+  double sampleRate;
+  water::uint64 sampleLength, preloadLength;
+  water::uint32 refCount;
+
+  CARLA_DECLARE_NON_COPYABLE(SampleData)
+};
+
+// Global, reference-counted store of decoded sample data, keyed by canonical path and modification time.
+// Used through water::SharedResourcePointer, so that all SFZ instances share the same memory.
+class SampleStore
+{
+public:
+  SampleStore();
+  ~SampleStore();
+
+  // get existing data, increasing its reference count, or null if none matches
+  SampleData *acquire(const water::String &path, water::int64 modificationTime, water::uint64 preloadFrames);
+
+  // make newly decoded data available to other samples, taking ownership of it.
+  // if the same file was published meanwhile, that data is used instead and the new one gets deleted.
+  SampleData *publish(SampleData *newData);
+
+  void release(SampleData *data);
+
+  // total size of all decoded audio currently in memory, in bytes
+  size_t getMemoryUsage() const;
+  size_t getNumSamples() const;
+
+private:
+  CarlaMutex mutex_;
+  std::vector<SampleData *> entries_;
+  size_t memoryUsage_;
+
+  CARLA_DECLARE_NON_COPYABLE(SampleStore)
+};
+}
+
+#endif // SFZSAMPLESTORE_H_INCLUDED
@@ -9,13 +9,73 @@
 #include "SFZReader.h"
 #include "SFZRegion.h"
 #include "SFZSample.h"
+#include "SFZStreamer.h"
+
+#ifndef CARLA_OS_WASM
+# include "CarlaThread.hpp"
+#endif
+
+#include <map>
 
 namespace sfzero
 {
 
+#ifndef CARLA_OS_WASM
+// Decodes samples in parallel, each thread picking the next sample to load until all are done.
+class SampleLoaderThread : public CarlaThread
+{
+public:
+  SampleLoaderThread(Sample *const *samples, bool *results, int numSamples, int *nextIndex, int *numDone)
+      : CarlaThread("SFZSampleLoader"), samples_(samples), results_(results), numSamples_(numSamples),
+        nextIndex_(nextIndex), numDone_(numDone)
+  {
+  }
+
+protected:
+  void run() override
+  {
+    for (int i; (i = __atomic_fetch_add(nextIndex_, 1, __ATOMIC_SEQ_CST)) < numSamples_;)
+    {
+      results_[i] = samples_[i]->load();
+      __atomic_add_fetch(numDone_, 1, __ATOMIC_RELEASE);
+    }
+  }
+
+private:
+  Sample *const *const samples_;
+  bool *const results_;
+  const int numSamples_;
+  int *const nextIndex_;
+  int *const numDone_;
+
+  CARLA_DECLARE_NON_COPYABLE(SampleLoaderThread)
+};
+
+static int getNumSampleLoaderThreads()
+{
+#ifdef CARLA_OS_WIN
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const int numCPUs = static_cast<int>(info.dwNumberOfProcessors);
+#else
+  const int numCPUs = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+  return water::jlimit(1, 16, numCPUs);
+}
+#endif
+
 Sound::Sound(const water::File &fileIn) : file_(fileIn) {}
 Sound::~Sound()
 {
+#ifndef CARLA_OS_WASM
+  // voices stop their streams before releasing the sound, but the streamer thread might still be opening one
+  if (hasStreamedSamples())
+  {
+    const water::SharedResourcePointer<Streamer> streamer;
+    streamer->waitForPendingReads();
+  }
+#endif
+
   int numRegions = regions_.size();
 
   for (int i = 0; i < numRegions; ++i)
@@ -82,22 +142,106 @@ void Sound::loadRegions()
   reader.read(file_);
 }
 
-void Sound::loadSamples(const LoadingIdleCallback& cb)
+void Sound::loadSamples(const LoadingIdleCallback& cb, water::uint64 preloadFrames)
 {
+    water::Array<Sample *> samples;
+
     for (water::HashMap<water::String, Sample *>::Iterator i(samples_); i.next();)
+        samples.add(i.getValue());
+
+    if (preloadFrames != 0)
     {
-        Sample* const sample = i.getValue();
+        // looping regions jump back into the middle of the sample, these need it entirely in memory
+        std::map<Sample *, water::uint64> preloads;
 
-        if (sample->load())
+        for (int i = 0; i < regions_.size(); ++i)
         {
-            carla_debug("Loaded sample '%s'", sample->getShortName().toRawUTF8());
-            cb.callback(cb.callbackPtr);
+            Region *const region = regions_[i];
+
+            if (region->sample == nullptr)
+                continue;
+
+            water::uint64 &preload(preloads[region->sample]);
+
+            if (region->loop_mode == Region::loop_continuous || region->loop_mode == Region::loop_sustain)
+                preload = std::numeric_limits<water::uint64>::max();
+            else if (preload != std::numeric_limits<water::uint64>::max())
+                preload = std::max(preload, static_cast<water::uint64>(std::max<water::int64>(0, region->offset)) + preloadFrames);
         }
-        else
+
+        for (std::map<Sample *, water::uint64>::iterator it = preloads.begin(); it != preloads.end(); ++it)
         {
-            addError("Couldn't load sample \"" + sample->getShortName() + "\"");
+            if (it->second != std::numeric_limits<water::uint64>::max())
+                it->first->setPreloadFrames(it->second);
+        }
+    }
+
+    const int numSamples = samples.size();
+    water::HeapBlock<bool> results;
+    CARLA_SAFE_ASSERT_RETURN(numSamples == 0 || results.calloc(static_cast<size_t>(numSamples)),);
+
+#ifndef CARLA_OS_WASM
+    const int numThreads = std::min(getNumSampleLoaderThreads(), numSamples);
+
+    if (numThreads > 1)
+    {
+        int nextIndex = 0, numDone = 0;
+        water::OwnedArray<SampleLoaderThread> threads;
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            SampleLoaderThread *const thread = threads.add(new SampleLoaderThread(samples.getRawDataPointer(), results,
+                                                                                   numSamples, &nextIndex, &numDone));
+            thread->startThread();
         }
+
+        // keep the host responsive while waiting, the callback must be called from this thread
+        for (int reported = 0; reported < numSamples;)
+        {
+            const int done = __atomic_load_n(&numDone, __ATOMIC_ACQUIRE);
+
+            for (; reported < done; ++reported)
+                cb.callback(cb.callbackPtr);
+
+            if (reported < numSamples)
+                d_msleep(5);
+        }
+
+        for (int i = 0; i < numThreads; ++i)
+            threads[i]->stopThread(-1);
     }
+    else
+#endif
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            results[i] = samples[i]->load();
+
+            if (results[i])
+                cb.callback(cb.callbackPtr);
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        Sample *const sample = samples[i];
+
+        if (results[i])
+            carla_debug("Loaded sample '%s'", sample->getShortName().toRawUTF8());
+        else
+            addError("Couldn't load sample \"" + sample->getShortName() + "\"");
+    }
+}
+
+bool Sound::hasStreamedSamples()
+{
+  for (water::HashMap<water::String, Sample *>::Iterator i(samples_); i.next();)
+  {
+    if (i.getValue()->isStreamed())
+      return true;
+  }
+
+  return false;
 }
 
 Region *Sound::getRegionFor(int note, int velocity, Region::Trigger trigger)
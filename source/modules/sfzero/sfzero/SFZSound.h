@@ -40,7 +40,9 @@ public:
   void addUnsupportedOpcode(const water::String &opcode);
 
   virtual void loadRegions();
-  virtual void loadSamples(const LoadingIdleCallback& cb);
+  // preloadFrames enables disk streaming, only preloading that many frames past each region offset
+  virtual void loadSamples(const LoadingIdleCallback& cb, water::uint64 preloadFrames = 0);
+  bool hasStreamedSamples();
 
   Region *getRegionFor(int note, int velocity, Region::Trigger trigger = Region::attack);
   int getNumRegions();
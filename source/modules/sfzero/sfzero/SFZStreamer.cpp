@@ -0,0 +1,302 @@
+/*************************************************************************************
+ * Original code copyright (C) 2012 Steve Folta
+ * Converted to Juce module (C) 2016 Leo Olivers
+ * Forked from https://github.com/stevefolta/SFZero
+ * For license info please see the LICENSE file distributed with this source code
+ *************************************************************************************/
+
+#include "SFZStreamer.h"
+#include "SFZSample.h"
+
+extern "C" {
+#include "audio_decoder/ad.h"
+}
+
+#include <algorithm>
+
+namespace sfzero
+{
+
+// Frames read from disk at once, per stream.
+static const water::int64 kStreamReadChunkFrames = 4096;
+
+#ifndef CARLA_OS_WASM
+// How often the streamer thread checks all streams when not woken up by a voice.
+static const uint kStreamerPollIntervalMs = 10;
+#endif
+
+StreamBuffer::StreamBuffer()
+    : capacity_(0), sample_(nullptr), generation_(0), readPos_(0), readyGeneration_(0), writePos_(0),
+      fileHandle_(nullptr), fileChannels_(0), fileEnd_(0), owner_(nullptr)
+{
+  data_[0] = data_[1] = nullptr;
+}
+
+StreamBuffer::~StreamBuffer()
+{
+#ifndef CARLA_OS_WASM
+  if (owner_ != nullptr)
+    owner_->removeStream(this);
+#endif
+
+  closeFile();
+  delete[] data_[0];
+  delete[] data_[1];
+}
+
+void StreamBuffer::allocate(water::uint32 capacity)
+{
+  CARLA_SAFE_ASSERT_RETURN(capacity_ == 0 && capacity != 0,);
+
+  data_[0] = new float[capacity];
+  data_[1] = new float[capacity];
+  carla_zeroFloats(data_[0], capacity);
+  carla_zeroFloats(data_[1], capacity);
+  capacity_ = capacity;
+}
+
+void StreamBuffer::start(Sample *sample) noexcept
+{
+  __atomic_store_n(&sample_, sample, __ATOMIC_RELEASE);
+  __atomic_store_n(&readPos_, static_cast<water::int64>(sample->getPreloadLength()), __ATOMIC_RELEASE);
+  __atomic_add_fetch(&generation_, 1, __ATOMIC_RELEASE);
+
+#ifndef CARLA_OS_WASM
+  if (owner_ != nullptr)
+    owner_->requestRead();
+#endif
+}
+
+void StreamBuffer::stop() noexcept
+{
+  if (__atomic_load_n(&sample_, __ATOMIC_ACQUIRE) == nullptr)
+    return;
+
+  __atomic_store_n(&sample_, static_cast<Sample *>(nullptr), __ATOMIC_RELEASE);
+  __atomic_add_fetch(&generation_, 1, __ATOMIC_RELEASE);
+
+#ifndef CARLA_OS_WASM
+  if (owner_ != nullptr)
+    owner_->requestRead();
+#endif
+}
+
+bool StreamBuffer::getFrame(water::int64 frame, float &left, float &right) const noexcept
+{
+  // data from a previous note is never valid, even if the positions match
+  if (__atomic_load_n(&readyGeneration_, __ATOMIC_ACQUIRE) != generation_)
+    return false;
+  if (frame < readPos_ || frame >= __atomic_load_n(&writePos_, __ATOMIC_ACQUIRE))
+    return false;
+
+  const water::uint32 index = static_cast<water::uint32>(frame % capacity_);
+  left = data_[0][index];
+  right = data_[1][index];
+  return true;
+}
+
+void StreamBuffer::setReadPosition(water::int64 frame) noexcept
+{
+  if (frame <= readPos_)
+    return;
+
+  __atomic_store_n(&readPos_, frame, __ATOMIC_RELEASE);
+
+#ifndef CARLA_OS_WASM
+  // wake up the streamer once half of the buffer has been consumed
+  if (owner_ != nullptr && __atomic_load_n(&writePos_, __ATOMIC_ACQUIRE) - frame < capacity_ / 2)
+    owner_->requestRead();
+#endif
+}
+
+water::int64 StreamBuffer::getReadableFrames() const noexcept
+{
+  // new notes come first, they have nothing buffered yet
+  if (__atomic_load_n(&generation_, __ATOMIC_ACQUIRE) != readyGeneration_)
+    return -1;
+  if (fileHandle_ == nullptr)
+    return std::numeric_limits<water::int64>::max();
+
+  return writePos_ - __atomic_load_n(&readPos_, __ATOMIC_ACQUIRE);
+}
+
+void StreamBuffer::process(std::vector<float> &tmpBuffer)
+{
+  const water::uint32 generation = __atomic_load_n(&generation_, __ATOMIC_ACQUIRE);
+
+  if (generation != readyGeneration_)
+  {
+    closeFile();
+
+    if (Sample *const sample = __atomic_load_n(&sample_, __ATOMIC_ACQUIRE))
+    {
+      const water::String filename(sample->getFile().getFullPathName());
+      const water::int64 preloadLength = static_cast<water::int64>(sample->getPreloadLength());
+
+      struct adinfo info;
+      carla_zeroStruct(info);
+
+      if (void *const handle = ad_open(filename.toRawUTF8(), &info))
+      {
+        // decoders return the new position on success, -1 on failure
+        if (info.channels > 0 && ad_seek(handle, preloadLength) >= 0)
+        {
+          fileHandle_ = handle;
+          fileChannels_ = static_cast<water::uint32>(info.channels);
+          fileEnd_ = static_cast<water::int64>(sample->getSampleLength());
+        }
+        else
+        {
+          carla_stderr2("sfzero::StreamBuffer::process() - failed to seek in '%s'", filename.toRawUTF8());
+          ad_close(handle);
+        }
+      }
+      else
+      {
+        carla_stderr2("sfzero::StreamBuffer::process() - failed to open '%s'", filename.toRawUTF8());
+      }
+
+      __atomic_store_n(&writePos_, preloadLength, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&readyGeneration_, generation, __ATOMIC_RELEASE);
+  }
+
+  while (fileHandle_ != nullptr && __atomic_load_n(&generation_, __ATOMIC_ACQUIRE) == generation)
+  {
+    const water::int64 writePos = writePos_;
+    const water::int64 buffered = writePos - __atomic_load_n(&readPos_, __ATOMIC_ACQUIRE);
+    const water::int64 frames = std::min(std::min(static_cast<water::int64>(capacity_) - buffered, fileEnd_ - writePos),
+                                         kStreamReadChunkFrames);
+
+    if (frames <= 0)
+    {
+      if (writePos >= fileEnd_)
+        closeFile();
+      break;
+    }
+
+    const water::uint32 channels = fileChannels_;
+    tmpBuffer.resize(static_cast<size_t>(frames * channels));
+
+    const ssize_t r = ad_read(fileHandle_, tmpBuffer.data(), static_cast<size_t>(frames * channels));
+
+    if (r <= 0)
+    {
+      closeFile();
+      break;
+    }
+
+    const water::int64 framesRead = r / channels;
+    const float *const tmp = tmpBuffer.data();
+
+    for (water::int64 i = 0; i < framesRead; ++i)
+    {
+      const water::uint32 index = static_cast<water::uint32>((writePos + i) % capacity_);
+      data_[0][index] = tmp[i * channels];
+      data_[1][index] = tmp[i * channels + (channels > 1 ? 1 : 0)];
+    }
+
+    __atomic_store_n(&writePos_, writePos + framesRead, __ATOMIC_RELEASE);
+  }
+}
+
+void StreamBuffer::closeFile()
+{
+  if (fileHandle_ == nullptr)
+    return;
+
+  ad_close(fileHandle_);
+  fileHandle_ = nullptr;
+}
+
+#ifndef CARLA_OS_WASM
+Streamer::Streamer() : CarlaThread("SFZStreamer"), wakeupPending_(0)
+{
+  carla_zeroStruct(sem_);
+  carla_sem_create2(sem_, false);
+}
+
+Streamer::~Streamer()
+{
+  CARLA_SAFE_ASSERT(streams_.empty());
+
+  stopThread(-1);
+  carla_sem_destroy2(sem_);
+}
+
+void Streamer::addStream(StreamBuffer *stream)
+{
+  CARLA_SAFE_ASSERT_RETURN(stream != nullptr && stream->isAllocated(),);
+  CARLA_SAFE_ASSERT_RETURN(stream->owner_ == nullptr,);
+
+  {
+    const CarlaMutexLocker cml(streamsMutex_);
+    streams_.push_back(stream);
+    stream->owner_ = this;
+  }
+
+  if (!isThreadRunning())
+    startThread();
+}
+
+void Streamer::removeStream(StreamBuffer *stream)
+{
+  CARLA_SAFE_ASSERT_RETURN(stream != nullptr && stream->owner_ == this,);
+
+  bool lastStream;
+
+  {
+    const CarlaMutexLocker cml(streamsMutex_);
+    streams_.erase(std::remove(streams_.begin(), streams_.end(), stream), streams_.end());
+    stream->owner_ = nullptr;
+    stream->closeFile();
+    lastStream = streams_.empty();
+  }
+
+  if (lastStream)
+  {
+    signalThreadShouldExit();
+    requestRead();
+    stopThread(-1);
+  }
+}
+
+void Streamer::requestRead() noexcept
+{
+  if (__sync_bool_compare_and_swap(&wakeupPending_, 0, 1))
+    carla_sem_post(sem_);
+}
+
+void Streamer::waitForPendingReads()
+{
+  // streams are only processed while holding the mutex, so once we get it no old sample can be in use
+  const CarlaMutexLocker cml(streamsMutex_);
+}
+
+void Streamer::run()
+{
+  while (!shouldThreadExit())
+  {
+    if (carla_sem_timedwait(sem_, kStreamerPollIntervalMs))
+      __atomic_store_n(&wakeupPending_, 0, __ATOMIC_SEQ_CST);
+
+    const CarlaMutexLocker cml(streamsMutex_);
+
+    // serve the streams closest to running out first
+    pending_.clear();
+    for (StreamBuffer *stream : streams_)
+      pending_.push_back(std::make_pair(stream->getReadableFrames(), stream));
+    std::sort(pending_.begin(), pending_.end());
+
+    for (const std::pair<water::int64, StreamBuffer *> &pending : pending_)
+    {
+      if (shouldThreadExit())
+        break;
+      pending.second->process(tmpBuffer_);
+    }
+  }
+}
+#endif
+
+}
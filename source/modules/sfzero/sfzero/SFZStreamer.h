@@ -0,0 +1,107 @@
+/*************************************************************************************
+ * Original code copyright (C) 2012 Steve Folta
+ * Converted to Juce module (C) 2016 Leo Olivers
+ * Forked from https://github.com/stevefolta/SFZero
+ * For license info please see the LICENSE file distributed with this source code
+ *************************************************************************************/
+#ifndef SFZSTREAMER_H_INCLUDED
+#define SFZSTREAMER_H_INCLUDED
+
+#include "SFZCommon.h"
+
+#ifndef CARLA_OS_WASM
+# include "CarlaSemUtils.hpp"
+# include "CarlaThread.hpp"
+#endif
+
+#include <utility>
+#include <vector>
+
+namespace sfzero
+{
+
+class Sample;
+class Streamer;
+
+// Per-voice ring buffer for disk streaming, used for samples that are only partially preloaded.
+// The voice (audio thread) starts and stops the stream and consumes frames in order,
+// while the streamer thread reads the rest of the sample from disk into it.
+class StreamBuffer
+{
+public:
+  StreamBuffer();
+  ~StreamBuffer();
+
+  bool isAllocated() const noexcept { return capacity_ != 0; }
+  void allocate(water::uint32 capacity);
+
+  // audio thread side
+  void start(Sample *sample) noexcept;
+  void stop() noexcept;
+  bool getFrame(water::int64 frame, float &left, float &right) const noexcept;
+  void setReadPosition(water::int64 frame) noexcept;
+
+  // streamer thread side, returns number of frames that are ready to be played
+  water::int64 getReadableFrames() const noexcept;
+  void process(std::vector<float> &tmpBuffer);
+  void closeFile();
+
+private:
+  float *data_[2];
+  water::uint32 capacity_;
+
+  // written by the audio thread, only dereferenced by the streamer thread while holding the streams mutex
+  Sample *sample_;
+  volatile water::uint32 generation_;
+  volatile water::int64 readPos_;
+
+  // written by the streamer thread
+  volatile water::uint32 readyGeneration_;
+  volatile water::int64 writePos_;
+  void *fileHandle_;
+  water::uint32 fileChannels_;
+  water::int64 fileEnd_;
+
+  friend class Streamer;
+  Streamer *owner_;
+
+  CARLA_DECLARE_NON_COPYABLE(StreamBuffer)
+};
+
+#ifndef CARLA_OS_WASM
+// Disk streaming thread shared by all SFZ synths, started on demand while streams are registered.
+class Streamer : private CarlaThread
+{
+public:
+  Streamer();
+  ~Streamer() override;
+
+  void addStream(StreamBuffer *stream);
+  void removeStream(StreamBuffer *stream);
+
+  // to be called from the audio thread, wakes up the streamer thread as soon as possible
+  void requestRead() noexcept;
+
+  // wait until the streamer thread is done with any sample it might still be opening,
+  // must be called after stopping all streams of a sample and before deleting it
+  void waitForPendingReads();
+
+protected:
+  void run() override;
+
+private:
+  carla_sem_t sem_;
+  int wakeupPending_;
+
+  CarlaMutex streamsMutex_;
+  std::vector<StreamBuffer *> streams_;
+  std::vector<std::pair<water::int64, StreamBuffer *> > pending_;
+  std::vector<float> tmpBuffer_;
+
+  CARLA_DECLARE_NON_COPYABLE(Streamer)
+};
+#endif
+
+}
+
+#endif // SFZSTREAMER_H_INCLUDED
@@ -12,11 +12,36 @@
 namespace sfzero
 {
 
+// Per-voice disk streaming buffer size, in frames.
+static const water::uint32 kStreamBufferFrames = 16384;
+
 Synth::Synth() : Synthesiser()
 {
     carla_zeroStructs(noteVelocities_, 128);
 }
 
+Synth::~Synth()
+{
+  // voice streams must be unregistered while the streamer is still referenced
+  clearVoices();
+}
+
+void Synth::setupStreaming()
+{
+#ifndef CARLA_OS_WASM
+  for (int i = 0, numVoices = static_cast<int>(getNumVoices()); i < numVoices; ++i)
+  {
+    Voice *const voice = dynamic_cast<Voice *>(getVoice(i));
+
+    if (voice == nullptr || voice->getStream().isAllocated())
+      continue;
+
+    voice->getStream().allocate(kStreamBufferFrames);
+    streamer_->addStream(&voice->getStream());
+  }
+#endif
+}
+
 void Synth::noteOn(int midiChannel, int midiNoteNumber, float velocity)
 {
   int i;
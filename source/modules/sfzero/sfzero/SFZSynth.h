@@ -9,7 +9,9 @@
 #define SFZSYNTH_H_INCLUDED
 
 #include "SFZCommon.h"
+#include "SFZStreamer.h"
 
+#include "water/memory/SharedResourcePointer.h"
 #include "water/synthesisers/Synthesiser.h"
 
 namespace sfzero
@@ -19,7 +21,7 @@ class Synth : public water::Synthesiser
 {
 public:
   Synth();
-  virtual ~Synth() {}
+  virtual ~Synth();
 
   void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
   void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
@@ -27,8 +29,15 @@ public:
   int numVoicesUsed();
   water::String voiceInfoString();
 
+  // Allocate voice stream buffers and register them for disk streaming,
+  // needed once any sample of the loaded sounds is only partially preloaded.
+  void setupStreaming();
+
 private:
   int noteVelocities_[128];
+#ifndef CARLA_OS_WASM
+  water::SharedResourcePointer<Streamer> streamer_;
+#endif
   CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Synth)
 };
 }
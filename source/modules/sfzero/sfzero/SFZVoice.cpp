@@ -22,7 +22,7 @@ static const float globalGain = -1.0;
 
 Voice::Voice()
     : region_(nullptr), curMidiNote_(0), curPitchWheel_(0), pitchRatio_(0), noteGainLeft_(0), noteGainRight_(0),
-      sourceSamplePosition_(0), sampleEnd_(0), loopStart_(0), loopEnd_(0), numLoops_(0), curVelocity_(0)
+      sourceSamplePosition_(0), sampleEnd_(0), loopStart_(0), loopEnd_(0), streaming_(false), numLoops_(0), curVelocity_(0)
 {
   ampeg_.setExponentialDecay(true);
 }
@@ -89,6 +89,22 @@ void Voice::startNote(int midiNoteNumber, float floatVelocity, water::Synthesise
     sampleEnd_ = region_->end + 1;
   }
 
+  // Streaming, for samples only partially in memory.
+  stream_.stop();
+  streaming_ = false;
+  if (region_->sample->isStreamed())
+  {
+    if (stream_.isAllocated())
+    {
+      stream_.start(region_->sample);
+      streaming_ = true;
+    }
+    else if (sampleEnd_ > static_cast<water::int64>(region_->sample->getPreloadLength()))
+    {
+      sampleEnd_ = region_->sample->getPreloadLength();
+    }
+  }
+
   // Loop.
   loopStart_ = loopEnd_ = 0;
   Region::LoopMode loopMode = region_->loop_mode;
@@ -179,6 +195,10 @@ void Voice::renderNextBlock(water::AudioSampleBuffer &outputBuffer, int startSam
 
   int bufferNumSamples = buffer->getNumSamples(); // leoo
 
+  // Frames past the preloaded part of the sample come from the disk stream.
+  const bool streaming = streaming_;
+  const int preloadLength = static_cast<int>(region_->sample->getPreloadLength());
+
   // Cache some values, to give them at least some chance of ending up in
   // registers.
   double sourceSamplePosition = this->sourceSamplePosition_;
@@ -193,7 +213,7 @@ void Voice::renderNextBlock(water::AudioSampleBuffer &outputBuffer, int startSam
   while (--numSamples >= 0)
   {
     const int pos = static_cast<int>(sourceSamplePosition);
-    CARLA_SAFE_ASSERT_CONTINUE(pos >= 0 && pos < bufferNumSamples); // leoo
+    CARLA_SAFE_ASSERT_CONTINUE(pos >= 0 && (streaming || pos < bufferNumSamples)); // leoo
 
     float alpha = static_cast<float>(sourceSamplePosition - pos);
     float invAlpha = 1.0f - alpha;
@@ -203,11 +223,36 @@ void Voice::renderNextBlock(water::AudioSampleBuffer &outputBuffer, int startSam
       nextPos = static_cast<int>(loopStart);
     }
 
-    // Simple linear interpolation with buffer overrun check
-    float nextL = nextPos < bufferNumSamples ? inL[nextPos] : inL[pos];
-    float nextR = inR ? (nextPos < bufferNumSamples ? inR[nextPos] : inR[pos]) : nextL;
-    float l = (inL[pos] * invAlpha + nextL * alpha);
-    float r = inR ? (inR[pos] * invAlpha + nextR * alpha) : l;
+    float l, r;
+    if (streaming && nextPos >= preloadLength)
+    {
+      // Stream underruns are played as silence.
+      float curL, curR, nextL, nextR;
+      if (pos < preloadLength)
+      {
+        curL = inL[pos];
+        curR = inR ? inR[pos] : curL;
+      }
+      else if (!stream_.getFrame(pos, curL, curR))
+      {
+        curL = curR = 0.0f;
+      }
+      if (!stream_.getFrame(nextPos, nextL, nextR))
+      {
+        nextL = curL;
+        nextR = curR;
+      }
+      l = (curL * invAlpha + nextL * alpha);
+      r = inR ? (curR * invAlpha + nextR * alpha) : l;
+    }
+    else
+    {
+      // Simple linear interpolation with buffer overrun check
+      float nextL = nextPos < bufferNumSamples ? inL[nextPos] : inL[pos];
+      float nextR = inR ? (nextPos < bufferNumSamples ? inR[nextPos] : inR[pos]) : nextL;
+      l = (inL[pos] * invAlpha + nextL * alpha);
+      r = inR ? (inR[pos] * invAlpha + nextR * alpha) : l;
+    }
 
     //// Simple linear interpolation, old version (possible buffer overrun with non-loop??)
     // float l = (inL[pos] * invAlpha + inL[nextPos] * alpha);
@@ -264,6 +309,10 @@ void Voice::renderNextBlock(water::AudioSampleBuffer &outputBuffer, int startSam
   }
 
   this->sourceSamplePosition_ = sourceSamplePosition;
+  if (streaming && region_ != nullptr)
+  {
+    stream_.setReadPosition(static_cast<water::int64>(sourceSamplePosition));
+  }
   ampeg_.setLevel(ampegGain);
   ampeg_.setSamplesUntilNextSegment(samplesUntilNextAmpSegment);
 }
@@ -324,6 +373,11 @@ void Voice::calcPitchRatio()
 
 void Voice::killNote()
 {
+  if (streaming_)
+  {
+    stream_.stop();
+    streaming_ = false;
+  }
   region_ = nullptr;
   clearCurrentNote();
 }
@@ -9,6 +9,7 @@
 #define SFZVOICE_H_INCLUDED
 
 #include "SFZEG.h"
+#include "SFZStreamer.h"
 
 #include "water/synthesisers/Synthesiser.h"
 
@@ -42,6 +43,9 @@ public:
 
   water::String infoString();
 
+  // Ring buffer for playing samples that are not entirely preloaded, allocated by the synth when needed.
+  StreamBuffer &getStream() { return stream_; }
+
 private:
   Region *region_;
   int curMidiNote_, curPitchWheel_;
@@ -51,6 +55,8 @@ private:
   EG ampeg_;
   water::int64 sampleEnd_;
   water::int64 loopStart_, loopEnd_;
+  StreamBuffer stream_;
+  bool streaming_;
 
   // Info only.
   int numLoops_;
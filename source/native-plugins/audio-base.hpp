@@ -22,6 +22,24 @@
 #include "CarlaMemUtils.hpp"
 #include "CarlaRingBuffer.hpp"
 
+#ifndef CARLA_OS_WASM
+# include "CarlaSemUtils.hpp"
+# include "CarlaThread.hpp"
+#endif
+
+#include "water/memory/SharedResourcePointer.h"
+
+#if !defined(CARLA_OS_WASM) && !defined(CARLA_OS_WIN)
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <vector>
+
 extern "C" {
 #include "audio_decoder/ad.h"
 }
@@ -39,6 +57,8 @@ extern "C" {
 
 typedef struct adinfo ADInfo;
 
+using water::SharedResourcePointer;
+
 // --------------------------------------------------------------------------------------------------------------------
 // tuning
 
@@ -51,6 +71,9 @@ static constexpr const uint16_t kMinLengthSeconds = 30;
 // size of the audio file ring buffer
 static constexpr const uint16_t kRingBufferLengthSeconds = 6;
 
+// how often the disk streaming thread checks for read-ahead when not explicitly woken up
+static constexpr const uint16_t kStreamerPollIntervalMs = 50;
+
 static inline
 constexpr float max4f(const float a, const float b, const float c, const float d) noexcept
 {
@@ -112,6 +135,413 @@ struct AudioMemoryPool {
     CARLA_DECLARE_NON_COPYABLE(AudioMemoryPool)
 };
 
+// --------------------------------------------------------------------------------------------------------------------
+// Memory-mapped reader for plain PCM wave files, used as fast path instead of the regular audio decoder.
+// File pages are shared with every other reader of the same file, and are read on-demand by the kernel.
+
+class AudioFileMapping
+{
+public:
+    AudioFileMapping() noexcept {}
+
+    ~AudioFileMapping() noexcept
+    {
+        close();
+    }
+
+    bool isOpen() const noexcept
+    {
+        return fSamples != nullptr;
+    }
+
+    bool open(const char* const filename, ADInfo& nfo) noexcept
+    {
+        close();
+
+       #if defined(CARLA_OS_WASM) || defined(CARLA_OS_WIN)
+        return false;
+        // unused
+        (void)filename;
+        (void)nfo;
+       #else
+        const int fd = ::open(filename, O_RDONLY);
+
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < 44)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* const ptr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (ptr == MAP_FAILED)
+            return false;
+
+        fMapping = ptr;
+        fMappingSize = static_cast<size_t>(st.st_size);
+
+        if (! parseWaveHeader())
+        {
+            close();
+            return false;
+        }
+
+        ::posix_madvise(fMapping, fMappingSize, POSIX_MADV_SEQUENTIAL);
+
+        nfo.sample_rate = fSampleRate;
+        nfo.channels    = fChannels;
+        nfo.frames      = static_cast<int64_t>(fNumFrames);
+        nfo.length      = static_cast<int64_t>(fNumFrames * 1000 / fSampleRate);
+        nfo.bit_rate    = getBitRate();
+        nfo.bit_depth   = fBitDepth;
+        nfo.meta_data   = nullptr;
+        nfo.can_seek    = 1;
+        return true;
+       #endif
+    }
+
+    void close() noexcept
+    {
+       #if !defined(CARLA_OS_WASM) && !defined(CARLA_OS_WIN)
+        if (fMapping != nullptr)
+            ::munmap(fMapping, fMappingSize);
+       #endif
+
+        fMapping = nullptr;
+        fMappingSize = 0;
+        fSamples = nullptr;
+        fNumFrames = fPosition = 0;
+        fSampleRate = fChannels = 0;
+        fFormat = fBitDepth = 0;
+    }
+
+    int getBitRate() const noexcept
+    {
+        return static_cast<int>(fSampleRate * fChannels * fBitDepth);
+    }
+
+    // same semantics as ad_seek
+    int64_t seek(const int64_t pos) noexcept
+    {
+        fPosition = static_cast<uint64_t>(carla_fixedValue<int64_t>(0, static_cast<int64_t>(fNumFrames), pos));
+        return static_cast<int64_t>(fPosition);
+    }
+
+    // same semantics as ad_read, len and return value are in samples (frames * channels)
+    ssize_t read(float* const out, const size_t len) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(fSamples != nullptr, -1);
+
+        const uint64_t numFrames = std::min<uint64_t>(len / fChannels, fNumFrames - fPosition);
+        const size_t numSamples = static_cast<size_t>(numFrames * fChannels);
+        const uint bytesPerSample = fBitDepth / 8;
+        const uint8_t* data = fSamples + fPosition * fChannels * bytesPerSample;
+
+        switch (fBitDepth)
+        {
+        case 8:
+            for (size_t i=0; i < numSamples; ++i, ++data)
+                out[i] = static_cast<float>(static_cast<int>(data[0]) - 128) / 128.f;
+            break;
+        case 16:
+            for (size_t i=0; i < numSamples; ++i, data += 2)
+                out[i] = static_cast<float>(static_cast<int16_t>(data[0] | data[1] << 8)) / 32768.f;
+            break;
+        case 24:
+            for (size_t i=0; i < numSamples; ++i, data += 3)
+                out[i] = static_cast<float>(static_cast<int32_t>(static_cast<uint32_t>(data[0]) << 8
+                                                               | static_cast<uint32_t>(data[1]) << 16
+                                                               | static_cast<uint32_t>(data[2]) << 24))
+                       / 2147483648.f;
+            break;
+        case 32:
+            for (size_t i=0; i < numSamples; ++i, data += 4)
+            {
+                const uint32_t v = readLE32(data);
+
+                if (fFormat == kFormatFloat)
+                {
+                    float f;
+                    std::memcpy(&f, &v, sizeof(float));
+                    out[i] = f;
+                }
+                else
+                {
+                    out[i] = static_cast<float>(static_cast<int32_t>(v)) / 2147483648.f;
+                }
+            }
+            break;
+        case 64:
+            for (size_t i=0; i < numSamples; ++i, data += 8)
+            {
+                const uint64_t v = static_cast<uint64_t>(readLE32(data)) | static_cast<uint64_t>(readLE32(data + 4)) << 32;
+                double d;
+                std::memcpy(&d, &v, sizeof(double));
+                out[i] = static_cast<float>(d);
+            }
+            break;
+        }
+
+        fPosition += numFrames;
+        return static_cast<ssize_t>(numSamples);
+    }
+
+private:
+    static constexpr const uint16_t kFormatPCM = 0x0001;
+    static constexpr const uint16_t kFormatFloat = 0x0003;
+    static constexpr const uint16_t kFormatExtensible = 0xFFFE;
+
+    void* fMapping = nullptr;
+    size_t fMappingSize = 0;
+    const uint8_t* fSamples = nullptr;
+    uint64_t fNumFrames = 0;
+    uint64_t fPosition = 0;
+    uint fSampleRate = 0;
+    uint fChannels = 0;
+    uint16_t fFormat = 0;
+    uint16_t fBitDepth = 0;
+
+    static uint16_t readLE16(const uint8_t* const data) noexcept
+    {
+        return static_cast<uint16_t>(data[0] | data[1] << 8);
+    }
+
+    static uint32_t readLE32(const uint8_t* const data) noexcept
+    {
+        return static_cast<uint32_t>(data[0])
+             | static_cast<uint32_t>(data[1]) << 8
+             | static_cast<uint32_t>(data[2]) << 16
+             | static_cast<uint32_t>(data[3]) << 24;
+    }
+
+    bool parseWaveHeader() noexcept
+    {
+        const uint8_t* const data = static_cast<const uint8_t*>(fMapping);
+
+        if (std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+            return false;
+
+        const uint8_t* samples = nullptr;
+        uint64_t samplesSize = 0;
+
+        for (size_t pos = 12; pos + 8 <= fMappingSize;)
+        {
+            const uint8_t* const chunk = data + pos + 8;
+            const size_t chunkSize = readLE32(data + pos + 4);
+            const size_t available = fMappingSize - pos - 8;
+
+            if (std::memcmp(data + pos, "fmt ", 4) == 0)
+            {
+                if (chunkSize < 16 || chunkSize > available)
+                    return false;
+
+                fFormat     = readLE16(chunk);
+                fChannels   = readLE16(chunk + 2);
+                fSampleRate = readLE32(chunk + 4);
+                fBitDepth   = readLE16(chunk + 14);
+
+                // use the subformat GUID, its first 2 bytes match the regular format tags
+                if (fFormat == kFormatExtensible && chunkSize >= 26)
+                    fFormat = readLE16(chunk + 24);
+            }
+            else if (std::memcmp(data + pos, "data", 4) == 0)
+            {
+                samples = chunk;
+                samplesSize = std::min(chunkSize, available);
+                break;
+            }
+
+            pos += 8 + chunkSize + (chunkSize & 1);
+        }
+
+        if (samples == nullptr || fChannels == 0 || fSampleRate == 0)
+            return false;
+
+        switch (fFormat)
+        {
+        case kFormatPCM:
+            if (fBitDepth != 8 && fBitDepth != 16 && fBitDepth != 24 && fBitDepth != 32)
+                return false;
+            break;
+        case kFormatFloat:
+            if (fBitDepth != 32 && fBitDepth != 64)
+                return false;
+            break;
+        default:
+            return false;
+        }
+
+        fSamples = samples;
+        fNumFrames = samplesSize / (fChannels * fBitDepth / 8);
+        fPosition = 0;
+        return fNumFrames != 0;
+    }
+
+    CARLA_DECLARE_NON_COPYABLE(AudioFileMapping)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// Process-wide cache of decoded audio, shared by all readers using the same file, sample rate and channel mode.
+// What gets shared is the initial memory pool (the entire file, or its first few seconds when disk streaming).
+// Files are identified by their path, size and modification time, so edited files get decoded again.
+
+struct AudioFileStatus {
+    int64_t size;
+    int64_t modTime;
+
+    bool read(const char* const filename) noexcept
+    {
+       #ifdef CARLA_OS_WIN
+        struct _stat64 st;
+        if (::_stat64(filename, &st) != 0)
+       #else
+        struct stat st;
+        if (::stat(filename, &st) != 0)
+       #endif
+        {
+            size = modTime = 0;
+            return false;
+        }
+
+        size = static_cast<int64_t>(st.st_size);
+        modTime = static_cast<int64_t>(st.st_mtime);
+        return true;
+    }
+
+    bool operator==(const AudioFileStatus& other) const noexcept
+    {
+        return size == other.size && modTime == other.modTime;
+    }
+};
+
+struct AudioFileCacheEntry {
+    const String filename;
+    const AudioFileStatus fileStatus;
+    const uint32_t sampleRate;
+    const uint8_t quadMode;
+    const uint32_t previewDataSize;
+    float* const previewData;
+
+    ADInfo fileNfo;
+    AudioMemoryPool pool;
+    uint64_t totalResampledFrames = 0;
+    int bitRate = 0;
+    bool entireFileLoaded = false;
+    uint32_t refCount = 1;
+
+    AudioFileCacheEntry(const char* const filename_, const AudioFileStatus& fileStatus_,
+                        const uint32_t sampleRate_, const uint8_t quadMode_, const uint32_t previewDataSize_)
+        : filename(filename_),
+          fileStatus(fileStatus_),
+          sampleRate(sampleRate_),
+          quadMode(quadMode_),
+          previewDataSize(previewDataSize_),
+          previewData(new float[previewDataSize_])
+    {
+        ad_clear_nfo(&fileNfo);
+        carla_zeroFloats(previewData, previewDataSize);
+    }
+
+    ~AudioFileCacheEntry()
+    {
+        delete[] previewData;
+    }
+
+    bool matches(const char* const filename_, const AudioFileStatus& fileStatus_,
+                 const uint32_t sampleRate_, const uint8_t quadMode_, const uint32_t previewDataSize_) const noexcept
+    {
+        return sampleRate == sampleRate_ && quadMode == quadMode_ && previewDataSize == previewDataSize_
+            && fileStatus == fileStatus_ && filename == filename_;
+    }
+
+    CARLA_DECLARE_NON_COPYABLE(AudioFileCacheEntry)
+};
+
+class AudioFileCache
+{
+public:
+    AudioFileCache()
+        : fMutex(),
+          fEntries() {}
+
+    ~AudioFileCache()
+    {
+        CARLA_SAFE_ASSERT_UINT(fEntries.empty(), static_cast<uint>(fEntries.size()));
+    }
+
+    // get an existing entry, increasing its reference count, or null if none matches
+    AudioFileCacheEntry* acquire(const char* const filename, const AudioFileStatus& fileStatus,
+                                 const uint32_t sampleRate, const uint8_t quadMode, const uint32_t previewDataSize)
+    {
+        const CarlaMutexLocker cml(fMutex);
+
+        for (AudioFileCacheEntry* const entry : fEntries)
+        {
+            if (entry->matches(filename, fileStatus, sampleRate, quadMode, previewDataSize))
+            {
+                ++entry->refCount;
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // make a newly decoded entry available to other readers, taking ownership of it.
+    // if another reader published the same data meanwhile, that one is used instead and the new one gets deleted.
+    AudioFileCacheEntry* publish(AudioFileCacheEntry* const newEntry)
+    {
+        CARLA_SAFE_ASSERT_RETURN(newEntry != nullptr, nullptr);
+
+        {
+            const CarlaMutexLocker cml(fMutex);
+
+            for (AudioFileCacheEntry* const entry : fEntries)
+            {
+                if (entry->matches(newEntry->filename, newEntry->fileStatus, newEntry->sampleRate,
+                                   newEntry->quadMode, newEntry->previewDataSize))
+                {
+                    ++entry->refCount;
+                    delete newEntry;
+                    return entry;
+                }
+            }
+
+            fEntries.push_back(newEntry);
+        }
+
+        return newEntry;
+    }
+
+    void release(AudioFileCacheEntry* const entry)
+    {
+        CARLA_SAFE_ASSERT_RETURN(entry != nullptr,);
+
+        {
+            const CarlaMutexLocker cml(fMutex);
+            CARLA_SAFE_ASSERT_RETURN(entry->refCount != 0,);
+
+            if (--entry->refCount != 0)
+                return;
+
+            fEntries.erase(std::remove(fEntries.begin(), fEntries.end(), entry), fEntries.end());
+        }
+
+        delete entry;
+    }
+
+private:
+    CarlaMutex fMutex;
+    std::vector<AudioFileCacheEntry*> fEntries;
+
+    CARLA_DECLARE_NON_COPYABLE(AudioFileCache)
+};
+
 // --------------------------------------------------------------------------------------------------------------------
 
 class AudioFileReader
@@ -167,6 +597,31 @@ public:
         return fFileNfo;
     }
 
+    /*
+     * Get the current disk streaming state, for use in the streamer thread.
+     * Returns false if this reader does not need streaming right now (nothing loaded, or file fully in memory).
+     * deadline is the time left until the ring buffer runs out, in seconds (0 if a relocation is pending).
+     * fill is how much of the ring buffer contains data ready to be played, from 0 to 1.
+     */
+    bool getStreamingState(double& deadline, float& fill) const noexcept
+    {
+        const CarlaMutexTryLocker cmtl(fReaderMutex);
+
+        if (cmtl.wasNotLocked())
+            return false;
+        if (! isFileOpen() || fEntireFileLoaded || fSampleRate == 0)
+            return false;
+
+        const uint32_t readableFrames = fRingBufferR.getReadableDataSize() / sizeof(float);
+        const uint32_t totalFrames = fRingBufferR.getSize() / sizeof(float);
+
+        fill = totalFrames != 0 ? static_cast<float>(readableFrames) / static_cast<float>(totalFrames) : 1.f;
+        deadline = fNextFileReadPos != -1 ? 0.0 : static_cast<double>(readableFrames) / fSampleRate;
+
+        // nothing to do if there is no room for a full read and no relocation is pending
+        return fNextFileReadPos != -1 || fRingBufferR.getWritableDataSize() >= sizeof(float) * kFileReaderBufferSize;
+    }
+
     bool loadFilename(const char* const filename, const uint32_t sampleRate, const QuadMode quadMode,
                       const uint32_t previewDataSize, float* previewData)
     {
@@ -177,11 +632,37 @@ public:
         cleanup();
         ad_clear_nfo(&fFileNfo);
 
-        // open new
-        fFilePtr = ad_open(filename, &fFileNfo);
+        fQuadMode = quadMode;
+
+        AudioFileStatus fileStatus;
+        fileStatus.read(filename);
+
+        fCacheEntry = fCache->acquire(filename, fileStatus, sampleRate, static_cast<uint8_t>(quadMode), previewDataSize);
+
+        // already fully decoded by another reader, no need to touch the file at all
+        if (fCacheEntry != nullptr && fCacheEntry->entireFileLoaded)
+        {
+            fFileNfo = fCacheEntry->fileNfo;
+            fCurrentBitRate = fCacheEntry->bitRate;
+            fTotalResampledFrames = fCacheEntry->totalResampledFrames;
+            fSampleRate = sampleRate;
+            fEntireFileLoaded = true;
+            carla_copyFloats(previewData, fCacheEntry->previewData, previewDataSize);
+
+            const CarlaMutexLocker cml2(fInitialMemoryPoolMutex);
+            fInitialMemoryPool = &fCacheEntry->pool;
+            return true;
+        }
+
+        // open new, plain PCM wave files are memory-mapped instead of going through the decoder
+        if (! fFileMapping.open(filename, fFileNfo))
+            fFilePtr = ad_open(filename, &fFileNfo);
 
-        if (fFilePtr == nullptr)
+        if (! isFileOpen())
+        {
+            cleanup();
             return false;
+        }
 
         ad_dump_nfo(99, &fFileNfo);
 
@@ -195,8 +676,7 @@ public:
                 carla_stderr("loadFilename(\"%s\", ...) has 0 frames", filename);
 
             ad_clear_nfo(&fFileNfo);
-            ad_close(fFilePtr);
-            fFilePtr = nullptr;
+            cleanup();
             return false;
         }
 
@@ -209,9 +689,8 @@ public:
             if (! fResampler.setup(fFileNfo.sample_rate, sampleRate, fFileNfo.channels, 32))
             {
                 ad_clear_nfo(&fFileNfo);
-                ad_close(fFilePtr);
-                fFilePtr = nullptr;
-                carla_stderr2("loadFilename(\"%s\", ...) error, resampler setup failed");
+                cleanup();
+                carla_stderr2("loadFilename(\"%s\", ...) error, resampler setup failed", filename);
                 return false;
             }
 
@@ -226,10 +705,20 @@ public:
             numResampledFrames = numFileFrames;
         }
 
-        fQuadMode = quadMode;
+        // initial seconds already decoded by another reader, we only need the file for disk streaming
+        const bool sharedInitialData = fCacheEntry != nullptr;
 
-        if (fFileNfo.can_seek == 0 || numResampledFrames <= sampleRate * kMinLengthSeconds)
+        if (sharedInitialData)
+        {
+            CARLA_SAFE_ASSERT(! fCacheEntry->entireFileLoaded);
+        }
+        else if (fFileNfo.can_seek == 0 || numResampledFrames <= sampleRate * kMinLengthSeconds)
         {
+            AudioFileCacheEntry* const entry = new AudioFileCacheEntry(filename, fileStatus, sampleRate,
+                                                                         static_cast<uint8_t>(quadMode),
+                                                                         previewDataSize);
+            AudioMemoryPool& pool(entry->pool);
+
             // read and cache the first few seconds of the file if seekable
             const uint64_t initialFrames = fFileNfo.can_seek == 0
                                          ? numFileFrames
@@ -239,12 +728,8 @@ public:
                                                   : std::min<uint64_t>(numResampledFrames,
                                                                        sampleRate * kMinLengthSeconds);
 
-            fInitialMemoryPool.create(initialResampledFrames);
-            readIntoInitialMemoryPool(initialFrames, initialResampledFrames);
-
-            // file is no longer needed, we have it all in memory
-            ad_close(fFilePtr);
-            fFilePtr = nullptr;
+            pool.create(initialResampledFrames);
+            readIntoInitialMemoryPool(pool, initialFrames, initialResampledFrames);
 
             const float resampledFramesF = static_cast<float>(numResampledFrames);
             const float previewDataSizeF = static_cast<float>(previewDataSize);
@@ -252,15 +737,20 @@ public:
             {
                 const float stepF = static_cast<float>(i)/previewDataSizeF * resampledFramesF;
                 const uint step = carla_fixedValue<uint64_t>(0, numResampledFrames-1, static_cast<uint>(stepF + 0.5f));
-                previewData[i] = std::max(std::fabs(fInitialMemoryPool.buffer[0][step]),
-                                          std::fabs(fInitialMemoryPool.buffer[1][step]));
+                entry->previewData[i] = std::max(std::fabs(pool.buffer[0][step]), std::fabs(pool.buffer[1][step]));
             }
 
-            fEntireFileLoaded = true;
+            entry->entireFileLoaded = true;
+            fCacheEntry = publishCacheEntry(entry, numResampledFrames);
         }
         else
         {
-            readFilePreview(previewDataSize, previewData);
+            AudioFileCacheEntry* const entry = new AudioFileCacheEntry(filename, fileStatus, sampleRate,
+                                                                         static_cast<uint8_t>(quadMode),
+                                                                         previewDataSize);
+            AudioMemoryPool& pool(entry->pool);
+
+            readFilePreview(previewDataSize, entry->previewData);
 
             // cache only the first few initial seconds, let disk streaming handle the rest
             const uint64_t initialFrames = std::min<uint64_t>(numFileFrames,
@@ -268,23 +758,47 @@ public:
             const uint64_t initialResampledFrames = std::min<uint64_t>(numResampledFrames,
                                                                        sampleRate * kRingBufferLengthSeconds / 2);
 
+            pool.create(initialResampledFrames);
+            readIntoInitialMemoryPool(pool, initialFrames, initialResampledFrames);
+
+            entry->entireFileLoaded = false;
+            fCacheEntry = publishCacheEntry(entry, numResampledFrames);
+        }
+
+        const AudioMemoryPool& pool(fCacheEntry->pool);
+
+        carla_copyFloats(previewData, fCacheEntry->previewData, previewDataSize);
+        fCurrentBitRate = fCacheEntry->bitRate;
+        fEntireFileLoaded = fCacheEntry->entireFileLoaded;
+
+        if (fEntireFileLoaded)
+        {
+            // file is no longer needed, we have it all in memory
+            closeFile();
+        }
+        else
+        {
             fRingBufferL.createBuffer(sampleRate * kRingBufferLengthSeconds * sizeof(float), true);
             fRingBufferR.createBuffer(sampleRate * kRingBufferLengthSeconds * sizeof(float), true);
 
-            fInitialMemoryPool.create(initialResampledFrames);
-            readIntoInitialMemoryPool(initialFrames, initialResampledFrames);
-
-            fRingBufferL.writeCustomData(fInitialMemoryPool.buffer[0], fInitialMemoryPool.numFrames * sizeof(float));
-            fRingBufferR.writeCustomData(fInitialMemoryPool.buffer[1], fInitialMemoryPool.numFrames * sizeof(float));
+            fRingBufferL.writeCustomData(pool.buffer[0], pool.numFrames * sizeof(float));
+            fRingBufferR.writeCustomData(pool.buffer[1], pool.numFrames * sizeof(float));
             fRingBufferL.commitWrite();
             fRingBufferR.commitWrite();
 
-            fEntireFileLoaded = false;
+            // continue streaming from where the shared initial memory pool ends
+            if (sharedInitialData)
+                seekFile(static_cast<int64_t>(static_cast<double>(pool.numFrames) / fResampleRatio + 0.5));
         }
 
         fTotalResampledFrames = numResampledFrames;
         fSampleRate = sampleRate;
 
+        {
+            const CarlaMutexLocker cml2(fInitialMemoryPoolMutex);
+            fInitialMemoryPool = &fCacheEntry->pool;
+        }
+
         return true;
     }
 
@@ -311,9 +825,10 @@ public:
         uint32_t numPoolFrames, usableFrames;
 
         {
-            const CarlaMutexTryLocker cmtl(fInitialMemoryPool.mutex, isOffline);
+            const CarlaMutexTryLocker cmtl(fInitialMemoryPoolMutex, isOffline);
+            const AudioMemoryPool* const pool = fInitialMemoryPool;
 
-            numPoolFrames = fInitialMemoryPool.numFrames;
+            numPoolFrames = pool != nullptr ? pool->numFrames : 0;
 
             if (numPoolFrames == 0 || ! cmtl.wasLocked())
             {
@@ -327,8 +842,8 @@ public:
             {
                 usableFrames = std::min(frames, numPoolFrames - static_cast<uint32_t>(framePos));
 
-                carla_copyFloats(outL, fInitialMemoryPool.buffer[0] + framePos, usableFrames);
-                carla_copyFloats(outR, fInitialMemoryPool.buffer[1] + framePos, usableFrames);
+                carla_copyFloats(outL, pool->buffer[0] + framePos, usableFrames);
+                carla_copyFloats(outR, pool->buffer[1] + framePos, usableFrames);
                 carla_fillFloatsWithSingleValue(playCV, 10.f, usableFrames);
 
                 outL += usableFrames;
@@ -455,8 +970,8 @@ public:
             const float posF = static_cast<float>(i)/previewDataSizeF * fileNumFramesF;
             const uint pos = carla_fixedValue(0U, maxSampleToRead, static_cast<uint>(posF));
 
-            ad_seek(fFilePtr, pos);
-            ad_read(fFilePtr, tmp, samplesPerRun);
+            seekFile(pos);
+            readFile(tmp, samplesPerRun);
 
             switch (channels)
             {
@@ -510,13 +1025,13 @@ public:
 
         const uint channels = fFileNfo.channels;
 
-        if (channels == 0 || fFilePtr == nullptr)
+        if (channels == 0 || ! isFileOpen())
         {
             carla_debug("R: no song loaded");
             return;
         }
 
-        fCurrentBitRate = ad_get_bitrate(fFilePtr);
+        fCurrentBitRate = getFileBitRate();
 
         const bool needsResample = carla_isNotEqual(fResampleRatio, 1.0);
         const uint8_t quadoffs = fQuadMode == kQuad3and4 ? 2 : 0;
@@ -529,7 +1044,7 @@ public:
 
             fPreviousResampledBuffer.frames = 0;
             fRingBufferFramePos = nextFileReadPos;
-            ad_seek(fFilePtr, nextFileReadPos / fResampleRatio);
+            seekFile(nextFileReadPos / fResampleRatio);
 
             if (needsResample)
                 fResampler.reset();
@@ -557,9 +1072,8 @@ public:
                                  sizeof(float) * prev_inp_count * channels);
                 }
 
-                r = ad_read(fFilePtr,
-                            buffer + (prev_inp_count * channels),
-                            sizeof(buffer) / sizeof(float) - (prev_inp_count * channels));
+                r = readFile(buffer + (prev_inp_count * channels),
+                             sizeof(buffer) / sizeof(float) - (prev_inp_count * channels));
 
                 if (r < 0)
                 {
@@ -653,7 +1167,7 @@ public:
 
             while (fRingBufferR.getWritableDataSize() >= sizeof(buffer))
             {
-                r = ad_read(fFilePtr, buffer, sizeof(buffer)/sizeof(float));
+                r = readFile(buffer, sizeof(buffer)/sizeof(float));
 
                 if (r < 0)
                 {
@@ -717,12 +1231,19 @@ private:
     uint64_t fTotalResampledFrames = 0;
 
     void*  fFilePtr = nullptr;
+    AudioFileMapping fFileMapping;
     ADInfo fFileNfo = {};
 
     uint32_t fSampleRate = 0;
     double fResampleRatio = 1.0;
 
-    AudioMemoryPool fInitialMemoryPool;
+    SharedResourcePointer<AudioFileCache> fCache;
+    AudioFileCacheEntry* fCacheEntry = nullptr;
+
+    // points to the memory pool of the current cache entry, protected by its mutex for use in the audio thread
+    const AudioMemoryPool* fInitialMemoryPool = nullptr;
+    CarlaMutex fInitialMemoryPoolMutex;
+
     Resampler     fResampler;
     CarlaMutex    fReaderMutex;
 
@@ -747,22 +1268,71 @@ private:
         fResampleRatio = 1.0;
 
         fResampler.clear();
-        fInitialMemoryPool.destroy();
+
+        {
+            const CarlaMutexLocker cml(fInitialMemoryPoolMutex);
+            fInitialMemoryPool = nullptr;
+        }
+
+        if (fCacheEntry != nullptr)
+        {
+            fCache->release(fCacheEntry);
+            fCacheEntry = nullptr;
+        }
+
         fRingBufferL.deleteBuffer();
         fRingBufferR.deleteBuffer();
 
+        closeFile();
+
+        delete[] fPreviousResampledBuffer.buffer;
+        fPreviousResampledBuffer.buffer = nullptr;
+        fPreviousResampledBuffer.frames = 0;
+    }
+
+    bool isFileOpen() const noexcept
+    {
+        return fFilePtr != nullptr || fFileMapping.isOpen();
+    }
+
+    void closeFile()
+    {
+        fFileMapping.close();
+
         if (fFilePtr != nullptr)
         {
             ad_close(fFilePtr);
             fFilePtr = nullptr;
         }
+    }
 
-        delete[] fPreviousResampledBuffer.buffer;
-        fPreviousResampledBuffer.buffer = nullptr;
-        fPreviousResampledBuffer.frames = 0;
+    int64_t seekFile(const int64_t pos)
+    {
+        return fFileMapping.isOpen() ? fFileMapping.seek(pos) : ad_seek(fFilePtr, pos);
+    }
+
+    ssize_t readFile(float* const out, const size_t len)
+    {
+        return fFileMapping.isOpen() ? fFileMapping.read(out, len) : ad_read(fFilePtr, out, len);
+    }
+
+    int getFileBitRate()
+    {
+        return fFileMapping.isOpen() ? fFileMapping.getBitRate() : ad_get_bitrate(fFilePtr);
+    }
+
+    // fills in the remaining details of a newly decoded cache entry and makes it available to other readers
+    AudioFileCacheEntry* publishCacheEntry(AudioFileCacheEntry* const entry, const uint64_t numResampledFrames)
+    {
+        entry->fileNfo = fFileNfo;
+        entry->fileNfo.meta_data = nullptr;
+        entry->bitRate = fCurrentBitRate;
+        entry->totalResampledFrames = numResampledFrames;
+
+        return fCache->publish(entry);
     }
 
-    void readIntoInitialMemoryPool(const uint numFrames, const uint numResampledFrames)
+    void readIntoInitialMemoryPool(AudioMemoryPool& pool, const uint numFrames, const uint numResampledFrames)
     {
         const uint channels = fFileNfo.channels;
         const uint fileBufferSize = numFrames * channels;
@@ -770,13 +1340,13 @@ private:
         float* const fileBuffer = (float*)std::malloc(fileBufferSize * sizeof(float));
         CARLA_SAFE_ASSERT_RETURN(fileBuffer != nullptr,);
 
-        ad_seek(fFilePtr, 0);
-        ssize_t rv = ad_read(fFilePtr, fileBuffer, fileBufferSize);
+        seekFile(0);
+        ssize_t rv = readFile(fileBuffer, fileBufferSize);
         CARLA_SAFE_ASSERT_INT2_RETURN(rv == static_cast<ssize_t>(fileBufferSize),
                                       rv, fileBufferSize,
                                       std::free(fileBuffer));
 
-        fCurrentBitRate = ad_get_bitrate(fFilePtr);
+        fCurrentBitRate = getFileBitRate();
 
         float* resampledBuffer;
 
@@ -791,8 +1361,8 @@ private:
             fResampler.out_data = resampledBuffer;
             fResampler.process();
 
-            fInitialMemoryPool.numFrames = numResampledFrames - fResampler.out_count;
-            rv = fInitialMemoryPool.numFrames * channels;
+            pool.numFrames = numResampledFrames - fResampler.out_count;
+            rv = pool.numFrames * channels;
         }
         else
         {
@@ -801,19 +1371,19 @@ private:
 
         {
             // lock, and put data asap
-            const CarlaMutexLocker cml(fInitialMemoryPool.mutex);
+            const CarlaMutexLocker cml(pool.mutex);
 
             switch (channels)
             {
             case 1:
                 for (ssize_t i=0; i < rv; ++i)
-                    fInitialMemoryPool.buffer[0][i] = fInitialMemoryPool.buffer[1][i] = resampledBuffer[i];
+                    pool.buffer[0][i] = pool.buffer[1][i] = resampledBuffer[i];
                 break;
             case 2:
                 for (ssize_t i=0, j=0; i < rv; ++j)
                 {
-                    fInitialMemoryPool.buffer[0][j] = resampledBuffer[i++];
-                    fInitialMemoryPool.buffer[1][j] = resampledBuffer[i++];
+                    pool.buffer[0][j] = resampledBuffer[i++];
+                    pool.buffer[1][j] = resampledBuffer[i++];
                 }
                 break;
             case 4:
@@ -821,7 +1391,7 @@ private:
                 {
                     for (ssize_t i=0, j=0; i < rv; ++j)
                     {
-                        fInitialMemoryPool.buffer[0][j] = fInitialMemoryPool.buffer[1][j]
+                        pool.buffer[0][j] = pool.buffer[1][j]
                             = resampledBuffer[i] + resampledBuffer[i+1] + resampledBuffer[i+2] + resampledBuffer[i+3];
                         i += 4;
                     }
@@ -830,8 +1400,8 @@ private:
                 {
                     for (ssize_t i = fQuadMode == kQuad3and4 ? 2 : 0, j = 0; i < rv; ++j)
                     {
-                        fInitialMemoryPool.buffer[0][j] = resampledBuffer[i];
-                        fInitialMemoryPool.buffer[1][j] = resampledBuffer[i+1];
+                        pool.buffer[0][j] = resampledBuffer[i];
+                        pool.buffer[1][j] = resampledBuffer[i+1];
                         i += 4;
                     }
                 }
@@ -848,6 +1418,116 @@ private:
     CARLA_DECLARE_NON_COPYABLE(AudioFileReader)
 };
 
+#ifndef CARLA_OS_WASM
+// --------------------------------------------------------------------------------------------------------------------
+// Disk streaming service shared by all audio file readers.
+// Ring buffers get refilled as soon as the audio thread requests it, instead of depending on the host idle rate.
+// Readers are serviced by deadline (earliest ring buffer underrun first), and topped up periodically for read-ahead.
+
+class AudioFileStreamer : private CarlaThread
+{
+public:
+    AudioFileStreamer()
+        : CarlaThread("AudioFileStreamer"),
+          fSem(),
+          fWakeupPending(0),
+          fReadersMutex(),
+          fReaders(),
+          fEntries()
+    {
+        carla_sem_create2(fSem, false);
+        startThread();
+    }
+
+    ~AudioFileStreamer() override
+    {
+        signalThreadShouldExit();
+        requestRead();
+        stopThread(-1);
+        carla_sem_destroy2(fSem);
+    }
+
+    void addReader(AudioFileReader* const reader)
+    {
+        CARLA_SAFE_ASSERT_RETURN(reader != nullptr,);
+
+        const CarlaMutexLocker cml(fReadersMutex);
+        fReaders.push_back(reader);
+        fEntries.reserve(fReaders.size());
+    }
+
+    void removeReader(AudioFileReader* const reader)
+    {
+        CARLA_SAFE_ASSERT_RETURN(reader != nullptr,);
+
+        const CarlaMutexLocker cml(fReadersMutex);
+        fReaders.erase(std::remove(fReaders.begin(), fReaders.end(), reader), fReaders.end());
+    }
+
+    // to be called from the audio thread, wakes up the streamer thread as soon as possible
+    void requestRead() noexcept
+    {
+        if (__sync_bool_compare_and_swap(&fWakeupPending, 0, 1))
+            carla_sem_post(fSem);
+    }
+
+protected:
+    void run() override
+    {
+        while (! shouldThreadExit())
+        {
+            if (carla_sem_timedwait(fSem, kStreamerPollIntervalMs))
+                __atomic_store_n(&fWakeupPending, 0, __ATOMIC_SEQ_CST);
+
+            const CarlaMutexLocker cml(fReadersMutex);
+
+            fEntries.clear();
+
+            for (AudioFileReader* const reader : fReaders)
+            {
+                Entry entry = { reader, 0.0, 0.f };
+
+                if (reader->getStreamingState(entry.deadline, entry.fill))
+                    fEntries.push_back(entry);
+            }
+
+            std::sort(fEntries.begin(), fEntries.end(), Entry::compare);
+
+            for (const Entry& entry : fEntries)
+            {
+                if (shouldThreadExit())
+                    break;
+
+                entry.reader->readPoll();
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        AudioFileReader* reader;
+        double deadline;
+        float fill;
+
+        static bool compare(const Entry& a, const Entry& b) noexcept
+        {
+            if (carla_isEqual(a.deadline, b.deadline))
+                return a.fill < b.fill;
+            return a.deadline < b.deadline;
+        }
+    };
+
+    carla_sem_t fSem;
+    int fWakeupPending;
+
+    CarlaMutex fReadersMutex;
+    std::vector<AudioFileReader*> fReaders;
+    std::vector<Entry> fEntries;
+
+    CARLA_DECLARE_NON_COPYABLE(AudioFileStreamer)
+};
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 
 #endif // AUDIO_BASE_HPP_INCLUDED
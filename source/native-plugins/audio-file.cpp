@@ -109,7 +109,19 @@ public:
        #else
         : NativePluginClass(host),
        #endif
-          fVolumeFilter(getSampleRate()) {}
+          fVolumeFilter(getSampleRate())
+    {
+       #ifndef CARLA_OS_WASM
+        fStreamer->addReader(&fReader);
+       #endif
+    }
+
+    ~AudioFilePlugin() override
+    {
+       #ifndef CARLA_OS_WASM
+        fStreamer->removeReader(&fReader);
+       #endif
+    }
 
 protected:
     // ----------------------------------------------------------------------------------------------------------------
@@ -446,8 +458,12 @@ protected:
             }
             else
             {
+               #ifndef CARLA_OS_WASM
+                fStreamer->requestRead();
+               #else
                 fPendingFileRead = true;
                 needsIdleRequest = true;
+               #endif
             }
         }
 
@@ -666,6 +682,10 @@ private:
     AudioFileReader fReader;
     String fFilename;
 
+   #ifndef CARLA_OS_WASM
+    SharedResourcePointer<AudioFileStreamer> fStreamer;
+   #endif
+
     float fPreviewData[108] = {};
 
    #ifndef __MOD_DEVICES__
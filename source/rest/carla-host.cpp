@@ -43,12 +43,29 @@ static void EngineCallback(void* ptr, EngineCallbackOpcode action, uint pluginId
     case ENGINE_CALLBACK_ENGINE_STOPPED:
     case ENGINE_CALLBACK_QUIT:
         gEngineRunning = false;
+        reset_server_side_feeds();
+        break;
+    case ENGINE_CALLBACK_PLUGIN_REMOVED:
+        reset_server_side_feeds();
         break;
     default:
         break;
     }
 
-    return send_server_side_message(msgBuf);
+    send_server_side_message(msgBuf);
+
+    switch (action)
+    {
+    case ENGINE_CALLBACK_PARAMETER_VALUE_CHANGED:
+    case ENGINE_CALLBACK_PROGRAM_CHANGED:
+    case ENGINE_CALLBACK_MIDI_PROGRAM_CHANGED:
+    case ENGINE_CALLBACK_RELOAD_PARAMETERS:
+    case ENGINE_CALLBACK_RELOAD_ALL:
+        send_server_side_parameter_changes(pluginId);
+        break;
+    default:
+        break;
+    }
 
     // maybe unused
     (void)ptr;
@@ -434,6 +451,7 @@ void handle_carla_load_plugin_state(const std::shared_ptr<Session> session)
     const std::string filename = request->get_query_parameter("filename");
 
     const char* const buf = str_buf_bool(carla_load_plugin_state(pluginId, filename.c_str()));
+    send_server_side_parameter_changes(pluginId);
     session->close(OK, buf, { { "Content-Length", size_buf(buf) } } );
 }
 
@@ -908,6 +926,26 @@ void handle_carla_get_output_peak_value(const std::shared_ptr<Session> session)
     session->close(OK, buf, { { "Content-Length", size_buf(buf) } } );
 }
 
+void handle_carla_get_plugin_process_time_info(const std::shared_ptr<Session> session)
+{
+    const std::shared_ptr<const Request> request = session->get_request();
+
+    const int pluginId = std::atoi(request->get_query_parameter("pluginId").c_str());
+    CARLA_SAFE_ASSERT_RETURN(pluginId >= 0,)
+
+    const CarlaPluginProcessTimeInfo* const info = carla_get_plugin_process_time_info(pluginId);
+
+    char* jsonBuf;
+    jsonBuf = json_buf_start();
+    jsonBuf = json_buf_add_float(jsonBuf, "meanLoad", info->meanLoad);
+    jsonBuf = json_buf_add_float(jsonBuf, "p99Load", info->p99Load);
+    jsonBuf = json_buf_add_float(jsonBuf, "maxLoad", info->maxLoad);
+    jsonBuf = json_buf_add_uint(jsonBuf, "blockCount", info->blockCount);
+
+    const char* const buf = json_buf_end(jsonBuf);
+    session->close(OK, buf, { { "Content-Length", size_buf(buf) } } );
+}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 void handle_carla_set_active(const std::shared_ptr<Session> session)
@@ -1040,6 +1078,7 @@ void handle_carla_set_parameter_value(const std::shared_ptr<Session> session)
     const double value = std::atof(request->get_query_parameter("value").c_str());
 
     carla_set_parameter_value(pluginId, parameterId, value);
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1088,6 +1127,7 @@ void handle_carla_set_program(const std::shared_ptr<Session> session)
     CARLA_SAFE_ASSERT_RETURN(programId >= 0,)
 
     carla_set_program(pluginId, programId);
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1102,6 +1142,7 @@ void handle_carla_set_midi_program(const std::shared_ptr<Session> session)
     CARLA_SAFE_ASSERT_RETURN(midiProgramId >= 0,)
 
     carla_set_midi_program(pluginId, midiProgramId);
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1117,6 +1158,7 @@ void handle_carla_set_custom_data(const std::shared_ptr<Session> session)
     const std::string value = request->get_query_parameter("value");
 
     carla_set_custom_data(pluginId, type.c_str(), key.c_str(), value.c_str());
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1130,6 +1172,7 @@ void handle_carla_set_chunk_data(const std::shared_ptr<Session> session)
     const std::string chunkData = request->get_query_parameter("chunkData");
 
     carla_set_chunk_data(pluginId, chunkData.c_str());
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1154,6 +1197,7 @@ void handle_carla_reset_parameters(const std::shared_ptr<Session> session)
     CARLA_SAFE_ASSERT_RETURN(pluginId >= 0,)
 
     carla_reset_parameters(pluginId);
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -1165,6 +1209,7 @@ void handle_carla_randomize_parameters(const std::shared_ptr<Session> session)
     CARLA_SAFE_ASSERT_RETURN(pluginId >= 0,)
 
     carla_randomize_parameters(pluginId);
+    send_server_side_parameter_changes(pluginId);
     session->close(OK);
 }
 
@@ -36,5 +36,7 @@ using restbed::OK;
 CARLA_BACKEND_USE_NAMESPACE;
 
 void send_server_side_message(const char* const message);
+void send_server_side_parameter_changes(uint pluginId);
+void reset_server_side_feeds();
 
 #endif // REST_COMMON_HPP_INCLUDED
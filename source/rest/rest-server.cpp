@@ -31,7 +31,12 @@
 
 // -------------------------------------------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <restbed>
 #include <system_error>
 #include <openssl/sha.h>
@@ -48,18 +53,377 @@ using namespace std::chrono;
 
 CarlaStringList gSessionMessages;
 CarlaMutex gSessionMessagesMutex;
+std::set<uint> gSessionParameterChanges;
+bool gSessionPluginsChanged = false;
+
+// the thread running the service, where sockets can be used directly
+std::thread::id gServiceThread;
 
 std::map< string, shared_ptr< WebSocket > > sockets = { };
 
 // -------------------------------------------------------------------------------------------------------------------
+// change feed
+//
+// Clients connected to /ws only receive what changed since their last update, and only for what they subscribed to.
+// Callbacks and parameter changes are pushed as soon as the engine reports them, or after a request changed them.
+// Peaks and output parameters are meters without change notifications, so they are sampled on each engine idle.
+// Subscriptions are changed by sending text messages:
+//   "subscribe callbacks"                 / "unsubscribe callbacks"
+//   "subscribe peaks [pluginId...]"       / "unsubscribe peaks [pluginId...]"
+//   "subscribe parameters [pluginId...]"  / "unsubscribe parameters [pluginId...]"
+// where no plugin ids means all plugins. New clients are subscribed to callbacks and the peaks of all plugins.
+//
+// Until a client sends its first subscription message it gets the old text-only stream instead, for compatibility:
+// all callbacks, a "Peaks: ..." message for every plugin and a "Keep-Alive" message on every update.
+// Any other text message is broadcast to all clients, as before.
+//
+// Callbacks are sent as text, same as before. Peaks and parameters are sent as binary messages made of records:
+//   uint8 type, uint8 reserved, uint16 count, uint32 pluginId, then the payload (all little-endian)
+//   type 1, peaks:      4 uint8 values (input left/right, output left/right), scaled to 0-255
+//   type 2, parameters: count pairs of uint32 parameter index and float value
+
+static const uint8_t kFeedRecordPeaks      = 1;
+static const uint8_t kFeedRecordParameters = 2;
+
+struct FeedFilter {
+    bool all;
+    std::set<uint> plugins;
+
+    FeedFilter()
+        : all(false),
+          plugins() {}
+
+    bool contains(const uint pluginId) const
+    {
+        return all || plugins.count(pluginId) != 0;
+    }
+};
+
+struct FeedClient {
+    bool legacy;
+    bool callbacks;
+    FeedFilter peaks;
+    FeedFilter parameters;
+
+    // last state sent to this client
+    std::map<uint, uint32_t> lastPeaks;
+    std::map<uint, uint64_t> parameterSequences;
+
+    FeedClient()
+        : legacy(true),
+          callbacks(true),
+          peaks(),
+          parameters(),
+          lastPeaks(),
+          parameterSequences()
+    {
+        peaks.all = true;
+    }
+
+    void reset()
+    {
+        lastPeaks.clear();
+        parameterSequences.clear();
+    }
+};
+
+std::map< string, FeedClient > feedClients = { };
+
+static void feed_append_uint(Bytes& data, const uint32_t value, const uint size)
+{
+    for (uint i=0; i<size; ++i)
+        data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+static void feed_append_record_header(Bytes& data, const uint8_t type, const uint16_t count, const uint pluginId)
+{
+    data.push_back(type);
+    data.push_back(0);
+    feed_append_uint(data, count, 2);
+    feed_append_uint(data, pluginId, 4);
+}
+
+static uint32_t feed_pack_peaks(const float* const peaks)
+{
+    uint32_t packed = 0;
+
+    for (uint i=0; i<4; ++i)
+    {
+        const float peak = std::max(0.0f, std::min(1.0f, peaks[i]));
+        packed |= static_cast<uint32_t>(peak * 255.0f + 0.5f) << (i * 8);
+    }
+
+    return packed;
+}
+
+static void feed_append_parameters(Bytes& data, const uint pluginId,
+                                   const uint32_t* const indexes, const float* const values, const uint32_t count)
+{
+    for (uint32_t offset = 0; offset < count;)
+    {
+        const uint16_t chunk = static_cast<uint16_t>(std::min<uint32_t>(count - offset, 0xffff));
+
+        feed_append_record_header(data, kFeedRecordParameters, chunk, pluginId);
+
+        for (uint32_t i = offset, end = offset + chunk; i < end; ++i)
+        {
+            uint32_t valueBits;
+            std::memcpy(&valueBits, &values[i], sizeof(valueBits));
+
+            feed_append_uint(data, indexes[i], 4);
+            feed_append_uint(data, valueBits, 4);
+        }
+
+        offset += chunk;
+    }
+}
+
+static bool feed_handle_subscription(FeedClient& client, const string& text)
+{
+    std::istringstream stream(text);
+    string command, topic;
+
+    if (! (stream >> command >> topic))
+        return false;
+
+    bool subscribe;
+    /**/ if (command == "subscribe")
+        subscribe = true;
+    else if (command == "unsubscribe")
+        subscribe = false;
+    else
+        return false;
+
+    if (topic == "callbacks")
+    {
+        if (! (stream >> std::ws).eof())
+            return false;
+
+        client.legacy = false;
+        client.callbacks = subscribe;
+        return true;
+    }
+
+    FeedFilter* filter;
+    /**/ if (topic == "peaks")
+        filter = &client.peaks;
+    else if (topic == "parameters")
+        filter = &client.parameters;
+    else
+        return false;
+
+    std::vector<uint> pluginIds;
+    uint pluginId;
+
+    while (stream >> pluginId)
+        pluginIds.push_back(pluginId);
+
+    if (! stream.eof())
+        return false;
+
+    client.legacy = false;
+
+    if (pluginIds.empty())
+    {
+        filter->all = subscribe;
+        filter->plugins.clear();
+    }
+
+    for (const uint id : pluginIds)
+    {
+        if (subscribe)
+        {
+            filter->plugins.insert(id);
+        }
+        else
+        {
+            filter->plugins.erase(id);
+
+            // make sure the full state is sent if subscribed again
+            client.lastPeaks.erase(id);
+            client.parameterSequences.erase(id);
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------------------------
+
+// plugin ids might now refer to different plugins, resend everything
+static void feed_check_reset()
+{
+    {
+        const CarlaMutexLocker cml(gSessionMessagesMutex);
+
+        if (! gSessionPluginsChanged)
+            return;
+
+        gSessionPluginsChanged = false;
+    }
+
+    for (auto& entry : feedClients)
+        entry.second.reset();
+}
+
+static void feed_send_message(const char* const message)
+{
+    for (auto entry : sockets)
+    {
+        auto socket = entry.second;
+
+        if (socket->is_open() && feedClients[entry.first].callbacks)
+            socket->send(message);
+    }
+}
+
+static void feed_send_parameter_changes(const uint pluginId)
+{
+    feed_check_reset();
+
+    const uint32_t paramCount = carla_get_parameter_count(pluginId);
+
+    if (paramCount == 0)
+        return;
+
+    std::vector<uint32_t> paramIndexes(paramCount);
+    std::vector<float> paramValues(paramCount);
+
+    for (auto entry : sockets)
+    {
+        auto socket = entry.second;
+
+        if (! socket->is_open())
+            continue;
+
+        FeedClient& client(feedClients[entry.first]);
+
+        if (client.legacy || ! client.parameters.contains(pluginId))
+            continue;
+
+        uint64_t& sequence(client.parameterSequences[pluginId]);
+
+        if (const uint32_t changed = carla_get_parameter_value_changes(pluginId, &sequence,
+                                                                        paramIndexes.data(),
+                                                                        paramValues.data(),
+                                                                        paramCount))
+        {
+            Bytes data;
+            feed_append_parameters(data, pluginId, paramIndexes.data(), paramValues.data(), changed);
+            socket->send(make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, data ));
+        }
+    }
+}
+
+static void feed_send_meters()
+{
+    feed_check_reset();
+
+    uint count = carla_get_current_plugin_count();
+
+    if (count == 0)
+        return;
+
+    std::vector<float> peaks(count * 4);
+    count = carla_get_all_peak_values(peaks.data(), count);
+
+    // nothing is sent to subscribed clients unless something changed, ping_handler keeps their connections alive
+    for (auto entry : sockets)
+    {
+        auto socket = entry.second;
+
+        if (! socket->is_open())
+            continue;
+
+        FeedClient& client(feedClients[entry.first]);
+
+        if (client.legacy)
+        {
+            char msgBuf[1024];
+
+            for (uint i=0; i<count; ++i)
+            {
+                std::snprintf(msgBuf, 1023, "Peaks: %u %f %f %f %f", i,
+                              static_cast<double>(peaks[i * 4 + 0]), static_cast<double>(peaks[i * 4 + 1]),
+                              static_cast<double>(peaks[i * 4 + 2]), static_cast<double>(peaks[i * 4 + 3]));
+                msgBuf[1023] = '\0';
+                socket->send(msgBuf);
+            }
+
+            continue;
+        }
+
+        Bytes data;
+
+        for (uint i=0; i<count; ++i)
+        {
+            if (! client.peaks.contains(i))
+                continue;
+
+            const uint32_t packed = feed_pack_peaks(&peaks[i * 4]);
+            const auto it = client.lastPeaks.find(i);
+
+            if (it == client.lastPeaks.end() || it->second != packed)
+            {
+                client.lastPeaks[i] = packed;
+                feed_append_record_header(data, kFeedRecordPeaks, 4, i);
+                feed_append_uint(data, packed, 4);
+            }
+        }
+
+        if (! data.empty())
+            socket->send(make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, data ));
+    }
+
+    // output parameters change without notifications
+    for (uint i=0; i<count; ++i)
+    {
+        if (const CarlaPortCountInfo* const info = carla_get_parameter_count_info(i))
+        {
+            if (info->outs != 0)
+                feed_send_parameter_changes(i);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------------
+
+// engine callbacks normally arrive on the service thread, during carla_engine_idle or a request.
+// anything coming from other threads is kept for the next event_stream_handler run.
 
 void send_server_side_message(const char* const message)
 {
+    if (std::this_thread::get_id() == gServiceThread)
+    {
+        feed_send_message(message);
+        return;
+    }
+
     const CarlaMutexLocker cml(gSessionMessagesMutex);
 
     gSessionMessages.append(message);
 }
 
+void send_server_side_parameter_changes(const uint pluginId)
+{
+    if (std::this_thread::get_id() == gServiceThread)
+    {
+        feed_send_parameter_changes(pluginId);
+        return;
+    }
+
+    const CarlaMutexLocker cml(gSessionMessagesMutex);
+
+    gSessionParameterChanges.insert(pluginId);
+}
+
+void reset_server_side_feeds()
+{
+    const CarlaMutexLocker cml(gSessionMessagesMutex);
+
+    gSessionPluginsChanged = true;
+}
+
 // -------------------------------------------------------------------------------------------------------------------
 
 static void event_stream_handler(void)
@@ -69,65 +433,47 @@ static void event_stream_handler(void)
     if (firstInit)
     {
         firstInit = false;
+        gServiceThread = std::this_thread::get_id();
         carla_stdout("Carla REST-API Server started");
     }
 
     const bool running = carla_is_engine_running();
 
+    // callbacks triggered by this are sent right away
     if (running)
         carla_engine_idle();
 
     CarlaStringList messages;
+    std::set<uint> parameterChanges;
 
     {
         const CarlaMutexLocker cml(gSessionMessagesMutex);
 
         if (gSessionMessages.count() > 0)
             gSessionMessages.moveTo(messages);
+
+        parameterChanges.swap(gSessionParameterChanges);
     }
 
     for (auto message : messages)
-    {
-        for (auto entry : sockets)
-        {
-            auto socket = entry.second;
+        feed_send_message(message);
 
-            if (socket->is_open())
-                socket->send(message);
-        }
-    }
+    if (sockets.empty())
+        return;
 
     if (running)
     {
-        if (const uint count = carla_get_current_plugin_count())
-        {
-            char msgBuf[1024];
-            float* peaks;
-
-            for (uint i=0; i<count; ++i)
-            {
-                peaks = carla_get_peak_values(i);
-                CARLA_SAFE_ASSERT_BREAK(peaks != nullptr);
-
-                std::snprintf(msgBuf, 1023, "Peaks: %u %f %f %f %f", i, peaks[0], peaks[1], peaks[2], peaks[3]);
-                msgBuf[1023] = '\0';
-
-                for (auto entry : sockets)
-                {
-                    auto socket = entry.second;
+        for (const uint pluginId : parameterChanges)
+            feed_send_parameter_changes(pluginId);
 
-                    if (socket->is_open())
-                        socket->send(msgBuf);
-                }
-            }
-        }
+        feed_send_meters();
     }
 
     for (auto entry : sockets)
     {
         auto socket = entry.second;
 
-        if (socket->is_open())
+        if (socket->is_open() && feedClients[entry.first].legacy)
             socket->send("Keep-Alive");
     }
 }
@@ -185,6 +531,7 @@ void close_handler( const shared_ptr< WebSocket > socket )
 
     const auto key = socket->get_key( );
     sockets.erase( key );
+    feedClients.erase( key );
 
     fprintf( stderr, "Closed connection to %s.\n", key.data( ) );
 }
@@ -228,6 +575,14 @@ void message_handler( const shared_ptr< WebSocket > source, const shared_ptr< We
     }
     else if ( opcode == WebSocketMessage::TEXT_FRAME )
     {
+        const auto key = source->get_key( );
+        const auto data = message->get_data( );
+        const string text( data.begin( ), data.end( ) );
+
+        if ( feed_handle_subscription( feedClients[ key ], text ) )
+            return;
+
+        // not a subscription, broadcast it like before
         auto response = make_shared< WebSocketMessage >( *message );
         response->set_mask( 0 );
 
@@ -237,9 +592,7 @@ void message_handler( const shared_ptr< WebSocket > source, const shared_ptr< We
             destination->send( response );
         }
 
-        const auto key = source->get_key( );
-        const auto data = String::format( "Received message '%.*s' from %s\n", message->get_data( ).size( ), message->get_data( ).data( ), key.data( ) );
-        fprintf( stderr, "%s", data.data( ) );
+        fprintf( stderr, "Received message '%s' from %s\n", text.c_str( ), key.data( ) );
     }
 }
 
@@ -268,6 +621,7 @@ void get_method_handler(const shared_ptr<Session> session)
 
                     auto key = socket->get_key( );
                     sockets[key] = socket;
+                    feedClients[key] = FeedClient();
                 }
                 else
                 {
@@ -400,6 +754,7 @@ int main(int, const char**)
     make_resource(service, "/get_internal_parameter_value", handle_carla_get_internal_parameter_value);
     make_resource(service, "/get_input_peak_value", handle_carla_get_input_peak_value);
     make_resource(service, "/get_output_peak_value", handle_carla_get_output_peak_value);
+    make_resource(service, "/get_plugin_process_time_info", handle_carla_get_plugin_process_time_info);
 
     make_resource(service, "/set_active", handle_carla_set_active);
     make_resource(service, "/set_drywet", handle_carla_set_drywet);
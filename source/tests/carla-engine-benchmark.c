@@ -0,0 +1,673 @@
+/*
+ * Carla Engine benchmark
+ * Copyright (C) 2025 Filipe Coelho <falktx@falktx.com>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * For a full copy of the GNU General Public License see the doc/GPL.txt file.
+ */
+
+/*
+ * Measures engine throughput by running the rack and patchbay engines as native plugins,
+ * calling their process function as fast as possible without any audio device or clock involved.
+ * Graphs are chains of internal plugins, automatically connected in patchbay mode.
+ * The empty graph used as reference has its inputs connected straight to its outputs.
+ *
+ * Each run prints one JSON object per line, so results can be compared between Carla versions:
+ *  - cycles per second, time per cycle and realtime factor of the whole engine
+ *  - per-plugin overhead, as the extra time per cycle compared to an empty graph, divided by the plugin count
+ *  - per-plugin DSP load, as measured by the engine itself
+ *  - MIDI event throughput into and out of the engine
+ *
+ * Usage: carla-engine-benchmark [options]
+ *  -m rack|patchbay      engine mode, can be repeated (default: both)
+ *  -p label[,label...]   internal plugins to chain, one graph per label (default: audiogain,bypass,midithrough)
+ *  -n count[,count...]   number of plugin instances per graph (default: 1,16)
+ *  -b size[,size...]     buffer sizes (default: 64,128,256,512,1024)
+ *  -e count              MIDI events sent per cycle (default: 32)
+ *  -t seconds            measured time per run (default: 0.5)
+ *  -o file               write results into a file instead of stdout
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "CarlaNativePlugin.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LIST_ITEMS 16
+#define MAX_GROUPS     260 /* max patchbay plugins, plus engine inputs and outputs */
+#define MAX_PORTS      8
+#define SAMPLE_RATE    48000.0
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * options */
+
+typedef struct {
+    const char* modes[2];
+    uint32_t numModes;
+    char* labels[MAX_LIST_ITEMS];
+    uint32_t numLabels;
+    uint32_t counts[MAX_LIST_ITEMS];
+    uint32_t numCounts;
+    uint32_t bufferSizes[MAX_LIST_ITEMS];
+    uint32_t numBufferSizes;
+    uint32_t eventsPerCycle;
+    double seconds;
+    FILE* out;
+} BenchmarkOptions;
+
+static uint32_t parse_uint_list(char* const str, uint32_t* const values)
+{
+    uint32_t count = 0;
+
+    for (char* token = strtok(str, ","); token != NULL && count < MAX_LIST_ITEMS; token = strtok(NULL, ","))
+    {
+        const long value = strtol(token, NULL, 10);
+
+        if (value > 0)
+            values[count++] = (uint32_t)value;
+    }
+
+    return count;
+}
+
+static uint32_t parse_str_list(char* const str, char** const values)
+{
+    uint32_t count = 0;
+
+    for (char* token = strtok(str, ","); token != NULL && count < MAX_LIST_ITEMS; token = strtok(NULL, ","))
+        values[count++] = token;
+
+    return count;
+}
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * host */
+
+typedef struct {
+    uint32_t bufferSize;
+    NativeTimeInfo timeInfo;
+    uint64_t eventsOut;
+
+    /* patchbay groups and ports, filled by engine callbacks */
+    struct {
+        uint id;
+        int pluginId;
+        char name[32];
+        uint audioIns[MAX_PORTS], audioOuts[MAX_PORTS], midiIns[MAX_PORTS], midiOuts[MAX_PORTS];
+        uint32_t numAudioIns, numAudioOuts, numMidiIns, numMidiOuts;
+    } groups[MAX_GROUPS];
+    uint32_t numGroups;
+} BenchmarkHost;
+
+static uint32_t get_buffer_size(NativeHostHandle h)
+{
+    return ((BenchmarkHost*)h)->bufferSize;
+}
+
+static double get_sample_rate(NativeHostHandle h)
+{
+    return SAMPLE_RATE;
+
+    /* unused */
+    (void)h;
+}
+
+static bool is_offline(NativeHostHandle h)
+{
+    return false;
+
+    /* unused */
+    (void)h;
+}
+
+static const NativeTimeInfo* get_time_info(NativeHostHandle h)
+{
+    return &((BenchmarkHost*)h)->timeInfo;
+}
+
+static bool write_midi_event(NativeHostHandle h, const NativeMidiEvent* event)
+{
+    ++((BenchmarkHost*)h)->eventsOut;
+    return true;
+
+    /* unused */
+    (void)event;
+}
+
+static intptr_t dispatcher(NativeHostHandle h, NativeHostDispatcherOpcode c, int32_t i, intptr_t v, void* p, float o)
+{
+    return 0;
+
+    /* unused */
+    (void)h;
+    (void)c;
+    (void)i;
+    (void)v;
+    (void)p;
+    (void)o;
+}
+
+static void engine_callback(void* ptr, EngineCallbackOpcode action, uint pluginId,
+                            int value1, int value2, int value3, float valuef, const char* valueStr)
+{
+    BenchmarkHost* const host = (BenchmarkHost*)ptr;
+
+    switch (action)
+    {
+    case ENGINE_CALLBACK_PATCHBAY_CLIENT_ADDED:
+        if (host->numGroups < MAX_GROUPS)
+        {
+            memset(&host->groups[host->numGroups], 0, sizeof(host->groups[0]));
+            host->groups[host->numGroups].id = pluginId;
+            host->groups[host->numGroups].pluginId = value2;
+            strncpy(host->groups[host->numGroups].name, valueStr, sizeof(host->groups[0].name) - 1);
+            ++host->numGroups;
+        }
+        break;
+
+    case ENGINE_CALLBACK_PATCHBAY_PORT_ADDED:
+        for (uint32_t i=0; i<host->numGroups; ++i)
+        {
+            if (host->groups[i].id != pluginId)
+                continue;
+
+            const uint hints = (uint)value2;
+            const uint port = (uint)value1;
+
+            if (hints & PATCHBAY_PORT_TYPE_AUDIO)
+            {
+                if (hints & PATCHBAY_PORT_IS_INPUT) {
+                    if (host->groups[i].numAudioIns < MAX_PORTS)
+                        host->groups[i].audioIns[host->groups[i].numAudioIns++] = port;
+                } else {
+                    if (host->groups[i].numAudioOuts < MAX_PORTS)
+                        host->groups[i].audioOuts[host->groups[i].numAudioOuts++] = port;
+                }
+            }
+            else if (hints & PATCHBAY_PORT_TYPE_MIDI)
+            {
+                if (hints & PATCHBAY_PORT_IS_INPUT) {
+                    if (host->groups[i].numMidiIns < MAX_PORTS)
+                        host->groups[i].midiIns[host->groups[i].numMidiIns++] = port;
+                } else {
+                    if (host->groups[i].numMidiOuts < MAX_PORTS)
+                        host->groups[i].midiOuts[host->groups[i].numMidiOuts++] = port;
+                }
+            }
+            break;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    /* unused */
+    (void)value3;
+    (void)valuef;
+}
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * patchbay graph connections */
+
+static int find_plugin_group(const BenchmarkHost* const host, const int pluginId)
+{
+    for (uint32_t i=0; i<host->numGroups; ++i)
+    {
+        if (host->groups[i].pluginId == pluginId)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+static int find_named_group(const BenchmarkHost* const host, const char* const name)
+{
+    for (uint32_t i=0; i<host->numGroups; ++i)
+    {
+        if (host->groups[i].pluginId < 0 && strcmp(host->groups[i].name, name) == 0)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+/* connect groups in a chain, starting from the named input and ending at the named output */
+static bool connect_chain(const CarlaHostHandle handle, const BenchmarkHost* const host,
+                          const uint32_t numPlugins, const bool midi, const char* const inName, const char* const outName)
+{
+    int prev = find_named_group(host, inName);
+
+    if (prev < 0)
+        return false;
+
+    for (uint32_t i=0; i<=numPlugins; ++i)
+    {
+        const int next = i < numPlugins ? find_plugin_group(host, (int)i) : find_named_group(host, outName);
+
+        if (next < 0)
+            return false;
+
+        const uint32_t numIns  = midi ? host->groups[next].numMidiIns : host->groups[next].numAudioIns;
+        const uint32_t numOuts = midi ? host->groups[prev].numMidiOuts : host->groups[prev].numAudioOuts;
+
+        if (numIns != 0 && numOuts == 0)
+            return false;
+
+        for (uint32_t j=0; j<numIns; ++j)
+        {
+            const uint portA = midi ? host->groups[prev].midiOuts[j % numOuts] : host->groups[prev].audioOuts[j % numOuts];
+            const uint portB = midi ? host->groups[next].midiIns[j] : host->groups[next].audioIns[j];
+
+            if (! carla_patchbay_connect(handle, false, host->groups[prev].id, portA, host->groups[next].id, portB))
+                return false;
+        }
+
+        /* plugins without outputs of this type end their branch, the chain continues from the previous group */
+        if ((midi ? host->groups[next].numMidiOuts : host->groups[next].numAudioOuts) != 0)
+            prev = next;
+    }
+
+    return true;
+}
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * benchmark runs */
+
+typedef struct {
+    uint64_t cycles;
+    double seconds;
+    double nsPerCycle;
+    double pluginNsMeasured;
+    uint64_t eventsIn;
+    uint64_t eventsOut;
+} BenchmarkResult;
+
+static double get_time_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+/* patchbay connections are applied asynchronously by the graph, process until audio gets through them */
+static bool wait_for_graph(const NativePluginDescriptor* const engine, const NativePluginHandle handle,
+                           BenchmarkHost* const host, float** const ins, float** const outs,
+                           const NativeMidiEvent* const events, const uint32_t numEvents)
+{
+    const uint32_t bufferSize = host->bufferSize;
+    const struct timespec interval = { 0, 10000000 }; /* 10ms */
+
+    for (uint32_t i=0; i<200; ++i)
+    {
+        engine->process(handle, ins, outs, bufferSize, events, numEvents);
+        host->timeInfo.frame += bufferSize;
+
+        for (uint32_t j=0; j<bufferSize; ++j)
+        {
+            if (outs[0][j] != 0.0f || outs[1][j] != 0.0f)
+                return true;
+        }
+
+        nanosleep(&interval, NULL);
+    }
+
+    return false;
+}
+
+/* process as many cycles as possible during the configured time */
+static void measure_cycles(const BenchmarkOptions* const opts, const NativePluginDescriptor* const engine,
+                           const NativePluginHandle handle, BenchmarkHost* const host,
+                           float** const ins, float** const outs,
+                           const NativeMidiEvent* const events, BenchmarkResult* const result)
+{
+    const uint32_t bufferSize = host->bufferSize;
+    const uint32_t numEvents = opts->eventsPerCycle;
+
+    /* warm up, also lets the engine publish one window of plugin DSP load statistics */
+    const uint64_t warmupCycles = (uint64_t)(SAMPLE_RATE / bufferSize) + 1;
+
+    for (uint64_t i=0; i<warmupCycles; ++i)
+    {
+        engine->process(handle, ins, outs, bufferSize, events, numEvents);
+        host->timeInfo.frame += bufferSize;
+    }
+
+    host->eventsOut = 0;
+
+    /* check the clock every few cycles only, big buffers are slow enough to do so on each one */
+    const uint64_t checkInterval = bufferSize >= 1024 ? 1 : 1024 / bufferSize;
+    const double start = get_time_seconds();
+    double elapsed = 0.0;
+    uint64_t cycles = 0;
+
+    while (elapsed < opts->seconds)
+    {
+        for (uint64_t i=0; i<checkInterval; ++i)
+        {
+            engine->process(handle, ins, outs, bufferSize, events, numEvents);
+            host->timeInfo.frame += bufferSize;
+        }
+
+        cycles += checkInterval;
+        elapsed = get_time_seconds() - start;
+    }
+
+    result->cycles = cycles;
+    result->seconds = elapsed;
+    result->nsPerCycle = elapsed * 1000000000.0 / (double)cycles;
+    result->eventsIn = cycles * numEvents;
+    result->eventsOut = host->eventsOut;
+}
+
+static bool run_benchmark(const BenchmarkOptions* const opts, const bool patchbay, const char* const label,
+                          const uint32_t numPlugins, const uint32_t bufferSize, BenchmarkResult* const result)
+{
+    const NativePluginDescriptor* const engine = patchbay ? carla_get_native_patchbay_plugin()
+                                                          : carla_get_native_rack_plugin();
+    if (engine == NULL)
+        return false;
+
+    BenchmarkHost* const host = (BenchmarkHost*)calloc(1, sizeof(BenchmarkHost));
+    if (host == NULL)
+        return false;
+
+    host->bufferSize = bufferSize;
+
+    const NativeHostDescriptor hostDescriptor = {
+        .handle = host,
+        .resourceDir = "",
+        .uiName = "",
+        .get_buffer_size = get_buffer_size,
+        .get_sample_rate = get_sample_rate,
+        .is_offline = is_offline,
+        .get_time_info = get_time_info,
+        .write_midi_event = write_midi_event,
+        .dispatcher = dispatcher
+    };
+
+    const uint32_t numEvents = opts->eventsPerCycle;
+    float* buffers[4] = { NULL, NULL, NULL, NULL };
+    NativeMidiEvent* events = NULL;
+    CarlaHostHandle hostHandle = NULL;
+    bool ok = false;
+
+    const NativePluginHandle handle = engine->instantiate(&hostDescriptor);
+    if (handle == NULL)
+        goto cleanup;
+
+    hostHandle = carla_create_native_plugin_host_handle(engine, handle);
+    if (hostHandle == NULL)
+        goto cleanup;
+
+    for (uint32_t i=0; i<numPlugins; ++i)
+    {
+        if (! carla_add_plugin(hostHandle, BINARY_NATIVE, PLUGIN_INTERNAL, "", "", label, 0, NULL, 0x0))
+        {
+            fprintf(stderr, "failed to add plugin '%s': %s\n", label, carla_get_last_error(hostHandle));
+            goto cleanup;
+        }
+    }
+
+    /* the empty graph gets the same engine input to output connections as the plugin chains */
+    if (patchbay)
+    {
+        carla_set_engine_callback(hostHandle, engine_callback, host);
+        carla_patchbay_refresh(hostHandle, false);
+        carla_set_engine_callback(hostHandle, NULL, NULL);
+
+        if (! connect_chain(hostHandle, host, numPlugins, false, "Audio Input", "Audio Output") ||
+            ! connect_chain(hostHandle, host, numPlugins, true, "Midi Input", "Midi Output"))
+        {
+            fprintf(stderr, "failed to connect patchbay graph for '%s'\n", label);
+            goto cleanup;
+        }
+    }
+
+    for (uint32_t i=0; i<4; ++i)
+    {
+        buffers[i] = (float*)calloc(bufferSize, sizeof(float));
+        if (buffers[i] == NULL)
+            goto cleanup;
+    }
+
+    /* low level noise as input, so nothing gets skipped because of silence */
+    for (uint32_t i=0; i<bufferSize; ++i)
+        buffers[0][i] = buffers[1][i] = (float)((i * 7919u) % 1000u) / 100000.0f;
+
+    if (numEvents != 0)
+    {
+        events = (NativeMidiEvent*)calloc(numEvents, sizeof(NativeMidiEvent));
+        if (events == NULL)
+            goto cleanup;
+
+        /* alternating note-on and note-off, spread across the cycle */
+        for (uint32_t i=0; i<numEvents; ++i)
+        {
+            events[i].time = (uint32_t)((uint64_t)i * bufferSize / numEvents);
+            events[i].size = 3;
+            events[i].data[0] = (uint8_t)((i % 2) == 0 ? 0x90 : 0x80);
+            events[i].data[1] = (uint8_t)(36 + (i / 2) % 64);
+            events[i].data[2] = 100;
+        }
+    }
+
+    {
+        float* ins[2] = { buffers[0], buffers[1] };
+        float* outs[2] = { buffers[2], buffers[3] };
+
+        engine->activate(handle);
+
+        if (patchbay && ! wait_for_graph(engine, handle, host, ins, outs, events, numEvents))
+            fprintf(stderr, "no audio output from patchbay graph for '%s', measuring anyway\n", label);
+
+        measure_cycles(opts, engine, handle, host, ins, outs, events, result);
+        engine->deactivate(handle);
+    }
+
+    /* engine measurements, average of all plugins */
+    result->pluginNsMeasured = 0.0;
+
+    for (uint32_t i=0; i<numPlugins; ++i)
+    {
+        const CarlaPluginProcessTimeInfo* const info = carla_get_plugin_process_time_info(hostHandle, i);
+
+        if (info != NULL)
+            result->pluginNsMeasured += (double)info->meanLoad / 100.0 * bufferSize / SAMPLE_RATE * 1000000000.0;
+    }
+
+    if (numPlugins != 0)
+        result->pluginNsMeasured /= numPlugins;
+
+    ok = true;
+
+cleanup:
+    if (handle != NULL)
+        engine->cleanup(handle);
+
+    if (hostHandle != NULL)
+        carla_host_handle_free(hostHandle);
+
+    for (uint32_t i=0; i<4; ++i)
+        free(buffers[i]);
+
+    free(events);
+    free(host);
+    return ok;
+}
+
+static void print_result(const BenchmarkOptions* const opts, const char* const mode, const char* const label,
+                         const uint32_t numPlugins, const uint32_t bufferSize,
+                         const BenchmarkResult* const result, const BenchmarkResult* const empty)
+{
+    const double cyclesPerSecond = (double)result->cycles / result->seconds;
+    const double pluginNs = numPlugins != 0 ? (result->nsPerCycle - empty->nsPerCycle) / numPlugins : 0.0;
+
+    fprintf(opts->out,
+            "{\"version\":\"%s\",\"mode\":\"%s\",\"plugin\":\"%s\",\"plugins\":%u,\"buffer_size\":%u,"
+            "\"sample_rate\":%.0f,\"cycles\":%llu,\"seconds\":%.4f,\"cycles_per_second\":%.1f,"
+            "\"ns_per_cycle\":%.1f,\"realtime_factor\":%.2f,\"ns_per_plugin\":%.1f,\"ns_per_plugin_measured\":%.1f,"
+            "\"events_per_cycle\":%u,\"events_in_per_second\":%.1f,\"events_out_per_second\":%.1f}\n",
+            CARLA_VERSION_STRING, mode, label, numPlugins, bufferSize,
+            SAMPLE_RATE, (unsigned long long)result->cycles, result->seconds, cyclesPerSecond,
+            result->nsPerCycle, cyclesPerSecond * bufferSize / SAMPLE_RATE, pluginNs, result->pluginNsMeasured,
+            opts->eventsPerCycle, (double)result->eventsIn / result->seconds,
+            (double)result->eventsOut / result->seconds);
+    fflush(opts->out);
+}
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * main */
+
+int main(int argc, char* argv[])
+{
+    static char defaultLabels[] = "audiogain,bypass,midithrough";
+    static char defaultCounts[] = "1,16";
+    static char defaultBufferSizes[] = "64,128,256,512,1024";
+
+    BenchmarkOptions opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.eventsPerCycle = 32;
+    opts.seconds = 0.5;
+    opts.out = stdout;
+
+    const char* outFilename = NULL;
+
+    for (int i=1; i<argc; ++i)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i+1 == argc)
+        {
+            fprintf(stderr, "usage: %s [-m rack|patchbay] [-p labels] [-n counts] [-b buffer-sizes] "
+                            "[-e events] [-t seconds] [-o file]\n", argv[0]);
+            return 1;
+        }
+
+        char* const value = argv[++i];
+
+        switch (argv[i-1][1])
+        {
+        case 'm':
+            if (opts.numModes < 2)
+                opts.modes[opts.numModes++] = value;
+            break;
+        case 'p':
+            opts.numLabels = parse_str_list(value, opts.labels);
+            break;
+        case 'n':
+            opts.numCounts = parse_uint_list(value, opts.counts);
+            break;
+        case 'b':
+            opts.numBufferSizes = parse_uint_list(value, opts.bufferSizes);
+            break;
+        case 'e':
+            opts.eventsPerCycle = (uint32_t)strtoul(value, NULL, 10);
+            break;
+        case 't':
+            opts.seconds = strtod(value, NULL);
+            break;
+        case 'o':
+            outFilename = value;
+            break;
+        default:
+            fprintf(stderr, "unknown option '%s'\n", argv[i-1]);
+            return 1;
+        }
+    }
+
+    if (opts.numModes == 0)
+    {
+        opts.modes[0] = "rack";
+        opts.modes[1] = "patchbay";
+        opts.numModes = 2;
+    }
+
+    if (opts.numLabels == 0)
+        opts.numLabels = parse_str_list(defaultLabels, opts.labels);
+    if (opts.numCounts == 0)
+        opts.numCounts = parse_uint_list(defaultCounts, opts.counts);
+    if (opts.numBufferSizes == 0)
+        opts.numBufferSizes = parse_uint_list(defaultBufferSizes, opts.bufferSizes);
+
+    if (opts.seconds <= 0.0)
+        opts.seconds = 0.5;
+
+    if (outFilename != NULL)
+    {
+        opts.out = fopen(outFilename, "w");
+
+        if (opts.out == NULL)
+        {
+            fprintf(stderr, "failed to open '%s' for writing\n", outFilename);
+            return 1;
+        }
+    }
+
+    int ret = 0;
+
+    for (uint32_t m=0; m<opts.numModes; ++m)
+    {
+        const bool patchbay = strcmp(opts.modes[m], "patchbay") == 0;
+
+        if (! patchbay && strcmp(opts.modes[m], "rack") != 0)
+        {
+            fprintf(stderr, "unknown mode '%s'\n", opts.modes[m]);
+            ret = 1;
+            continue;
+        }
+
+        for (uint32_t b=0; b<opts.numBufferSizes; ++b)
+        {
+            const uint32_t bufferSize = opts.bufferSizes[b];
+
+            /* empty graph, used as reference for per-plugin overhead */
+            BenchmarkResult empty;
+            memset(&empty, 0, sizeof(empty));
+
+            if (! run_benchmark(&opts, patchbay, "", 0, bufferSize, &empty))
+            {
+                ret = 1;
+                continue;
+            }
+
+            print_result(&opts, opts.modes[m], "", 0, bufferSize, &empty, &empty);
+
+            for (uint32_t p=0; p<opts.numLabels; ++p)
+            {
+                for (uint32_t n=0; n<opts.numCounts; ++n)
+                {
+                    const uint32_t maxPlugins = patchbay ? MAX_PATCHBAY_PLUGINS : MAX_RACK_PLUGINS;
+                    const uint32_t numPlugins = opts.counts[n] < maxPlugins ? opts.counts[n] : maxPlugins;
+
+                    BenchmarkResult result;
+                    memset(&result, 0, sizeof(result));
+
+                    if (! run_benchmark(&opts, patchbay, opts.labels[p], numPlugins, bufferSize, &result))
+                    {
+                        ret = 1;
+                        continue;
+                    }
+
+                    print_result(&opts, opts.modes[m], opts.labels[p], numPlugins, bufferSize, &result, &empty);
+                }
+            }
+        }
+    }
+
+    if (opts.out != stdout)
+        fclose(opts.out);
+
+    return ret;
+}
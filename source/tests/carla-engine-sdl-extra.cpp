@@ -23,3 +23,5 @@
 // #include "CarlaPipeUtils.cpp"
 #include "CarlaProcessUtils.cpp"
 #include "CarlaStateUtils.cpp"
+#include "CarlaBinaryProjectUtils.cpp"
+#include "CarlaXmlStreamUtils.cpp"
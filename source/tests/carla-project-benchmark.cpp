@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Compares project save/load times between the XML (*.carxp) and binary (*.carxb) formats,
+// using synthetic plugin states with large chunks. Also verifies conversion round-trips.
+// Like the other tests, only available through the Makefile: run `make -C source/tests carla-project-benchmark`
+// after building Carla, it is not part of the CMake build.
+
+#include "CarlaStateUtils.cpp"
+#include "CarlaBinaryProjectUtils.cpp"
+#include "CarlaXmlStreamUtils.cpp"
+
+#include "water/files/File.h"
+#include "water/xml/XmlDocument.h"
+
+#include <chrono>
+
+CARLA_BACKEND_USE_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+static const uint kNumPlugins = 16;
+static const std::size_t kChunkSize = 4 * 1024 * 1024;
+
+static double getTimeMs()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void fillChunk(CarlaStateSave& state, const uint seed)
+{
+    state.type = carla_strdup("VST2");
+    state.name = carla_strdup("Benchmark");
+    state.binary = carla_strdup("/tmp/benchmark.so");
+    state.label = carla_strdup("benchmark");
+
+    state.chunkData = new uint8_t[kChunkSize];
+    state.chunkDataSize = kChunkSize;
+
+    // half noise, half repeated patterns, similar to typical sampler or synth chunks
+    uint32_t value = seed * 2654435761u + 1;
+    for (std::size_t i = 0; i < kChunkSize; ++i)
+    {
+        if ((i / 4096) % 2 == 0)
+        {
+            value = value * 1664525u + 1013904223u;
+            state.chunkData[i] = static_cast<uint8_t>(value >> 24);
+        }
+        else
+        {
+            state.chunkData[i] = static_cast<uint8_t>(i % 64);
+        }
+    }
+}
+
+static void writeProjectDocument(water::MemoryOutputStream& out, CarlaStateSave* const states, CarlaBinaryProjectWriter* const writer)
+{
+    out << "<?xml version='1.0' encoding='UTF-8'?>\n";
+    out << "<!DOCTYPE CARLA-PROJECT>\n";
+    out << "<CARLA-PROJECT VERSION='2.5'>\n";
+
+    for (uint i = 0; i < kNumPlugins; ++i)
+    {
+        water::MemoryOutputStream streamPlugin;
+        states[i].dumpToMemoryStream(streamPlugin, writer);
+
+        out << " <Plugin>\n";
+        out << streamPlugin;
+        out << " </Plugin>\n";
+    }
+
+    out << "</CARLA-PROJECT>\n";
+}
+
+// load all plugin states and their chunks, returns number of bytes loaded
+static std::size_t loadProjectDocument(water::XmlDocument& xml, CarlaBinaryProjectReader* const reader)
+{
+    ScopedPointer<water::XmlElement> xmlElement(xml.getDocumentElement());
+    CARLA_SAFE_ASSERT_RETURN(xmlElement != nullptr, 0);
+
+    std::size_t loaded = 0;
+    CarlaStateSave state;
+
+    for (water::XmlElement* elem = xmlElement->getFirstChildElement(); elem != nullptr; elem = elem->getNextElement())
+    {
+        if (! elem->getTagName().equalsIgnoreCase("plugin"))
+            continue;
+
+        state.fillFromXmlElement(elem, reader);
+
+        // same as CarlaPlugin::loadStateSave
+        if (state.chunkData != nullptr)
+        {
+            loaded += state.chunkDataSize;
+        }
+        else if (state.chunk != nullptr)
+        {
+            std::vector<uint8_t> chunk;
+            d_getChunkFromBase64String_impl(chunk, state.chunk);
+            loaded += chunk.size();
+        }
+    }
+
+    return loaded;
+}
+
+// same as above, but reading plugins one by one like CarlaEngine::loadProjectInternal
+static std::size_t loadProjectStream(CarlaXmlStreamReader& xmlReader)
+{
+    ScopedPointer<water::XmlElement> xmlElement(xmlReader.readRootElement());
+    CARLA_SAFE_ASSERT_RETURN(xmlElement != nullptr, 0);
+
+    std::size_t loaded = 0;
+    CarlaStateSave state;
+
+    while (water::XmlElement* const elemPtr = xmlReader.readNextElement())
+    {
+        const ScopedPointer<water::XmlElement> elem(elemPtr);
+
+        if (! elem->getTagName().equalsIgnoreCase("plugin"))
+            continue;
+
+        state.fillFromXmlElement(elem);
+
+        if (state.chunk != nullptr)
+        {
+            std::vector<uint8_t> chunk;
+            d_getChunkFromBase64String_impl(chunk, state.chunk);
+            loaded += chunk.size();
+        }
+    }
+
+    return loaded;
+}
+
+static bool compareChunks(const water::File& file, CarlaStateSave* const states)
+{
+    const water::File tmpFile(file.getSiblingFile("carla-project-benchmark-check.carxp"));
+    CARLA_SAFE_ASSERT_RETURN(convertProjectFile(file, tmpFile), false);
+
+    water::XmlDocument xml(tmpFile);
+    ScopedPointer<water::XmlElement> xmlElement(xml.getDocumentElement());
+    CARLA_SAFE_ASSERT_RETURN(xmlElement != nullptr, false);
+
+    uint i = 0;
+    CarlaStateSave state;
+
+    for (water::XmlElement* elem = xmlElement->getFirstChildElement(); elem != nullptr; elem = elem->getNextElement())
+    {
+        CARLA_SAFE_ASSERT_RETURN(i < kNumPlugins, false);
+        CARLA_SAFE_ASSERT_RETURN(state.fillFromXmlElement(elem), false);
+
+        std::vector<uint8_t> chunk;
+        d_getChunkFromBase64String_impl(chunk, state.chunk);
+
+        CARLA_SAFE_ASSERT_RETURN(chunk.size() == states[i].chunkDataSize, false);
+        CARLA_SAFE_ASSERT_RETURN(std::memcmp(chunk.data(), states[i].chunkData, chunk.size()) == 0, false);
+        ++i;
+    }
+
+    tmpFile.deleteFile();
+    return i == kNumPlugins;
+}
+
+// -----------------------------------------------------------------------
+
+int main()
+{
+    CarlaStateSave states[kNumPlugins];
+
+    for (uint i = 0; i < kNumPlugins; ++i)
+        fillChunk(states[i], i);
+
+    const water::File tmpDir(water::File::getSpecialLocation(water::File::tempDirectory));
+    const water::File xmlFile(tmpDir.getChildFile("carla-project-benchmark.carxp"));
+    const water::File binFile(tmpDir.getChildFile("carla-project-benchmark.carxb"));
+
+    double start;
+
+    // XML
+    start = getTimeMs();
+    {
+        water::MemoryOutputStream out;
+        writeProjectDocument(out, states, nullptr);
+        CARLA_SAFE_ASSERT_RETURN(xmlFile.replaceWithData(out.getData(), out.getDataSize()), 1);
+    }
+    const double xmlSaveTime = getTimeMs() - start;
+
+    start = getTimeMs();
+    std::size_t xmlLoaded;
+    {
+        water::XmlDocument xml(xmlFile);
+        xmlLoaded = loadProjectDocument(xml, nullptr);
+    }
+    const double xmlLoadTime = getTimeMs() - start;
+
+    start = getTimeMs();
+    std::size_t xmlStreamLoaded;
+    {
+        CarlaXmlStreamReader xmlReader(xmlFile);
+        xmlStreamLoaded = loadProjectStream(xmlReader);
+    }
+    const double xmlStreamLoadTime = getTimeMs() - start;
+
+    // binary, without and with compression
+    double binSaveTimes[2], binLoadTimes[2];
+    std::size_t binLoaded[2], binSizes[2];
+
+    for (int compress = 0; compress < 2; ++compress)
+    {
+        start = getTimeMs();
+        {
+            water::MemoryOutputStream out;
+            CarlaBinaryProjectWriter writer(compress != 0);
+            writeProjectDocument(out, states, &writer);
+            CARLA_SAFE_ASSERT_RETURN(writer.writeToFile(binFile, out.getData(), out.getDataSize()), 1);
+        }
+        binSaveTimes[compress] = getTimeMs() - start;
+
+        start = getTimeMs();
+        {
+            CarlaBinaryProjectReader reader;
+            water::String document;
+            CARLA_SAFE_ASSERT_RETURN(reader.open(binFile) && reader.readDocument(document), 1);
+
+            water::XmlDocument xml(document);
+            binLoaded[compress] = loadProjectDocument(xml, &reader);
+        }
+        binLoadTimes[compress] = getTimeMs() - start;
+        binSizes[compress] = static_cast<std::size_t>(binFile.getSize());
+    }
+
+    CARLA_SAFE_ASSERT_RETURN(xmlLoaded == kNumPlugins * kChunkSize, 1);
+    CARLA_SAFE_ASSERT_RETURN(xmlStreamLoaded == kNumPlugins * kChunkSize, 1);
+    CARLA_SAFE_ASSERT_RETURN(binLoaded[0] == kNumPlugins * kChunkSize, 1);
+    CARLA_SAFE_ASSERT_RETURN(binLoaded[1] == kNumPlugins * kChunkSize, 1);
+
+    carla_stdout("%u plugins, %u KiB chunk each", kNumPlugins, static_cast<uint>(kChunkSize / 1024));
+    carla_stdout("XML:               save %8.2f ms, load %8.2f ms, %8u KiB",
+                 xmlSaveTime, xmlLoadTime, static_cast<uint>(xmlFile.getSize() / 1024));
+    carla_stdout("XML (streaming):                     load %8.2f ms", xmlStreamLoadTime);
+    carla_stdout("binary:            save %8.2f ms, load %8.2f ms, %8u KiB",
+                 binSaveTimes[0], binLoadTimes[0], static_cast<uint>(binSizes[0] / 1024));
+    carla_stdout("binary compressed: save %8.2f ms, load %8.2f ms, %8u KiB",
+                 binSaveTimes[1], binLoadTimes[1], static_cast<uint>(binSizes[1] / 1024));
+
+    // conversion round-trip, binary -> XML must give back the original chunks
+    {
+        const water::File convFile(tmpDir.getChildFile("carla-project-benchmark-conv.carxb"));
+        CARLA_SAFE_ASSERT_RETURN(convertProjectFile(xmlFile, convFile), 1);
+        CARLA_SAFE_ASSERT_RETURN(compareChunks(convFile, states), 1);
+        CARLA_SAFE_ASSERT_RETURN(compareChunks(binFile, states), 1);
+        convFile.deleteFile();
+    }
+
+    carla_stdout("conversion round-trip ok");
+
+    xmlFile.deleteFile();
+    binFile.deleteFile();
+    return 0;
+}
+
+// -----------------------------------------------------------------------
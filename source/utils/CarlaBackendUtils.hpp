@@ -314,6 +314,10 @@ const char* EngineCallbackOpcode2Str(const EngineCallbackOpcode opcode) noexcept
         return "ENGINE_CALLBACK_PATCHBAY_CLIENT_POSITION_CHANGED";
     case ENGINE_CALLBACK_EMBED_UI_RESIZED:
         return "ENGINE_CALLBACK_EMBED_UI_RESIZED";
+    case ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS:
+        return "ENGINE_CALLBACK_PROJECT_SAVE_PROGRESS";
+    case ENGINE_CALLBACK_PROJECT_SAVE_FINISHED:
+        return "ENGINE_CALLBACK_PROJECT_SAVE_FINISHED";
     }
 
     carla_stderr("CarlaBackend::EngineCallbackOpcode2Str(%i) - invalid opcode", opcode);
@@ -403,6 +407,20 @@ const char* EngineOption2Str(const EngineOption option) noexcept
         return "ENGINE_OPTION_CLIENT_NAME_PREFIX";
     case ENGINE_OPTION_PLUGINS_ARE_STANDALONE:
         return "ENGINE_OPTION_PLUGINS_ARE_STANDALONE";
+    case ENGINE_OPTION_SFZ_STREAMING_PRELOAD:
+        return "ENGINE_OPTION_SFZ_STREAMING_PRELOAD";
+    case ENGINE_OPTION_AUTOSAVE_INTERVAL:
+        return "ENGINE_OPTION_AUTOSAVE_INTERVAL";
+    case ENGINE_OPTION_MIN_SUB_BLOCK_SIZE:
+        return "ENGINE_OPTION_MIN_SUB_BLOCK_SIZE";
+    case ENGINE_OPTION_DOUBLE_PRECISION:
+        return "ENGINE_OPTION_DOUBLE_PRECISION";
+    case ENGINE_OPTION_OFFLINE_RENDER_FILE:
+        return "ENGINE_OPTION_OFFLINE_RENDER_FILE";
+    case ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE:
+        return "ENGINE_OPTION_OFFLINE_RENDER_MIDI_FILE";
+    case ENGINE_OPTION_OFFLINE_RENDER_LENGTH:
+        return "ENGINE_OPTION_OFFLINE_RENDER_LENGTH";
     }
 
     carla_stderr("CarlaBackend::EngineOption2Str(%i) - invalid option", option);
@@ -0,0 +1,495 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaBinaryProjectUtils.hpp"
+
+#include "extra/Base64.hpp"
+#include "extra/String.hpp"
+
+#include "water/files/FileInputStream.h"
+#include "water/files/FileOutputStream.h"
+#include "water/files/TemporaryFile.h"
+#include "water/xml/XmlDocument.h"
+#include "water/xml/XmlElement.h"
+
+#ifdef HAVE_ZLIB
+# include <zlib.h>
+#endif
+
+#include <algorithm>
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+
+// blobs smaller than this are always stored as-is
+static const std::size_t kMinimumCompressedBlobSize = 1024;
+
+// header plus index entry sizes, in bytes
+static const int64_t kHeaderSize     = 8 + 4 + 4 + 8;
+static const int64_t kIndexEntrySize = 8 + 8 + 8 + 4 + 4;
+
+// -----------------------------------------------------------------------
+// CarlaBinaryProjectWriter
+
+CarlaBinaryProjectWriter::CarlaBinaryProjectWriter(const bool compress) noexcept
+    : fBlobs(),
+      fCompress(compress),
+      fProgressCallback(nullptr),
+      fProgressCallbackPtr(nullptr)
+{
+    // index 0 is reserved for the project document
+    fBlobs.resize(1);
+}
+
+uint CarlaBinaryProjectWriter::addBlob(const void* const data, const std::size_t size)
+{
+    CARLA_SAFE_ASSERT_RETURN(data != nullptr || size == 0, 0);
+
+    fBlobs.push_back(Blob());
+
+    Blob& blob(fBlobs.back());
+    blob.size = size;
+    blob.compression = kCarlaBinaryProjectCompressionNone;
+    blob.data.resize(size);
+
+    if (size != 0)
+        std::memcpy(blob.data.data(), data, size);
+
+    return static_cast<uint>(fBlobs.size() - 1);
+}
+
+void CarlaBinaryProjectWriter::setProgressCallback(const ProgressCallback callback, void* const ptr) noexcept
+{
+    fProgressCallback = callback;
+    fProgressCallbackPtr = ptr;
+}
+
+bool CarlaBinaryProjectWriter::writeToFile(const water::File& file, const void* const document, const std::size_t documentSize)
+{
+    CARLA_SAFE_ASSERT_RETURN(document != nullptr && documentSize != 0, false);
+
+    Blob& documentBlob(fBlobs[0]);
+    documentBlob.size = documentSize;
+    documentBlob.compression = kCarlaBinaryProjectCompressionNone;
+    documentBlob.data.resize(documentSize);
+    std::memcpy(documentBlob.data.data(), document, documentSize);
+
+    std::size_t total = 0, done = 0;
+    for (const Blob& blob : fBlobs)
+        total += blob.data.size();
+
+    const water::TemporaryFile tmpFile(file);
+
+    {
+        water::FileOutputStream out(tmpFile.getFile());
+        CARLA_SAFE_ASSERT_RETURN(out.openedOk(), false);
+
+        // header, index offset is written once all blobs are in place
+        out.write(kCarlaBinaryProjectMagic, sizeof(kCarlaBinaryProjectMagic));
+        out.writeInt(static_cast<int>(kCarlaBinaryProjectVersion));
+        out.writeInt(static_cast<int>(fBlobs.size()));
+        out.writeInt64(0);
+
+        for (Blob& blob : fBlobs)
+        {
+            done += blob.data.size();
+
+            if (fCompress)
+                compressBlob(blob);
+
+            if (! blob.data.empty() && ! out.write(blob.data.data(), blob.data.size()))
+            {
+                carla_stderr2("CarlaBinaryProjectWriter::writeToFile() - failed to write blob data");
+                return false;
+            }
+
+            reportProgress(done, total);
+        }
+
+        const water::int64 indexOffset = out.getPosition();
+
+        uint64_t offset = kHeaderSize;
+        for (const Blob& blob : fBlobs)
+        {
+            out.writeInt64(static_cast<water::int64>(offset));
+            out.writeInt64(static_cast<water::int64>(blob.data.size()));
+            out.writeInt64(static_cast<water::int64>(blob.size));
+            out.writeInt(static_cast<int>(blob.compression));
+            out.writeInt(0);
+            offset += blob.data.size();
+        }
+
+        CARLA_SAFE_ASSERT_RETURN(out.setPosition(kHeaderSize - 8), false);
+        out.writeInt64(indexOffset);
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            carla_stderr2("CarlaBinaryProjectWriter::writeToFile() - failed to write file");
+            return false;
+        }
+    }
+
+    return tmpFile.overwriteTargetFileWithTemporary();
+}
+
+bool CarlaBinaryProjectWriter::writeToXmlFile(const water::File& file, const void* const document, const std::size_t documentSize)
+{
+    CARLA_SAFE_ASSERT_RETURN(document != nullptr && documentSize != 0, false);
+
+    static const char   kBlobStart[]    = "<ChunkBlob>";
+    static const char   kBlobEnd[]      = "</ChunkBlob>";
+    static const size_t kBlobStartSize  = sizeof(kBlobStart) - 1;
+    static const size_t kBlobEndSize    = sizeof(kBlobEnd) - 1;
+    static const size_t kLineWidth      = 120;
+
+    std::size_t total = documentSize, done = 0;
+    for (std::size_t i = 1; i < fBlobs.size(); ++i)
+        total += fBlobs[i].data.size();
+
+    const water::TemporaryFile tmpFile(file);
+
+    {
+        water::FileOutputStream out(tmpFile.getFile());
+        CARLA_SAFE_ASSERT_RETURN(out.openedOk(), false);
+
+        const char* const text = static_cast<const char*>(document);
+        const char* const textEnd = text + documentSize;
+        const char* pos = text;
+
+        for (;;)
+        {
+            const char* const blobStart = std::search(pos, textEnd, kBlobStart, kBlobStart + kBlobStartSize);
+            const char* const blobEnd = std::search(blobStart, textEnd, kBlobEnd, kBlobEnd + kBlobEndSize);
+
+            if (blobStart == textEnd || blobEnd == textEnd)
+                break;
+
+            out.write(pos, static_cast<std::size_t>(blobStart - pos));
+
+            const int index = water::String(blobStart + kBlobStartSize, static_cast<std::size_t>(blobEnd - blobStart - kBlobStartSize)).getIntValue();
+            CARLA_SAFE_ASSERT_RETURN(index > 0 && static_cast<std::size_t>(index) < fBlobs.size(), false);
+
+            const Blob& blob(fBlobs[static_cast<std::size_t>(index)]);
+            CARLA_SAFE_ASSERT_RETURN(blob.compression == kCarlaBinaryProjectCompressionNone, false);
+
+            // same layout as CarlaStateSave::dumpToMemoryStream
+            const String base64(String::asBase64(blob.data.data(), blob.data.size()));
+            const char* const base64Data = base64.buffer();
+            const std::size_t base64Size = base64.length();
+
+            out << "<Chunk>\n";
+            for (std::size_t i = 0; i < base64Size; i += kLineWidth)
+            {
+                if (i != 0)
+                    out.writeByte('\n');
+                out.write(base64Data + i, std::min(kLineWidth, base64Size - i));
+            }
+            out << "\n   </Chunk>";
+
+            pos = blobEnd + kBlobEndSize;
+            done += blob.data.size();
+            reportProgress(done, total);
+        }
+
+        out.write(pos, static_cast<std::size_t>(textEnd - pos));
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            carla_stderr2("CarlaBinaryProjectWriter::writeToXmlFile() - failed to write file");
+            return false;
+        }
+    }
+
+    reportProgress(total, total);
+    return tmpFile.overwriteTargetFileWithTemporary();
+}
+
+void CarlaBinaryProjectWriter::compressBlob(Blob& blob)
+{
+#ifdef HAVE_ZLIB
+    const std::size_t size = blob.data.size();
+
+    if (blob.compression != kCarlaBinaryProjectCompressionNone || size < kMinimumCompressedBlobSize)
+        return;
+    if (size != static_cast<uLong>(size))
+        return;
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(size));
+    std::vector<uint8_t> compressed(compressedSize);
+
+    // favor speed over size
+    if (compress2(compressed.data(), &compressedSize,
+                  blob.data.data(), static_cast<uLong>(size), Z_BEST_SPEED) == Z_OK
+        && compressedSize < size - size / 10)
+    {
+        compressed.resize(compressedSize);
+        blob.data.swap(compressed);
+        blob.compression = kCarlaBinaryProjectCompressionZlib;
+    }
+#else
+    // unused
+    (void)blob;
+#endif
+}
+
+void CarlaBinaryProjectWriter::reportProgress(const std::size_t done, const std::size_t total) const
+{
+    if (fProgressCallback != nullptr && total != 0)
+        fProgressCallback(fProgressCallbackPtr, static_cast<float>(static_cast<double>(done) / static_cast<double>(total)));
+}
+
+// -----------------------------------------------------------------------
+// CarlaBinaryProjectReader
+
+CarlaBinaryProjectReader::CarlaBinaryProjectReader() noexcept
+    : fStream(),
+      fIndex() {}
+
+CarlaBinaryProjectReader::~CarlaBinaryProjectReader()
+{
+}
+
+bool CarlaBinaryProjectReader::open(const water::File& file)
+{
+    fIndex.clear();
+    fStream = new water::FileInputStream(file);
+
+    if (fStream->failedToOpen())
+    {
+        fStream = nullptr;
+        return false;
+    }
+
+    const water::int64 totalLength = fStream->getTotalLength();
+
+    char magic[sizeof(kCarlaBinaryProjectMagic)];
+    CARLA_SAFE_ASSERT_RETURN(totalLength >= kHeaderSize, false);
+    CARLA_SAFE_ASSERT_RETURN(fStream->read(magic, sizeof(magic)) == sizeof(magic), false);
+    CARLA_SAFE_ASSERT_RETURN(std::memcmp(magic, kCarlaBinaryProjectMagic, sizeof(magic)) == 0, false);
+
+    const uint32_t version = static_cast<uint32_t>(fStream->readInt());
+
+    if (version > kCarlaBinaryProjectVersion)
+    {
+        carla_stderr2("CarlaBinaryProjectReader::open() - unsupported version %u", version);
+        return false;
+    }
+
+    const uint32_t blobCount = static_cast<uint32_t>(fStream->readInt());
+    const water::int64 indexOffset = fStream->readInt64();
+
+    CARLA_SAFE_ASSERT_RETURN(blobCount != 0, false);
+    CARLA_SAFE_ASSERT_RETURN(indexOffset >= kHeaderSize, false);
+    CARLA_SAFE_ASSERT_RETURN(indexOffset + blobCount * kIndexEntrySize <= totalLength, false);
+    CARLA_SAFE_ASSERT_RETURN(fStream->setPosition(indexOffset), false);
+
+    fIndex.resize(blobCount);
+
+    for (IndexEntry& entry : fIndex)
+    {
+        entry.offset = static_cast<uint64_t>(fStream->readInt64());
+        entry.storedSize = static_cast<uint64_t>(fStream->readInt64());
+        entry.size = static_cast<uint64_t>(fStream->readInt64());
+        entry.compression = static_cast<uint32_t>(fStream->readInt());
+        fStream->readInt();
+
+        if (entry.offset + entry.storedSize > static_cast<uint64_t>(indexOffset))
+        {
+            carla_stderr2("CarlaBinaryProjectReader::open() - invalid index entry");
+            fIndex.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CarlaBinaryProjectReader::readDocument(water::String& document)
+{
+    std::vector<uint8_t> data;
+
+    if (! readBlob(0, data))
+        return false;
+
+    document = water::String::fromUTF8(reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()));
+    return true;
+}
+
+bool CarlaBinaryProjectReader::readBlob(const uint index, std::vector<uint8_t>& data)
+{
+    CARLA_SAFE_ASSERT_RETURN(fStream != nullptr, false);
+    CARLA_SAFE_ASSERT_UINT2_RETURN(index < fIndex.size(), index, fIndex.size(), false);
+
+    const IndexEntry& entry(fIndex[index]);
+
+    std::vector<uint8_t> storedData;
+    std::vector<uint8_t>& readData(entry.compression == kCarlaBinaryProjectCompressionNone ? data : storedData);
+
+    readData.resize(static_cast<std::size_t>(entry.storedSize));
+    CARLA_SAFE_ASSERT_RETURN(fStream->setPosition(static_cast<water::int64>(entry.offset)), false);
+
+    for (std::size_t done = 0; done < readData.size();)
+    {
+        const int r = fStream->read(readData.data() + done,
+                                    static_cast<int>(std::min<std::size_t>(readData.size() - done, 0x40000000)));
+
+        if (r <= 0)
+        {
+            carla_stderr2("CarlaBinaryProjectReader::readBlob(%u) - failed to read data", index);
+            return false;
+        }
+
+        done += static_cast<std::size_t>(r);
+    }
+
+    switch (entry.compression)
+    {
+    case kCarlaBinaryProjectCompressionNone:
+        return true;
+
+#ifdef HAVE_ZLIB
+    case kCarlaBinaryProjectCompressionZlib: {
+        CARLA_SAFE_ASSERT_RETURN(entry.size == static_cast<uLong>(entry.size), false);
+
+        uLongf size = static_cast<uLongf>(entry.size);
+        data.resize(static_cast<std::size_t>(entry.size));
+
+        if (uncompress(data.data(), &size, storedData.data(), static_cast<uLong>(storedData.size())) == Z_OK
+            && size == entry.size)
+            return true;
+
+        carla_stderr2("CarlaBinaryProjectReader::readBlob(%u) - failed to decompress data", index);
+        return false;
+    }
+#endif
+    }
+
+    carla_stderr2("CarlaBinaryProjectReader::readBlob(%u) - unsupported compression %u", index, entry.compression);
+    return false;
+}
+
+uint CarlaBinaryProjectReader::getBlobCount() const noexcept
+{
+    return static_cast<uint>(fIndex.size());
+}
+
+// -----------------------------------------------------------------------
+
+bool isBinaryProjectFile(const water::File& file)
+{
+    water::FileInputStream stream(file);
+
+    if (stream.failedToOpen())
+        return false;
+
+    char magic[sizeof(kCarlaBinaryProjectMagic)];
+    return stream.read(magic, sizeof(magic)) == sizeof(magic)
+        && std::memcmp(magic, kCarlaBinaryProjectMagic, sizeof(magic)) == 0;
+}
+
+// -----------------------------------------------------------------------
+// convertProjectFile
+
+static bool convertPluginChunks(water::XmlElement* const xmlPlugin,
+                                CarlaBinaryProjectWriter* const writer,
+                                CarlaBinaryProjectReader* const reader)
+{
+    water::XmlElement* const xmlData = xmlPlugin->getChildByName("Data");
+
+    if (xmlData == nullptr)
+        return true;
+
+    std::vector<uint8_t> chunk;
+
+    if (writer != nullptr)
+    {
+        water::XmlElement* const xmlChunk = xmlData->getChildByName("Chunk");
+
+        if (xmlChunk == nullptr)
+            return true;
+
+        d_getChunkFromBase64String_impl(chunk, xmlChunk->getAllSubText().trim().toRawUTF8());
+
+        water::XmlElement* const xmlBlob = new water::XmlElement("ChunkBlob");
+        xmlBlob->addTextElement(water::String(writer->addBlob(chunk.data(), chunk.size())));
+        return xmlData->replaceChildElement(xmlChunk, xmlBlob);
+    }
+    else
+    {
+        water::XmlElement* const xmlBlob = xmlData->getChildByName("ChunkBlob");
+
+        if (xmlBlob == nullptr)
+            return true;
+
+        const int index = xmlBlob->getAllSubText().trim().getIntValue();
+        CARLA_SAFE_ASSERT_RETURN(index > 0, false);
+
+        if (! reader->readBlob(static_cast<uint>(index), chunk))
+            return false;
+
+        water::XmlElement* const xmlChunk = new water::XmlElement("Chunk");
+        xmlChunk->addTextElement(water::String(String::asBase64(chunk.data(), chunk.size()).buffer()));
+        return xmlData->replaceChildElement(xmlBlob, xmlChunk);
+    }
+}
+
+bool convertProjectFile(const water::File& source, const water::File& target)
+{
+    CARLA_SAFE_ASSERT_RETURN(source.existsAsFile(), false);
+
+    const bool toBinary = ! isBinaryProjectFile(source);
+
+    CarlaBinaryProjectReader reader;
+    CarlaBinaryProjectWriter writer(true);
+    ScopedPointer<water::XmlElement> xmlElement;
+
+    if (toBinary)
+    {
+        water::XmlDocument xml(source);
+        xmlElement = xml.getDocumentElement();
+    }
+    else
+    {
+        water::String document;
+        CARLA_SAFE_ASSERT_RETURN(reader.open(source), false);
+        CARLA_SAFE_ASSERT_RETURN(reader.readDocument(document), false);
+
+        water::XmlDocument xml(document);
+        xmlElement = xml.getDocumentElement();
+    }
+
+    CARLA_SAFE_ASSERT_RETURN(xmlElement != nullptr, false);
+
+    const water::String& xmlType(xmlElement->getTagName());
+
+    if (xmlType.equalsIgnoreCase("carla-preset"))
+    {
+        if (! convertPluginChunks(xmlElement, toBinary ? &writer : nullptr, &reader))
+            return false;
+    }
+    else
+    {
+        CARLA_SAFE_ASSERT_RETURN(xmlType.equalsIgnoreCase("carla-project"), false);
+
+        for (water::XmlElement* elem = xmlElement->getFirstChildElement(); elem != nullptr; elem = elem->getNextElement())
+        {
+            if (elem->getTagName().equalsIgnoreCase("plugin"))
+                if (! convertPluginChunks(elem, toBinary ? &writer : nullptr, &reader))
+                    return false;
+        }
+    }
+
+    const water::String document(xmlElement->createDocument("<!DOCTYPE " + xmlType + ">"));
+
+    if (toBinary)
+        return writer.writeToFile(target, document.toRawUTF8(), document.getNumBytesAsUTF8());
+
+    return target.replaceWithText(document);
+}
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_BINARY_PROJECT_UTILS_HPP_INCLUDED
+#define CARLA_BINARY_PROJECT_UTILS_HPP_INCLUDED
+
+#include "CarlaBackend.h"
+#include "CarlaUtils.hpp"
+
+#include "extra/ScopedPointer.hpp"
+
+#include "water/text/String.h"
+
+#include <vector>
+
+namespace water {
+class File;
+class FileInputStream;
+}
+
+CARLA_BACKEND_START_NAMESPACE
+
+// -----------------------------------------------------------------------
+// Binary project container (*.carxb)
+//
+// Contains the same project document as a *.carxp file, but with plugin chunks
+// stored as raw (and optionally compressed) blobs outside of the XML text.
+// The document references them by index, using a <ChunkBlob> element instead of <Chunk>.
+//
+// All values are little-endian:
+//  - header: 8 byte magic, uint32 version, uint32 blob count, uint64 index offset
+//  - blob data, one after the other, blob 0 being the project document
+//  - index: per blob uint64 offset, uint64 stored size, uint64 size, uint32 compression, uint32 reserved
+
+static const char        kCarlaBinaryProjectMagic[8]  = { 'C','A','R','L','A','B','I','N' };
+static const uint32_t    kCarlaBinaryProjectVersion   = 1;
+static const char* const kCarlaBinaryProjectExtension = "carxb";
+
+enum CarlaBinaryProjectCompression {
+    kCarlaBinaryProjectCompressionNone = 0,
+    kCarlaBinaryProjectCompressionZlib = 1
+};
+
+// -----------------------------------------------------------------------
+
+class CarlaBinaryProjectWriter
+{
+public:
+    typedef void (*ProgressCallback)(void* ptr, float progress);
+
+    // compression makes files a lot smaller, but saving is much slower
+    explicit CarlaBinaryProjectWriter(bool compress = false) noexcept;
+
+    // store a copy of a blob, returning the index to be referenced from the document
+    uint addBlob(const void* data, std::size_t size);
+
+    // called while writing with progress in 0.0 to 1.0 range, from the same thread
+    void setProgressCallback(ProgressCallback callback, void* ptr) noexcept;
+
+    // write project document plus all previously added blobs, compressing them now if needed
+    bool writeToFile(const water::File& file, const void* document, std::size_t documentSize);
+
+    // write project document as plain XML, with blob references replaced by their base64 encoded <Chunk>
+    bool writeToXmlFile(const water::File& file, const void* document, std::size_t documentSize);
+
+private:
+    struct Blob {
+        std::vector<uint8_t> data;
+        uint64_t size;
+        uint32_t compression;
+    };
+
+    std::vector<Blob> fBlobs;
+    const bool fCompress;
+
+    ProgressCallback fProgressCallback;
+    void* fProgressCallbackPtr;
+
+    void compressBlob(Blob& blob);
+    void reportProgress(std::size_t done, std::size_t total) const;
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaBinaryProjectWriter)
+};
+
+// -----------------------------------------------------------------------
+
+class CarlaBinaryProjectReader
+{
+public:
+    CarlaBinaryProjectReader() noexcept;
+    ~CarlaBinaryProjectReader();
+
+    // read header and index, blobs are only read on request
+    bool open(const water::File& file);
+
+    bool readDocument(water::String& document);
+    bool readBlob(uint index, std::vector<uint8_t>& data);
+
+    uint getBlobCount() const noexcept;
+
+private:
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t size;
+        uint32_t compression;
+    };
+
+    ScopedPointer<water::FileInputStream> fStream;
+    std::vector<IndexEntry> fIndex;
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaBinaryProjectReader)
+};
+
+// -----------------------------------------------------------------------
+
+// check for the binary project magic at the start of a file
+bool isBinaryProjectFile(const water::File& file);
+
+// convert a project between *.carxp and *.carxb, the direction is given by the source file contents
+// binary files created this way use compression if available, as they are meant for storage
+bool convertProjectFile(const water::File& source, const water::File& target);
+
+// -----------------------------------------------------------------------
+
+CARLA_BACKEND_END_NAMESPACE
+
+#endif // CARLA_BINARY_PROJECT_UTILS_HPP_INCLUDED
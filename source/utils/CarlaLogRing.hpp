@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_LOG_RING_HPP_INCLUDED
+#define CARLA_LOG_RING_HPP_INCLUDED
+
+#include "CarlaUtils.hpp"
+
+// -----------------------------------------------------------------------
+// CarlaLogRing
+//
+// Fixed-size lock-free queue of log messages, with many producers and a single consumer.
+// Producers never block nor allocate, messages are formatted directly into their slot.
+// When the ring is full new messages are dropped and counted, long messages are truncated.
+// Messages below the minimum level are discarded before being formatted.
+
+class CarlaLogRing
+{
+public:
+    static const uint32_t kNumSlots    = 256; // must be power of 2
+    static const uint32_t kMessageSize = 512;
+
+    struct Message {
+        int level;
+        char text[kMessageSize];
+    };
+
+    CarlaLogRing() noexcept
+        : fWritePos(0),
+          fReadPos(0),
+          fMinimumLevel(kCarlaLogLevelDebug),
+          fDropped(0)
+    {
+        for (uint32_t i=0; i<kNumSlots; ++i)
+            fSlots[i].sequence = i;
+    }
+
+    void setMinimumLevel(const int level) noexcept
+    {
+        __atomic_store_n(&fMinimumLevel, level, __ATOMIC_RELAXED);
+    }
+
+    bool isLevelEnabled(const int level) const noexcept
+    {
+        return level >= __atomic_load_n(&fMinimumLevel, __ATOMIC_RELAXED);
+    }
+
+    // can be called from any thread, returns false if the message was filtered out or dropped
+    bool push(const int level, const char* const fmt, va_list args) noexcept
+    {
+        if (! isLevelEnabled(level))
+            return false;
+
+        uint32_t pos = __atomic_load_n(&fWritePos, __ATOMIC_RELAXED);
+        Slot* slot;
+
+        for (;;)
+        {
+            slot = &fSlots[pos & (kNumSlots - 1)];
+
+            const uint32_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+            const int32_t diff = static_cast<int32_t>(seq - pos);
+
+            if (diff == 0)
+            {
+                if (__atomic_compare_exchange_n(&fWritePos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // full
+                __atomic_add_fetch(&fDropped, 1, __ATOMIC_RELAXED);
+                return false;
+            }
+            else
+            {
+                pos = __atomic_load_n(&fWritePos, __ATOMIC_RELAXED);
+            }
+        }
+
+        slot->message.level = level;
+
+        if (std::vsnprintf(slot->message.text, kMessageSize, fmt, args) < 0)
+            slot->message.text[0] = '\0';
+
+        __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // must only be called from a single thread, returns false if there is nothing to read
+    bool pop(Message& message) noexcept
+    {
+        Slot& slot(fSlots[fReadPos & (kNumSlots - 1)]);
+
+        if (__atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE) != fReadPos + 1)
+            return false;
+
+        std::memcpy(&message, &slot.message, sizeof(Message));
+
+        __atomic_store_n(&slot.sequence, fReadPos + kNumSlots, __ATOMIC_RELEASE);
+        ++fReadPos;
+        return true;
+    }
+
+    // number of messages dropped since the last call
+    uint32_t takeDroppedCount() noexcept
+    {
+        return __atomic_exchange_n(&fDropped, 0, __ATOMIC_RELAXED);
+    }
+
+private:
+    struct Slot {
+        uint32_t sequence;
+        Message message;
+    };
+
+    Slot fSlots[kNumSlots];
+    uint32_t fWritePos;
+    uint32_t fReadPos;
+    int fMinimumLevel;
+    uint32_t fDropped;
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaLogRing)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // CARLA_LOG_RING_HPP_INCLUDED
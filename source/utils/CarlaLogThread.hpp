@@ -5,6 +5,7 @@
 #define CARLA_LOG_THREAD_HPP_INCLUDED
 
 #include "CarlaBackend.h"
+#include "CarlaLogRing.hpp"
 #include "CarlaThread.hpp"
 
 #include <fcntl.h>
@@ -20,6 +21,14 @@ using CARLA_BACKEND_NAMESPACE::EngineCallbackFunc;
 
 // -----------------------------------------------------------------------
 // Log thread
+//
+// Carla's own messages are sent through a lock-free log ring, so printing never blocks the calling thread.
+// Anything else written to stdout/stderr (plugins, libraries) is redirected into a non-blocking pipe.
+// Both are read every 20ms and passed to the engine callback as ENGINE_CALLBACK_DEBUG,
+// with the log level as value1 (pipe output is considered info level).
+//
+// The minimum log level can be set with the CARLA_LOG_LEVEL environment variable,
+// using "debug", "info", "warning" or "error".
 
 class CarlaLogThread : private CarlaThread
 {
@@ -29,7 +38,9 @@ public:
           fStdOut(-1),
           fStdErr(-1),
           fCallback(nullptr),
-          fCallbackPtr(nullptr) {}
+          fCallbackPtr(nullptr),
+          fRing(),
+          fMessage() {}
 
     ~CarlaLogThread()
     {
@@ -61,6 +72,7 @@ public:
        #else
         CARLA_SAFE_ASSERT_RETURN(pipe(fPipe) == 0,);
 
+        // only the read side is non-blocking, the write side becomes stdout/stderr for the whole process
         if (fcntl(fPipe[0], F_SETFL, O_NONBLOCK) != 0)
         {
             close(fPipe[0]);
@@ -79,6 +91,9 @@ public:
         dup2(pipe1, stdout_fileno);
         dup2(pipe1, stderr_fileno);
 
+        fRing.setMinimumLevel(getMinimumLevelFromEnv());
+        carla_set_log_hook(_logHook, this);
+
         startThread();
     }
 
@@ -87,6 +102,10 @@ public:
         if (fStdOut == -1)
             return;
 
+        // also waits for any message still being added to the ring
+        if (carla_get_log_hook_ptr() == this)
+            carla_set_log_hook(nullptr, nullptr);
+
         stopThread(5000);
 
         std::fflush(stdout);
@@ -138,6 +157,8 @@ protected:
 
         while (! shouldThreadExit())
         {
+            processRing();
+
             bufRead[0] = '\0';
 
             while ((r = read(fPipe[0], bufRead, 1024)) > 0)
@@ -172,7 +193,8 @@ protected:
                     bufTemp[0] = '\0';
                     bufTempPos = 0;
 
-                    fCallback(fCallbackPtr, CARLA_BACKEND_NAMESPACE::ENGINE_CALLBACK_DEBUG, 0, 0, 0, 0, 0.0f, bufSend);
+                    fCallback(fCallbackPtr, CARLA_BACKEND_NAMESPACE::ENGINE_CALLBACK_DEBUG,
+                              0, kCarlaLogLevelInfo, 0, 0, 0.0f, bufSend);
                 }
 
                 if (lastRead > 0 && lastRead != r)
@@ -186,6 +208,8 @@ protected:
 
             d_msleep(20);
         }
+
+        processRing();
     }
 
 private:
@@ -201,6 +225,50 @@ private:
     EngineCallbackFunc fCallback;
     void*              fCallbackPtr;
 
+    CarlaLogRing fRing;
+    CarlaLogRing::Message fMessage;
+
+    void processRing()
+    {
+        char bufSend[CarlaLogRing::kMessageSize + 32];
+
+        while (fRing.pop(fMessage))
+        {
+            std::snprintf(bufSend, sizeof(bufSend), "[carla] %s", fMessage.text);
+            fCallback(fCallbackPtr, CARLA_BACKEND_NAMESPACE::ENGINE_CALLBACK_DEBUG,
+                      0, fMessage.level, 0, 0, 0.0f, bufSend);
+        }
+
+        if (const uint32_t dropped = fRing.takeDroppedCount())
+        {
+            std::snprintf(bufSend, sizeof(bufSend), "[carla] %u log messages dropped", dropped);
+            fCallback(fCallbackPtr, CARLA_BACKEND_NAMESPACE::ENGINE_CALLBACK_DEBUG,
+                      0, kCarlaLogLevelWarning, 0, 0, 0.0f, bufSend);
+        }
+    }
+
+    static int getMinimumLevelFromEnv()
+    {
+        if (const char* const level = std::getenv("CARLA_LOG_LEVEL"))
+        {
+            if (std::strcmp(level, "info") == 0)
+                return kCarlaLogLevelInfo;
+            if (std::strcmp(level, "warning") == 0)
+                return kCarlaLogLevelWarning;
+            if (std::strcmp(level, "error") == 0)
+                return kCarlaLogLevelError;
+        }
+
+        return kCarlaLogLevelDebug;
+    }
+
+    static bool _logHook(void* const ptr, const int level, const char* const fmt, va_list args)
+    {
+        // messages are always considered handled, even when filtered out or dropped
+        static_cast<CarlaLogThread*>(ptr)->fRing.push(level, fmt, args);
+        return true;
+    }
+
    #ifdef CARLA_OS_WIN
     ssize_t read(const HANDLE pipeh, void* const buf, DWORD numBytes)
     {
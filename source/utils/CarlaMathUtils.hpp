@@ -234,6 +234,81 @@ void carla_zeroFloats(float floats[], const std::size_t count) noexcept
     std::memset(floats, 0, count*sizeof(float));
 }
 
+/*
+ * Add double array values to another double array.
+ */
+static inline
+void carla_addDoubles(double dest[], const double src[], const std::size_t count) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(dest != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(src != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(count > 0,);
+
+    for (std::size_t i=0; i<count; ++i)
+    {
+       #ifdef __GNUC__
+        if (!std::isfinite(dest[i]))
+            __builtin_unreachable();
+        if (!std::isfinite(src[i]))
+            __builtin_unreachable();
+       #endif
+        dest[i] += src[i];
+    }
+}
+
+/*
+ * Copy double array values to another double array.
+ */
+static inline
+void carla_copyDoubles(double dest[], const double src[], const std::size_t count) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(dest != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(src != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(count > 0,);
+
+    std::memcpy(dest, src, count*sizeof(double));
+}
+
+/*
+ * Clear a double array.
+ */
+static inline
+void carla_zeroDoubles(double doubles[], const std::size_t count) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(doubles != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(count > 0,);
+
+    std::memset(doubles, 0, count*sizeof(double));
+}
+
+/*
+ * Convert float array values into a double array.
+ */
+static inline
+void carla_convertFloatsToDoubles(double dest[], const float src[], const std::size_t count) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(dest != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(src != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(count > 0,);
+
+    for (std::size_t i=0; i<count; ++i)
+        dest[i] = static_cast<double>(src[i]);
+}
+
+/*
+ * Convert double array values into a float array.
+ */
+static inline
+void carla_convertDoublesToFloats(float dest[], const double src[], const std::size_t count) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(dest != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(src != nullptr,);
+    CARLA_SAFE_ASSERT_RETURN(count > 0,);
+
+    for (std::size_t i=0; i<count; ++i)
+        dest[i] = static_cast<float>(src[i]);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 /*
@@ -281,6 +356,36 @@ float carla_findMaxNormalizedFloat(const float floats[], const std::size_t count
     return maxf2;
 }
 
+/*
+ * Find the highest absolute and normalized value within a double array.
+ */
+static inline
+float carla_findMaxNormalizedDouble(const double doubles[], const std::size_t count)
+{
+    CARLA_SAFE_ASSERT_RETURN(doubles != nullptr, 0.f);
+    CARLA_SAFE_ASSERT_RETURN(count > 0, 0.f);
+
+    double tmp, maxd2 = std::abs(doubles[0]);
+
+    for (std::size_t i=1; i<count; ++i)
+    {
+       #ifdef __GNUC__
+        if (!std::isfinite(doubles[i]))
+            __builtin_unreachable();
+       #endif
+
+        tmp = std::abs(doubles[i]);
+
+        if (tmp > maxd2)
+            maxd2 = tmp;
+    }
+
+    if (maxd2 > 1.0)
+        maxd2 = 1.0;
+
+    return static_cast<float>(maxd2);
+}
+
 /*
  * Multiply an array with a fixed value, float-specific version.
  */
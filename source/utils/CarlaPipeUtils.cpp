@@ -345,12 +345,37 @@ bool startProcess(const char* const argv[], pid_t& pidinst) noexcept
 }
 #endif
 
+// -----------------------------------------------------------------------
+// binary mode
+//
+// Used instead of text lines when both sides of the pipe allow it.
+// The server asks for it through an environment variable when starting the client process,
+// the client accepts by sending kPipeBinaryModeAck before the usual first message.
+// After that each "line" is sent as a frame, made of a 2 x uint32_t header (size and type) followed by size bytes.
+
+static const char* const kPipeBinaryModeEnvVar = "CARLA_PIPE_BINARY";
+static const char kPipeBinaryModeAck = 'B';
+
+// max size of a single frame, anything bigger means the stream is broken
+static const uint32_t kPipeFrameMaxSize = 0x10000000;
+
+// max number of values packed in a single controls frame
+static const uint32_t kPipeFrameMaxControls = 128;
+
+enum PipeFrameType {
+    kPipeFrameString   = 1, // text line, without the final newline
+    kPipeFrameInt      = 2, // int64_t
+    kPipeFrameFloat    = 3, // double
+    kPipeFrameControls = 4  // list of "control" messages, each as uint32_t index + float value
+};
+
 // -----------------------------------------------------------------------
 // waitForClientFirstMessage
 
 template<typename P>
 static inline
-bool waitForClientFirstMessage(const P& pipe, void* const ovRecv, void* const process, const uint32_t timeOutMilliseconds) noexcept
+bool waitForClientFirstMessage(const P& pipe, void* const ovRecv, void* const process, const uint32_t timeOutMilliseconds,
+                               bool* const binaryMode) noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pipe != INVALID_PIPE_VALUE, false);
     CARLA_SAFE_ASSERT_RETURN(timeOutMilliseconds > 0, false);
@@ -380,6 +405,12 @@ bool waitForClientFirstMessage(const P& pipe, void* const ovRecv, void* const pr
             if (c == '\n')
                 return true;
 
+            if (c == kPipeBinaryModeAck && binaryMode != nullptr && ! *binaryMode)
+            {
+                *binaryMode = true;
+                continue;
+            }
+
             carla_stderr("waitForClientFirstMessage() - read has wrong first char '%c'", c);return false;
             return false;
 
@@ -598,6 +629,23 @@ struct CarlaPipeCommon::PrivateData {
     mutable char   tmpBuf[0xffff];
     mutable String tmpStr;
 
+    // binary mode, negotiated when starting the pipe
+    bool binaryModeAllowed;
+    bool binaryMode;
+
+    // current frame being read, might arrive in several pieces
+    uint32_t frameHeader[2];
+    uint32_t frameHeaderPos;
+    uint32_t frameDataPos;
+    uint32_t frameType;
+    uint32_t frameSize;
+    uint32_t frameCapacity;
+    char* frameData;
+
+    // current value of a controls frame, while dispatching it as "control" messages
+    const char* controlData;
+    uint32_t controlPos;
+
     PrivateData() noexcept
 #ifdef CARLA_OS_WIN
         : processInfo(),
@@ -613,7 +661,18 @@ struct CarlaPipeCommon::PrivateData {
           isServer(false),
           writeLock(),
           tmpBuf(),
-          tmpStr()
+          tmpStr(),
+          binaryModeAllowed(false),
+          binaryMode(false),
+          frameHeader(),
+          frameHeaderPos(0),
+          frameDataPos(0),
+          frameType(0),
+          frameSize(0),
+          frameCapacity(0),
+          frameData(nullptr),
+          controlData(nullptr),
+          controlPos(0)
     {
 #ifdef CARLA_OS_WIN
         carla_zeroStruct(processInfo);
@@ -627,6 +686,39 @@ struct CarlaPipeCommon::PrivateData {
         carla_zeroChars(tmpBuf, 0xffff);
     }
 
+    ~PrivateData() noexcept
+    {
+        std::free(frameData);
+    }
+
+    // get the last frame read in binary mode as a text line, like it would be in text mode
+    const char* getFrameAsLine() noexcept
+    {
+        switch (frameType)
+        {
+        case kPipeFrameString:
+            return frameData;
+
+        case kPipeFrameInt: {
+            int64_t value;
+            std::memcpy(&value, frameData, sizeof(value));
+            std::snprintf(tmpBuf, 0xfe, P_INT64, value);
+            return tmpBuf;
+        }
+
+        case kPipeFrameFloat: {
+            double value;
+            std::memcpy(&value, frameData, sizeof(value));
+            const ScopedSafeLocale ssl;
+            std::snprintf(tmpBuf, 0xfe, "%.12g", value);
+            return tmpBuf;
+        }
+        }
+
+        carla_stderr2("CarlaPipeCommon - unexpected frame type %u", frameType);
+        return nullptr;
+    }
+
     CARLA_DECLARE_NON_COPYABLE(PrivateData)
 };
 
@@ -658,13 +750,61 @@ void CarlaPipeCommon::idlePipe(const bool onlyOnce) noexcept
 
     for (;;)
     {
-        readSucess = false;
-        const char* const msg = _readline(true, 0, readSucess);
+        const char* msg;
 
-        if (! readSucess)
-            break;
-        if (msg == nullptr)
-            continue;
+        if (pData->binaryMode)
+        {
+            if (! _readFrame(0))
+                break;
+
+            if (pData->frameType == kPipeFrameControls)
+            {
+                pData->isReading = true;
+
+                for (uint32_t i=0; i + 8 <= pData->frameSize; i += 8)
+                {
+                    pData->controlData = pData->frameData + i;
+                    pData->controlPos = 0;
+
+                    if (! pData->clientClosingDown)
+                    {
+                        try {
+                            msgReceived("control");
+                        } CARLA_SAFE_EXCEPTION("msgReceived");
+                    }
+                }
+
+                pData->controlData = nullptr;
+                pData->isReading = false;
+
+                if (onlyOnce || pData->pipeRecv == INVALID_PIPE_VALUE)
+                    break;
+
+                continue;
+            }
+
+            const char* const line = pData->getFrameAsLine();
+
+            if (line == nullptr)
+                continue;
+
+            // reading the next values reuses the frame buffer, so keep a copy
+            pData->tmpStr = line;
+            msg = pData->tmpStr.getAndReleaseBuffer();
+
+            if (msg == nullptr)
+                continue;
+        }
+        else
+        {
+            readSucess = false;
+            msg = _readline(true, 0, readSucess);
+
+            if (! readSucess)
+                break;
+            if (msg == nullptr)
+                continue;
+        }
 
         pData->isReading = true;
 
@@ -690,6 +830,20 @@ void CarlaPipeCommon::idlePipe(const bool onlyOnce) noexcept
 
 // -------------------------------------------------------------------
 
+void CarlaPipeCommon::setBinaryModeAllowed(const bool allowed) noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(pData->pipeRecv == INVALID_PIPE_VALUE,);
+
+    pData->binaryModeAllowed = allowed;
+}
+
+bool CarlaPipeCommon::isBinaryMode() const noexcept
+{
+    return pData->binaryMode;
+}
+
+// -------------------------------------------------------------------
+
 void CarlaPipeCommon::lockPipe() const noexcept
 {
     pData->writeLock.lock();
@@ -716,6 +870,18 @@ bool CarlaPipeCommon::readNextLineAsBool(bool& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        value = ivalue != 0;
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         value = (std::strcmp(msg, "true") == 0);
@@ -729,6 +895,21 @@ bool CarlaPipeCommon::readNextLineAsByte(uint8_t& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        if (ivalue < 0 || ivalue > 0xFF)
+            return false;
+
+        value = static_cast<uint8_t>(ivalue);
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         const int asint = std::atoi(msg);
@@ -747,6 +928,18 @@ bool CarlaPipeCommon::readNextLineAsInt(int32_t& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        value = static_cast<int32_t>(ivalue);
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         value = std::atoi(msg);
@@ -760,6 +953,21 @@ bool CarlaPipeCommon::readNextLineAsUInt(uint32_t& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        if (ivalue < 0)
+            return false;
+
+        value = static_cast<uint32_t>(ivalue);
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
 #if (defined(__WORDSIZE) && __WORDSIZE < 64) || (defined(__SIZE_WIDTH__) && __SIZE_WIDTH__ < 64) || \
@@ -783,6 +991,18 @@ bool CarlaPipeCommon::readNextLineAsLong(int64_t& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        value = ivalue;
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         value = std::atol(msg);
@@ -796,6 +1016,21 @@ bool CarlaPipeCommon::readNextLineAsULong(uint64_t& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        if (ivalue < 0)
+            return false;
+
+        value = static_cast<uint64_t>(ivalue);
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         const int64_t asint64 = std::atol(msg);
@@ -814,6 +1049,18 @@ bool CarlaPipeCommon::readNextLineAsFloat(float& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        value = static_cast<float>(dvalue);
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         {
@@ -830,6 +1077,18 @@ bool CarlaPipeCommon::readNextLineAsDouble(double& value) const noexcept
 {
     CARLA_SAFE_ASSERT_RETURN(pData->isReading, false);
 
+    if (pData->binaryMode)
+    {
+        int64_t ivalue;
+        double dvalue;
+
+        if (! _readBinaryValue(ivalue, dvalue))
+            return false;
+
+        value = dvalue;
+        return true;
+    }
+
     if (const char* const msg = _readlineblock(false))
     {
         {
@@ -903,6 +1162,10 @@ bool CarlaPipeCommon::writeAndFixMessage(const char* const msg) const noexcept
 
     const std::size_t size(std::strlen(msg));
 
+    // frames can contain newlines, nothing to fix
+    if (pData->binaryMode)
+        return _writeFrame(kPipeFrameString, msg, size);
+
     char* const fixedMsg = static_cast<char*>(std::malloc(size+2));
     CARLA_SAFE_ASSERT_RETURN(fixedMsg != nullptr, false);
 
@@ -985,30 +1248,52 @@ bool CarlaPipeCommon::writeErrorMessage(const char* const error) const noexcept
 
 bool CarlaPipeCommon::writeControlMessage(const uint32_t index, const float value, const bool withWriteLock) const noexcept
 {
+    return writeControlMessages(&index, &value, 1, withWriteLock);
+}
+
+bool CarlaPipeCommon::writeControlMessages(const uint32_t* const indexes, const float* const values, const uint32_t count,
+                                           const bool withWriteLock) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(indexes != nullptr, false);
+    CARLA_SAFE_ASSERT_RETURN(values != nullptr, false);
+
     if (withWriteLock)
     {
         const CarlaMutexLocker cml(pData->writeLock);
-        return writeControlMessage(index, value, false);
+        return writeControlMessages(indexes, values, count, false);
     }
 
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
+    if (pData->binaryMode)
+    {
+        char tmpBuf[kPipeFrameMaxControls * 8];
 
-    if (! _writeMsgBuffer("control\n", 8))
-        return false;
+        for (uint32_t i=0, j, n; i < count; i += n)
+        {
+            n = std::min(count - i, kPipeFrameMaxControls);
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", index);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
-        return false;
+            for (j=0; j < n; ++j)
+            {
+                std::memcpy(tmpBuf + j * 8,     indexes + i + j, 4);
+                std::memcpy(tmpBuf + j * 8 + 4, values  + i + j, 4);
+            }
 
+            if (! _writeFrame(kPipeFrameControls, tmpBuf, n * 8))
+                return false;
+        }
+    }
+    else
     {
-        const ScopedSafeLocale ssl;
-        std::snprintf(tmpBuf, 0xfe, "%.12g\n", static_cast<double>(value));
+        for (uint32_t i=0; i < count; ++i)
+        {
+            if (! _writeMsgBuffer("control\n", 8))
+                return false;
+            if (! _writeIntValue(indexes[i]))
+                return false;
+            if (! _writeFloatValue(values[i]))
+                return false;
+        }
     }
 
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
-        return false;
-
     syncMessages();
     return true;
 }
@@ -1033,16 +1318,12 @@ bool CarlaPipeCommon::writeConfigureMessage(const char* const key, const char* c
 
 bool CarlaPipeCommon::writeProgramMessage(const uint32_t index) const noexcept
 {
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const CarlaMutexLocker cml(pData->writeLock);
 
     if (! _writeMsgBuffer("program\n", 8))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", index);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(index))
         return false;
 
     syncMessages();
@@ -1051,24 +1332,18 @@ bool CarlaPipeCommon::writeProgramMessage(const uint32_t index) const noexcept
 
 bool CarlaPipeCommon::writeProgramMessage(const uint8_t channel, const uint32_t bank, const uint32_t program) const noexcept
 {
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const CarlaMutexLocker cml(pData->writeLock);
 
     if (! _writeMsgBuffer("program\n", 8))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", channel);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(channel))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", bank);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(bank))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", program);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(program))
         return false;
 
     syncMessages();
@@ -1077,20 +1352,15 @@ bool CarlaPipeCommon::writeProgramMessage(const uint8_t channel, const uint32_t
 
 bool CarlaPipeCommon::writeMidiProgramMessage(const uint32_t bank, const uint32_t program) const noexcept
 {
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const CarlaMutexLocker cml(pData->writeLock);
 
     if (! _writeMsgBuffer("midiprogram\n", 12))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", bank);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(bank))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", program);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(program))
         return false;
 
     syncMessages();
@@ -1099,16 +1369,12 @@ bool CarlaPipeCommon::writeMidiProgramMessage(const uint32_t bank, const uint32_
 
 bool CarlaPipeCommon::writeReloadProgramsMessage(const int32_t index) const noexcept
 {
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const CarlaMutexLocker cml(pData->writeLock);
 
     if (! _writeMsgBuffer("reloadprograms\n", 15))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", index);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(index))
         return false;
 
     syncMessages();
@@ -1133,16 +1399,13 @@ bool CarlaPipeCommon::writeMidiNoteMessage(const bool onOff, const uint8_t chann
     if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", channel);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(channel))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", note);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(note))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", velocity);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(velocity))
         return false;
 
     syncMessages();
@@ -1153,9 +1416,6 @@ bool CarlaPipeCommon::writeLv2AtomMessage(const uint32_t index, const LV2_Atom*
 {
     CARLA_SAFE_ASSERT_RETURN(atom != nullptr, false);
 
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const uint32_t atomTotalSize(lv2_atom_total_size(atom));
     String base64atom(String::asBase64(atom, atomTotalSize));
 
@@ -1164,16 +1424,13 @@ bool CarlaPipeCommon::writeLv2AtomMessage(const uint32_t index, const LV2_Atom*
     if (! _writeMsgBuffer("atom\n", 5))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", index);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(index))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", atomTotalSize);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(atomTotalSize))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%lu\n", static_cast<long unsigned>(base64atom.length()));
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(static_cast<int64_t>(base64atom.length())))
         return false;
 
     if (! writeAndFixMessage(base64atom.buffer()))
@@ -1191,21 +1448,13 @@ bool CarlaPipeCommon::writeLv2ParameterMessage(const char* const uri, const floa
         return writeLv2ParameterMessage(uri, value, false);
     }
 
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     if (! _writeMsgBuffer("parameter\n", 10))
         return false;
 
     if (! writeAndFixMessage(uri))
         return false;
 
-    {
-        const ScopedSafeLocale ssl;
-        std::snprintf(tmpBuf, 0xfe, "%.12g\n", static_cast<double>(value));
-    }
-
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeFloatValue(value))
         return false;
 
     syncMessages();
@@ -1217,20 +1466,15 @@ bool CarlaPipeCommon::writeLv2UridMessage(const uint32_t urid, const char* const
     CARLA_SAFE_ASSERT_RETURN(urid != 0, false);
     CARLA_SAFE_ASSERT_RETURN(uri != nullptr && uri[0] != '\0', false);
 
-    char tmpBuf[0xff];
-    tmpBuf[0xfe] = '\0';
-
     const CarlaMutexLocker cml(pData->writeLock);
 
     if (! _writeMsgBuffer("urid\n", 5))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%i\n", urid);
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(urid))
         return false;
 
-    std::snprintf(tmpBuf, 0xfe, "%lu\n", static_cast<long unsigned>(std::strlen(uri)));
-    if (! _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf)))
+    if (! _writeIntValue(static_cast<int64_t>(std::strlen(uri))))
         return false;
 
     if (! writeAndFixMessage(uri))
@@ -1366,6 +1610,28 @@ const char* CarlaPipeCommon::_readlineblock(const bool allocReturn,
                                             const uint16_t size,
                                             const uint32_t timeOutMilliseconds) const noexcept
 {
+    if (pData->binaryMode)
+    {
+        CARLA_SAFE_ASSERT_RETURN(pData->controlData == nullptr, nullptr);
+
+        if (! _readFrame(timeOutMilliseconds))
+        {
+            carla_stderr("readlineblock timed out");
+            return nullptr;
+        }
+
+        const char* const line = pData->getFrameAsLine();
+
+        if (line == nullptr)
+            return nullptr;
+
+        if (! allocReturn)
+            return line;
+
+        pData->tmpStr = line;
+        return pData->tmpStr.getAndReleaseBuffer();
+    }
+
     const uint32_t timeoutEnd = d_gettime_ms() + timeOutMilliseconds;
     bool readSucess;
 
@@ -1408,14 +1674,268 @@ const char* CarlaPipeCommon::_readlineblock(const bool allocReturn,
     return nullptr;
 }
 
+bool CarlaPipeCommon::_readFrame(const uint32_t timeOutMilliseconds) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(pData->pipeRecv != INVALID_PIPE_VALUE, false);
+
+    const uint32_t timeoutEnd = d_gettime_ms() + timeOutMilliseconds;
+    const uint32_t headerSize = sizeof(pData->frameHeader);
+
+    for (;;)
+    {
+        const bool readingHeader = pData->frameHeaderPos < headerSize;
+        char* ptr;
+        uint32_t remaining;
+
+        if (readingHeader)
+        {
+            ptr = reinterpret_cast<char*>(pData->frameHeader) + pData->frameHeaderPos;
+            remaining = headerSize - pData->frameHeaderPos;
+        }
+        else
+        {
+            remaining = pData->frameHeader[0] - pData->frameDataPos;
+
+            if (remaining == 0)
+            {
+                // frame complete, prepare for the next one
+                pData->frameType = pData->frameHeader[1];
+                pData->frameSize = pData->frameHeader[0];
+                pData->frameHeaderPos = 0;
+                pData->frameDataPos = 0;
+
+                char* const data = pData->frameData;
+                data[pData->frameSize] = '\0';
+
+                // same as text mode
+                if (pData->frameType == kPipeFrameString)
+                {
+                    for (uint32_t i=0; i < pData->frameSize; ++i)
+                    {
+                        if (data[i] == '\r')
+                            data[i] = '\n';
+                    }
+                }
+
+                return true;
+            }
+
+            ptr = pData->frameData + pData->frameDataPos;
+        }
+
+        ssize_t ret;
+
+        try {
+           #ifdef CARLA_OS_WIN
+            ret = ReadFileWin32(pData->pipeRecv, pData->ovRecv, ptr, remaining);
+           #else
+            ret = ::read(pData->pipeRecv, ptr, remaining);
+           #endif
+        } CARLA_SAFE_EXCEPTION_RETURN("CarlaPipeCommon::readFrame() - read", false);
+
+        if (ret > 0)
+        {
+            CARLA_SAFE_ASSERT_INT2_RETURN(ret <= static_cast<ssize_t>(remaining), ret, remaining, false);
+
+            if (! readingHeader)
+            {
+                pData->frameDataPos += static_cast<uint32_t>(ret);
+                continue;
+            }
+
+            pData->frameHeaderPos += static_cast<uint32_t>(ret);
+
+            if (pData->frameHeaderPos != headerSize)
+                continue;
+
+            // header complete, make sure the data fits
+            const uint32_t frameSize = pData->frameHeader[0];
+
+            if (frameSize >= kPipeFrameMaxSize)
+            {
+                carla_stderr2("CarlaPipeCommon::_readFrame() - invalid frame size %u, closing pipe", frameSize);
+                pData->pipeClosed = true;
+                return false;
+            }
+
+            if (frameSize + 1 > pData->frameCapacity)
+            {
+                const uint32_t capacity = std::max(frameSize + 1, std::max(pData->frameCapacity * 2, 0x1000U));
+
+                char* const data = static_cast<char*>(std::realloc(pData->frameData, capacity));
+
+                if (data == nullptr)
+                {
+                    carla_stderr2("CarlaPipeCommon::_readFrame() - failed to allocate %u bytes, closing pipe", capacity);
+                    pData->pipeClosed = true;
+                    return false;
+                }
+
+                pData->frameData = data;
+                pData->frameCapacity = capacity;
+            }
+
+            continue;
+        }
+
+        if (timeOutMilliseconds == 0 || d_gettime_ms() >= timeoutEnd)
+            return false;
+
+        d_msleep(5);
+    }
+}
+
+bool CarlaPipeCommon::_readBinaryValue(int64_t& ivalue, double& dvalue) const noexcept
+{
+    // values of a "control" message from a controls frame
+    if (pData->controlData != nullptr)
+    {
+        switch (pData->controlPos++)
+        {
+        case 0: {
+            uint32_t index;
+            std::memcpy(&index, pData->controlData, sizeof(index));
+            ivalue = index;
+            dvalue = index;
+            return true;
+        }
+        case 1: {
+            float value;
+            std::memcpy(&value, pData->controlData + 4, sizeof(value));
+            ivalue = static_cast<int64_t>(value);
+            dvalue = value;
+            return true;
+        }
+        }
+
+        carla_stderr2("CarlaPipeCommon::_readBinaryValue() - reading too many values for a control message");
+        return false;
+    }
+
+    if (! _readFrame(50))
+    {
+        carla_stderr("readlineblock timed out");
+        return false;
+    }
+
+    switch (pData->frameType)
+    {
+    case kPipeFrameString:
+        if (std::strcmp(pData->frameData, "true") == 0)
+        {
+            ivalue = 1;
+            dvalue = 1.0;
+        }
+        else
+        {
+            const ScopedSafeLocale ssl;
+            ivalue = std::strtoll(pData->frameData, nullptr, 10);
+            dvalue = std::atof(pData->frameData);
+        }
+        return true;
+
+    case kPipeFrameInt:
+        std::memcpy(&ivalue, pData->frameData, sizeof(ivalue));
+        dvalue = static_cast<double>(ivalue);
+        return true;
+
+    case kPipeFrameFloat:
+        std::memcpy(&dvalue, pData->frameData, sizeof(dvalue));
+        ivalue = static_cast<int64_t>(dvalue);
+        return true;
+    }
+
+    carla_stderr2("CarlaPipeCommon::_readBinaryValue() - unexpected frame type %u", pData->frameType);
+    return false;
+}
+
 bool CarlaPipeCommon::_writeMsgBuffer(const char* const msg, const std::size_t size) const noexcept
 {
     if (pData->pipeClosed)
         return false;
 
+    if (pData->binaryMode)
+    {
+        // each line becomes its own frame
+        for (std::size_t start = 0; start < size;)
+        {
+            const char* const line = msg + start;
+            const char* const end = static_cast<const char*>(std::memchr(line, '\n', size - start));
+            const std::size_t lineSize = end != nullptr ? static_cast<std::size_t>(end - line) : size - start;
+
+            if (! _writeFrame(kPipeFrameString, line, lineSize))
+                return false;
+
+            start += lineSize + 1;
+        }
+
+        return true;
+    }
+
+    return _writeRawBuffer(msg, size);
+}
+
+bool CarlaPipeCommon::_writeFrame(const uint32_t type, const void* const data, const std::size_t size) const noexcept
+{
+    CARLA_SAFE_ASSERT_RETURN(size < kPipeFrameMaxSize, false);
+
+    if (pData->pipeClosed)
+        return false;
+
+    const uint32_t header[2] = { static_cast<uint32_t>(size), type };
+
+    // small frames are written in one go
+    if (size <= 0xff)
+    {
+        char tmpBuf[sizeof(header) + 0xff];
+        std::memcpy(tmpBuf, header, sizeof(header));
+        std::memcpy(tmpBuf + sizeof(header), data, size);
+
+        return _writeRawBuffer(tmpBuf, sizeof(header) + size);
+    }
+
+    if (! _writeRawBuffer(reinterpret_cast<const char*>(header), sizeof(header)))
+        return false;
+
+    return _writeRawBuffer(static_cast<const char*>(data), size);
+}
+
+bool CarlaPipeCommon::_writeIntValue(const int64_t value) const noexcept
+{
+    if (pData->binaryMode)
+        return _writeFrame(kPipeFrameInt, &value, sizeof(value));
+
+    char tmpBuf[0xff];
+    tmpBuf[0xfe] = '\0';
+
+    std::snprintf(tmpBuf, 0xfe, P_INT64 "\n", value);
+    return _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf));
+}
+
+bool CarlaPipeCommon::_writeFloatValue(const double value) const noexcept
+{
+    if (pData->binaryMode)
+        return _writeFrame(kPipeFrameFloat, &value, sizeof(value));
+
+    char tmpBuf[0xff];
+    tmpBuf[0xfe] = '\0';
+
+    {
+        const ScopedSafeLocale ssl;
+        std::snprintf(tmpBuf, 0xfe, "%.12g\n", value);
+    }
+
+    return _writeMsgBuffer(tmpBuf, std::strlen(tmpBuf));
+}
+
+bool CarlaPipeCommon::_writeRawBuffer(const char* const msg, const std::size_t size) const noexcept
+{
     if (pData->pipeSend == INVALID_PIPE_VALUE)
     {
-        carla_stderr2("CarlaPipe write error, isServer:%s, message was:\n%s", bool2str(pData->isServer), msg);
+        if (pData->binaryMode)
+            carla_stderr2("CarlaPipe write error, isServer:%s", bool2str(pData->isServer));
+        else
+            carla_stderr2("CarlaPipe write error, isServer:%s, message was:\n%s", bool2str(pData->isServer), msg);
         return false;
     }
 
@@ -1427,7 +1947,7 @@ bool CarlaPipeCommon::_writeMsgBuffer(const char* const msg, const std::size_t s
        #else
         ret = ::write(pData->pipeSend, msg, size);
        #endif
-    } CARLA_SAFE_EXCEPTION_RETURN("CarlaPipeCommon::writeMsgBuffer", false);
+    } CARLA_SAFE_EXCEPTION_RETURN("CarlaPipeCommon::writeRawBuffer", false);
 
    #ifdef CARLA_OS_WIN
     if (ret == -2)
@@ -1447,9 +1967,14 @@ bool CarlaPipeCommon::_writeMsgBuffer(const char* const msg, const std::size_t s
     if (! pData->lastMessageFailed)
     {
         pData->lastMessageFailed = true;
-        fprintf(stderr,
-                "CarlaPipeCommon::_writeMsgBuffer(..., " P_SIZE ") - failed with " P_SSIZE " (%s), message was:\n%s",
-                size, ret, bool2str(pData->isServer), msg);
+        if (pData->binaryMode)
+            fprintf(stderr,
+                    "CarlaPipeCommon::_writeRawBuffer(..., " P_SIZE ") - failed with " P_SSIZE " (%s), binary frame\n",
+                    size, ret, bool2str(pData->isServer));
+        else
+            fprintf(stderr,
+                    "CarlaPipeCommon::_writeRawBuffer(..., " P_SIZE ") - failed with " P_SSIZE " (%s), message was:\n%s",
+                    size, ret, bool2str(pData->isServer), msg);
     }
 
     return false;
@@ -1661,10 +2186,22 @@ bool CarlaPipeServer::startPipeServer(const char* const helperTool,
     argv[i++] = pipeSendClientStr;
 
     //-----------------------------------------------------------------------------------------------------------------
-    // start process
+    // start process, asking for binary mode if allowed
+
+    bool started;
+
+    {
+        const CarlaScopedEnvVar sev(kPipeBinaryModeEnvVar, pData->binaryModeAllowed ? "1" : nullptr);
 
 #ifdef CARLA_OS_WIN
-    if (! startProcess(argv, &pData->processInfo))
+        started = startProcess(argv, &pData->processInfo);
+#else
+        started = startProcess(argv, pData->pid);
+#endif
+    }
+
+#ifdef CARLA_OS_WIN
+    if (! started)
     {
         carla_zeroStruct(pData->processInfo);
         pData->processInfo.hProcess = INVALID_HANDLE_VALUE;
@@ -1678,7 +2215,7 @@ bool CarlaPipeServer::startPipeServer(const char* const helperTool,
     CARLA_SAFE_ASSERT(pData->processInfo.hThread  != INVALID_HANDLE_VALUE);
     CARLA_SAFE_ASSERT(pData->processInfo.hProcess != INVALID_HANDLE_VALUE);
 #else
-    if (! startProcess(argv, pData->pid))
+    if (! started)
     {
         pData->pid = -1;
         try { ::close(pipe1[0]); } CARLA_SAFE_EXCEPTION("close(pipe1[0])");
@@ -1707,11 +2244,15 @@ bool CarlaPipeServer::startPipeServer(const char* const helperTool,
     void* const process = nullptr;
 #endif
 
-    if (waitForClientFirstMessage(pipeRecvClient, ovRecv, process, timeOutMilliseconds))
+    bool binaryMode = false;
+
+    if (waitForClientFirstMessage(pipeRecvClient, ovRecv, process, timeOutMilliseconds,
+                                  pData->binaryModeAllowed ? &binaryMode : nullptr))
     {
         pData->pipeRecv = pipeRecvClient;
         pData->pipeSend = pipeSendClient;
         pData->pipeClosed = false;
+        pData->binaryMode = binaryMode;
         carla_debug("ALL OK!");
         return true;
     }
@@ -1816,6 +2357,10 @@ void CarlaPipeServer::closePipeServer() noexcept
 
     const CarlaMutexLocker cml(pData->writeLock);
 
+    pData->binaryMode = false;
+    pData->frameHeaderPos = 0;
+    pData->frameDataPos = 0;
+
     if (pData->pipeRecv != INVALID_PIPE_VALUE)
     {
 #ifdef CARLA_OS_WIN
@@ -1937,6 +2482,31 @@ bool CarlaPipeClient::initPipeClient(const char* argv[]) noexcept
     pData->pipeClosed = false;
     pData->clientClosingDown = false;
 
+    //----------------------------------------------------------------
+    // accept binary mode if requested by the server
+
+    const char* const binaryModeEnv = std::getenv(kPipeBinaryModeEnvVar);
+
+    if (binaryModeEnv != nullptr)
+    {
+        // do not pass it on to our own child processes
+        const bool requested = std::strcmp(binaryModeEnv, "1") == 0;
+        carla_unsetenv(kPipeBinaryModeEnvVar);
+
+        if (requested && pData->binaryModeAllowed)
+        {
+            const char msg[3] = { kPipeBinaryModeAck, '\n', '\0' };
+
+            if (_writeMsgBuffer(msg, 2))
+            {
+                syncMessages();
+                pData->binaryMode = true;
+            }
+
+            return true;
+        }
+    }
+
     if (writeMessage("\n", 1))
         syncMessages();
 
@@ -1951,6 +2521,10 @@ void CarlaPipeClient::closePipeClient() noexcept
 
     const CarlaMutexLocker cml(pData->writeLock);
 
+    pData->binaryMode = false;
+    pData->frameHeaderPos = 0;
+    pData->frameDataPos = 0;
+
     if (pData->pipeRecv != INVALID_PIPE_VALUE)
     {
 #ifdef CARLA_OS_WIN
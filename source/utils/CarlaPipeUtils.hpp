@@ -71,6 +71,21 @@ public:
      */
     void idlePipe(bool onlyOnce = false) noexcept;
 
+    // -------------------------------------------------------------------
+    // binary mode
+
+    /*!
+     * Allow messages to be sent as binary frames instead of text lines.
+     * Both sides of the pipe need to allow it, this is negotiated when the pipe starts.
+     * Must be called before startPipeServer() or initPipeClient().
+     */
+    void setBinaryModeAllowed(bool allowed) noexcept;
+
+    /*!
+     * Check if messages are being sent as binary frames.
+     */
+    bool isBinaryMode() const noexcept;
+
     // -------------------------------------------------------------------
     // write lock
 
@@ -193,6 +208,13 @@ public:
      */
     bool writeControlMessage(uint32_t index, float value, bool withWriteLock = true) const noexcept;
 
+    /*!
+     * Write several "control" messages at once.
+     * In binary mode these are packed together, otherwise it is the same as writing them one by one.
+     */
+    bool writeControlMessages(const uint32_t* indexes, const float* values, uint32_t count,
+                              bool withWriteLock = true) const noexcept;
+
     /*!
      * Write a "configure" message used for state changes.
      */
@@ -252,9 +274,27 @@ protected:
     /*! @internal */
     const char* _readlineblock(bool allocReturn, uint16_t size = 0, uint32_t timeOutMilliseconds = 50) const noexcept;
 
+    /*! @internal */
+    bool _readFrame(uint32_t timeOutMilliseconds) const noexcept;
+
+    /*! @internal */
+    bool _readBinaryValue(int64_t& ivalue, double& dvalue) const noexcept;
+
     /*! @internal */
     bool _writeMsgBuffer(const char* msg, std::size_t size) const noexcept;
 
+    /*! @internal */
+    bool _writeFrame(uint32_t type, const void* data, std::size_t size) const noexcept;
+
+    /*! @internal */
+    bool _writeIntValue(int64_t value) const noexcept;
+
+    /*! @internal */
+    bool _writeFloatValue(double value) const noexcept;
+
+    /*! @internal */
+    bool _writeRawBuffer(const char* msg, std::size_t size) const noexcept;
+
     CARLA_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CarlaPipeCommon)
 };
 
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_PROCESS_TIME_UTILS_HPP_INCLUDED
+#define CARLA_PROCESS_TIME_UTILS_HPP_INCLUDED
+
+#include "CarlaUtils.hpp"
+
+#ifdef CARLA_OS_MAC
+# include <mach/mach_time.h>
+#elif !defined(CARLA_OS_WIN)
+# include <time.h>
+#endif
+
+// -----------------------------------------------------------------------
+// get monotonic time in nanoseconds, realtime safe
+
+static inline
+uint64_t carla_getMonotonicTimeNs() noexcept
+{
+#if defined(CARLA_OS_MAC)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#elif defined(CARLA_OS_WIN)
+    static LARGE_INTEGER frequency = {};
+
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    return static_cast<uint64_t>(static_cast<double>(counter.QuadPart) * 1000000000.0 / static_cast<double>(frequency.QuadPart));
+#else
+    struct timespec ts;
+   #ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+   #else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+   #endif
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+// -----------------------------------------------------------------------
+// CarlaProcessTimeStats
+//
+// Rolling DSP load statistics of a single plugin, as a percentage of the audio block duration.
+// Loads are collected into a histogram over a window of 1 second of audio, which is then published
+// as a whole and a new window starts. Readers always see the last complete window.
+// Must only be written from the audio thread processing the plugin, can be read from any thread without locking.
+
+class CarlaProcessTimeStats
+{
+public:
+    static const uint32_t kNumBuckets    = 256; // last bucket collects everything above
+    static const uint32_t kBucketsPerPct = 2;
+
+    CarlaProcessTimeStats() noexcept
+        : fCurrent(),
+          fCurrentDuration(0.0),
+          fPublished(),
+          fSequence(0)
+    {
+        carla_zeroStruct(fCurrent);
+        carla_zeroStruct(fPublished);
+    }
+
+    // must be called from the audio thread, or while the plugin is not processing
+    void reset() noexcept
+    {
+        carla_zeroStruct(fCurrent);
+        fCurrentDuration = 0.0;
+        publish();
+    }
+
+    // must be called from the audio thread, after processing a block
+    void addRT(const uint64_t timeNs, const uint32_t frames, const double sampleRate) noexcept
+    {
+        CARLA_SAFE_ASSERT_RETURN(frames > 0 && sampleRate > 0.0,);
+
+        const double blockDuration = static_cast<double>(frames) / sampleRate;
+        const float load = static_cast<float>(static_cast<double>(timeNs) / 10000000.0 / blockDuration);
+        const uint32_t bucket = static_cast<uint32_t>(load * static_cast<float>(kBucketsPerPct));
+
+        ++fCurrent.buckets[std::min(bucket, kNumBuckets - 1)];
+        ++fCurrent.count;
+        fCurrent.sum += load;
+
+        if (load > fCurrent.max)
+            fCurrent.max = load;
+
+        fCurrentDuration += blockDuration;
+
+        if (fCurrentDuration >= 1.0)
+        {
+            publish();
+            carla_zeroStruct(fCurrent);
+            fCurrentDuration = 0.0;
+        }
+    }
+
+    // returns false if the last window had no processed blocks
+    bool getLoads(float& meanLoad, float& p99Load, float& maxLoad, uint32_t& blockCount) const noexcept
+    {
+        Window window;
+
+        for (uint32_t tries = 0;; ++tries)
+        {
+            const uint32_t seq = __atomic_load_n(&fSequence, __ATOMIC_ACQUIRE);
+
+            if ((seq & 1) == 0)
+            {
+                std::memcpy(&window, &fPublished, sizeof(Window));
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+                if (__atomic_load_n(&fSequence, __ATOMIC_RELAXED) == seq)
+                    break;
+            }
+
+            // the writer only publishes once per second, so this is never expected to happen for long
+            if (tries == 100)
+                return false;
+        }
+
+        blockCount = window.count;
+
+        if (window.count == 0)
+        {
+            meanLoad = p99Load = maxLoad = 0.0f;
+            return false;
+        }
+
+        meanLoad = window.sum / static_cast<float>(window.count);
+        maxLoad  = window.max;
+        p99Load  = maxLoad;
+
+        // upper limit of the bucket where 99% of the blocks are reached
+        const uint32_t target = window.count - window.count / 100;
+
+        for (uint32_t i=0, sum=0; i < kNumBuckets - 1; ++i)
+        {
+            sum += window.buckets[i];
+
+            if (sum >= target)
+            {
+                p99Load = std::min(maxLoad, static_cast<float>(i + 1) / static_cast<float>(kBucketsPerPct));
+                break;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    struct Window {
+        uint32_t buckets[kNumBuckets];
+        uint32_t count;
+        float sum;
+        float max;
+    };
+
+    // audio thread only
+    Window fCurrent;
+    double fCurrentDuration;
+
+    // shared with readers, protected by fSequence being odd while written
+    Window fPublished;
+    uint32_t fSequence;
+
+    void publish() noexcept
+    {
+        __atomic_store_n(&fSequence, fSequence + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        std::memcpy(&fPublished, &fCurrent, sizeof(Window));
+
+        __atomic_store_n(&fSequence, fSequence + 1, __ATOMIC_RELEASE);
+    }
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaProcessTimeStats)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // CARLA_PROCESS_TIME_UTILS_HPP_INCLUDED
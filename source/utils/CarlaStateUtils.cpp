@@ -4,9 +4,12 @@
 #include "CarlaStateUtils.hpp"
 
 #include "CarlaBackendUtils.hpp"
+#include "CarlaBinaryProjectUtils.hpp"
 #include "CarlaMathUtils.hpp"
 #include "CarlaMIDI.h"
 
+#include "extra/Base64.hpp"
+
 #include "water/streams/MemoryOutputStream.h"
 #include "water/xml/XmlElement.h"
 
@@ -192,6 +195,8 @@ CarlaStateSave::CarlaStateSave() noexcept
       currentMidiBank(-1),
       currentMidiProgram(-1),
       chunk(nullptr),
+      chunkData(nullptr),
+      chunkDataSize(0),
       parameters(),
       customData() {}
 
@@ -232,6 +237,13 @@ void CarlaStateSave::clear() noexcept
         delete[] chunk;
         chunk = nullptr;
     }
+    if (chunkData != nullptr)
+    {
+        delete[] chunkData;
+        chunkData = nullptr;
+    }
+
+    chunkDataSize = 0;
 
     uniqueId = 0;
     options  = PLUGIN_OPTIONS_NULL;
@@ -269,7 +281,7 @@ void CarlaStateSave::clear() noexcept
 // -----------------------------------------------------------------------
 // fillFromXmlElement
 
-bool CarlaStateSave::fillFromXmlElement(const XmlElement* const xmlElement)
+bool CarlaStateSave::fillFromXmlElement(const XmlElement* const xmlElement, CarlaBinaryProjectReader* const reader)
 {
     CARLA_SAFE_ASSERT_RETURN(xmlElement != nullptr, false);
 
@@ -530,6 +542,24 @@ bool CarlaStateSave::fillFromXmlElement(const XmlElement* const xmlElement)
                 {
                     chunk = carla_strdup(text.toRawUTF8());
                 }
+                else if (tag == "ChunkBlob")
+                {
+                    CARLA_SAFE_ASSERT_CONTINUE(reader != nullptr);
+
+                    std::vector<uint8_t> data;
+                    const int index = text.getIntValue();
+
+                    if (index > 0 && reader->readBlob(static_cast<uint>(index), data) && ! data.empty())
+                    {
+                        chunkData = new uint8_t[data.size()];
+                        chunkDataSize = data.size();
+                        std::memcpy(chunkData, data.data(), data.size());
+                    }
+                    else
+                    {
+                        carla_stderr("Reading ChunkBlob %i failed", index);
+                    }
+                }
             }
         }
     }
@@ -540,7 +570,7 @@ bool CarlaStateSave::fillFromXmlElement(const XmlElement* const xmlElement)
 // -----------------------------------------------------------------------
 // fillXmlStringFromStateSave
 
-void CarlaStateSave::dumpToMemoryStream(MemoryOutputStream& content) const
+void CarlaStateSave::dumpToMemoryStream(MemoryOutputStream& content, CarlaBinaryProjectWriter* const writer) const
 {
     const PluginType pluginType = getPluginTypeFromString(type);
 
@@ -742,10 +772,31 @@ void CarlaStateSave::dumpToMemoryStream(MemoryOutputStream& content) const
         content << customDataXml;
     }
 
-    if (chunk != nullptr && chunk[0] != '\0')
+    if (writer != nullptr && (chunkData != nullptr || (chunk != nullptr && chunk[0] != '\0')))
+    {
+        uint index;
+
+        if (chunkData != nullptr)
+        {
+            index = writer->addBlob(chunkData, chunkDataSize);
+        }
+        else
+        {
+            std::vector<uint8_t> data;
+            d_getChunkFromBase64String_impl(data, chunk);
+            index = writer->addBlob(data.data(), data.size());
+        }
+
+        content << "\n   <ChunkBlob>" << water::String(index) << "</ChunkBlob>\n";
+    }
+    else if (chunkData != nullptr || (chunk != nullptr && chunk[0] != '\0'))
     {
         MemoryOutputStream chunkXml, chunkSplt;
-        getNewLineSplittedString(chunkSplt, chunk);
+
+        if (chunkData != nullptr)
+            getNewLineSplittedString(chunkSplt, String::asBase64(chunkData, chunkDataSize).buffer());
+        else
+            getNewLineSplittedString(chunkSplt, chunk);
 
         chunkXml << "\n   <Chunk>\n";
         chunkXml << chunkSplt;
@@ -11,6 +11,9 @@
 
 CARLA_BACKEND_START_NAMESPACE
 
+class CarlaBinaryProjectReader;
+class CarlaBinaryProjectWriter;
+
 // -----------------------------------------------------------------------
 
 struct CarlaStateSave {
@@ -78,6 +81,10 @@ struct CarlaStateSave {
     int32_t     currentMidiProgram;
     const char* chunk;
 
+    // raw chunk as retrieved from the plugin, takes precedence over the base64 encoded one
+    uint8_t*    chunkData;
+    std::size_t chunkDataSize;
+
     ParameterList parameters;
     CustomDataList customData;
 
@@ -85,8 +92,8 @@ struct CarlaStateSave {
     ~CarlaStateSave() noexcept;
     void clear() noexcept;
 
-    bool fillFromXmlElement(const water::XmlElement* const xmlElement);
-    void dumpToMemoryStream(water::MemoryOutputStream& stream) const;
+    bool fillFromXmlElement(const water::XmlElement* const xmlElement, CarlaBinaryProjectReader* reader = nullptr);
+    void dumpToMemoryStream(water::MemoryOutputStream& stream, CarlaBinaryProjectWriter* writer = nullptr) const;
 
     CARLA_DECLARE_NON_COPYABLE(CarlaStateSave)
 };
@@ -91,6 +91,86 @@ FILE* __carla_fopen(const char* const filename, FILE* const fallback) noexcept
 #endif
 }
 
+/*
+ * Log levels, matching the print functions below.
+ */
+enum CarlaLogLevel {
+    kCarlaLogLevelDebug = 0, // carla_debug
+    kCarlaLogLevelInfo,      // carla_stdout
+    kCarlaLogLevelWarning,   // carla_stderr
+    kCarlaLogLevelError      // carla_stderr2
+};
+
+/*
+ * Optional hook for the print functions below, so messages can be sent somewhere else than stdout/stderr.
+ * Must return true if the message was handled (or purposefully discarded), false to print it as usual.
+ * Must not block, as print functions can be called from any thread, including the audio one.
+ */
+typedef bool (*CarlaLogHookFunc)(void* ptr, int level, const char* fmt, va_list args);
+
+struct CarlaLogHook {
+    CarlaLogHookFunc func;
+    void* ptr;
+    int calls; // number of calls in progress
+};
+
+/*
+ * Internal log hook storage, shared within the same binary.
+ */
+inline
+CarlaLogHook& __carla_log_hook() noexcept
+{
+    static CarlaLogHook hook = { nullptr, nullptr, 0 };
+    return hook;
+}
+
+/*
+ * Set or remove (by passing null) the log hook.
+ * Waits for calls to the previous hook to finish, so its data can be safely deleted afterwards.
+ * Must not be called from within a hook.
+ */
+static inline
+void carla_set_log_hook(const CarlaLogHookFunc func, void* const ptr) noexcept
+{
+    CarlaLogHook& hook(__carla_log_hook());
+
+    __atomic_store_n(&hook.func, static_cast<CarlaLogHookFunc>(nullptr), __ATOMIC_SEQ_CST);
+
+    // hooks never block, so this is short
+    while (__atomic_load_n(&hook.calls, __ATOMIC_SEQ_CST) != 0) {}
+
+    __atomic_store_n(&hook.ptr, ptr, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&hook.func, func, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Get the data pointer of the current log hook.
+ */
+static inline
+void* carla_get_log_hook_ptr() noexcept
+{
+    return __atomic_load_n(&__carla_log_hook().ptr, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Internal function to pass a message to the log hook, if there is one.
+ */
+static inline
+bool __carla_log_hook_call(const int level, const char* const fmt, va_list args) noexcept
+{
+    CarlaLogHook& hook(__carla_log_hook());
+
+    __atomic_add_fetch(&hook.calls, 1, __ATOMIC_SEQ_CST);
+
+    bool handled = false;
+
+    if (const CarlaLogHookFunc func = __atomic_load_n(&hook.func, __ATOMIC_SEQ_CST))
+        handled = func(__atomic_load_n(&hook.ptr, __ATOMIC_SEQ_CST), level, fmt, args);
+
+    __atomic_sub_fetch(&hook.calls, 1, __ATOMIC_SEQ_CST);
+    return handled;
+}
+
 /*
  * Print a string to stdout with newline (gray color).
  * Does nothing if DEBUG is not defined.
@@ -107,6 +187,12 @@ void carla_debug(const char* const fmt, ...) noexcept
         va_list args;
         va_start(args, fmt);
 
+        if (output == stdout && __carla_log_hook_call(kCarlaLogLevelDebug, fmt, args))
+        {
+            va_end(args);
+            return;
+        }
+
         if (output == stdout)
         {
 #ifdef CARLA_OS_MAC
@@ -141,6 +227,13 @@ void carla_stdout(const char* const fmt, ...) noexcept
     try {
         va_list args;
         va_start(args, fmt);
+
+        if (output == stdout && __carla_log_hook_call(kCarlaLogLevelInfo, fmt, args))
+        {
+            va_end(args);
+            return;
+        }
+
         std::fprintf(output, "[carla] ");
         std::vfprintf(output, fmt, args);
         std::fprintf(output, "\n");
@@ -163,6 +256,13 @@ void carla_stderr(const char* const fmt, ...) noexcept
     try {
         va_list args;
         va_start(args, fmt);
+
+        if (output == stderr && __carla_log_hook_call(kCarlaLogLevelWarning, fmt, args))
+        {
+            va_end(args);
+            return;
+        }
+
         std::fprintf(output, "[carla] ");
         std::vfprintf(output, fmt, args);
         std::fprintf(output, "\n");
@@ -186,6 +286,12 @@ void carla_stderr2(const char* const fmt, ...) noexcept
         va_list args;
         va_start(args, fmt);
 
+        if (output == stderr && __carla_log_hook_call(kCarlaLogLevelError, fmt, args))
+        {
+            va_end(args);
+            return;
+        }
+
         if (output == stderr)
         {
             std::fprintf(output, "\x1b[31m[carla] ");
@@ -0,0 +1,401 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "CarlaXmlStreamUtils.hpp"
+
+#include "water/files/FileInputStream.h"
+#include "water/streams/MemoryInputStream.h"
+#include "water/xml/XmlDocument.h"
+#include "water/xml/XmlElement.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------
+
+CarlaXmlStreamReader::CarlaXmlStreamReader(const water::File& file)
+    : fStream(),
+      fBufferPos(0),
+      fBufferSize(0),
+      fElementData(),
+      fElementSize(0),
+      fInsideRoot(false),
+      fLastError(nullptr)
+{
+    water::FileInputStream* const stream = new water::FileInputStream(file);
+
+    if (stream->openedOk())
+    {
+        fStream = stream;
+    }
+    else
+    {
+        delete stream;
+        fLastError = "Failed to open file";
+    }
+}
+
+CarlaXmlStreamReader::CarlaXmlStreamReader(const void* const data, const std::size_t dataSize)
+    : fStream(new water::MemoryInputStream(data, dataSize, false)),
+      fBufferPos(0),
+      fBufferSize(0),
+      fElementData(),
+      fElementSize(0),
+      fInsideRoot(false),
+      fLastError(nullptr)
+{
+}
+
+CarlaXmlStreamReader::~CarlaXmlStreamReader()
+{
+}
+
+// -----------------------------------------------------------------------
+
+water::XmlElement* CarlaXmlStreamReader::readRootElement()
+{
+    CARLA_SAFE_ASSERT_RETURN(fStream != nullptr, nullptr);
+    CARLA_SAFE_ASSERT_RETURN(! fInsideRoot, nullptr);
+
+    char c;
+
+    // skip UTF-8 BOM
+    if (peekChar(c) && static_cast<uint8_t>(c) == 0xef)
+    {
+        readChar(c);
+        readChar(c);
+        readChar(c);
+    }
+
+    for (;;)
+    {
+        if (! readChar(c))
+        {
+            fLastError = "Document has no root element";
+            return nullptr;
+        }
+
+        if (c != '<')
+            continue;
+
+        if (! peekChar(c))
+            break;
+
+        if (c == '?')
+        {
+            if (! skipUntil("?>", false))
+                break;
+            continue;
+        }
+
+        if (c == '!')
+        {
+            readChar(c);
+
+            if (peekChar(c) && c == '-')
+            {
+                if (! skipUntil("-->", false))
+                    break;
+                continue;
+            }
+
+            // doctype, might contain an internal subset between brackets
+            int brackets = 0;
+
+            while (readChar(c))
+            {
+                /**/ if (c == '[')
+                    ++brackets;
+                else if (c == ']')
+                    --brackets;
+                else if (c == '>' && brackets <= 0)
+                    break;
+            }
+
+            continue;
+        }
+
+        fElementSize = 0;
+        appendChar('<');
+
+        bool selfClosing;
+        if (! readTag(selfClosing))
+            break;
+
+        // turn start tag into an empty element, so it can be parsed on its own
+        if (! selfClosing)
+        {
+            --fElementSize;
+            appendChar('/');
+            appendChar('>');
+        }
+
+        water::XmlElement* const root = parseElementData();
+
+        fInsideRoot = root != nullptr && ! selfClosing;
+        return root;
+    }
+
+    fLastError = "Unexpected end of document";
+    return nullptr;
+}
+
+water::XmlElement* CarlaXmlStreamReader::readNextElement()
+{
+    if (! fInsideRoot)
+        return nullptr;
+
+    fElementSize = 0;
+
+    int depth = 0;
+    char c;
+
+    while (readChar(c))
+    {
+        // text between children of the root element is not needed
+        if (c != '<')
+        {
+            if (depth != 0)
+            {
+                appendChar(c);
+                appendText();
+            }
+            continue;
+        }
+
+        if (! peekChar(c))
+            break;
+
+        // comments, CDATA and declarations
+        if (c == '!')
+        {
+            readChar(c);
+
+            const bool append = depth != 0;
+
+            if (append)
+            {
+                appendChar('<');
+                appendChar('!');
+            }
+
+            if (! peekChar(c))
+                break;
+
+            const char* const terminator = c == '-' ? "-->" : c == '[' ? "]]>" : ">";
+
+            if (! skipUntil(terminator, append))
+                break;
+
+            continue;
+        }
+
+        // processing instructions
+        if (c == '?')
+        {
+            const bool append = depth != 0;
+
+            if (append)
+                appendChar('<');
+
+            if (! skipUntil("?>", append))
+                break;
+
+            continue;
+        }
+
+        // end tag
+        if (c == '/')
+        {
+            if (depth == 0)
+            {
+                // end of root element
+                skipUntil(">", false);
+                fInsideRoot = false;
+                return nullptr;
+            }
+
+            appendChar('<');
+
+            if (! skipUntil(">", true))
+                break;
+
+            if (--depth == 0)
+                return parseElementData();
+
+            continue;
+        }
+
+        // start tag
+        appendChar('<');
+
+        bool selfClosing;
+        if (! readTag(selfClosing))
+            break;
+
+        if (! selfClosing)
+            ++depth;
+        else if (depth == 0)
+            return parseElementData();
+    }
+
+    fLastError = "Unexpected end of document";
+    fInsideRoot = false;
+    return nullptr;
+}
+
+bool CarlaXmlStreamReader::readAllElements(water::XmlElement& root)
+{
+    while (water::XmlElement* const elem = readNextElement())
+        root.addChildElement(elem);
+
+    return fLastError == nullptr;
+}
+
+const char* CarlaXmlStreamReader::getLastError() const noexcept
+{
+    return fLastError;
+}
+
+// -----------------------------------------------------------------------
+
+bool CarlaXmlStreamReader::readChar(char& c)
+{
+    if (! peekChar(c))
+        return false;
+
+    ++fBufferPos;
+    return true;
+}
+
+bool CarlaXmlStreamReader::peekChar(char& c)
+{
+    if (fBufferPos >= fBufferSize)
+    {
+        if (fStream == nullptr)
+            return false;
+
+        fBufferPos = 0;
+        fBufferSize = fStream->read(fBuffer, sizeof(fBuffer));
+
+        if (fBufferSize <= 0)
+        {
+            fBufferSize = 0;
+            return false;
+        }
+    }
+
+    c = fBuffer[fBufferPos];
+    return true;
+}
+
+void CarlaXmlStreamReader::appendChar(const char c)
+{
+    if (fElementSize >= fElementData.getSize())
+        fElementData.setSize(std::max(static_cast<std::size_t>(4096), fElementData.getSize() * 2));
+
+    static_cast<char*>(fElementData.getData())[fElementSize++] = c;
+}
+
+void CarlaXmlStreamReader::appendText()
+{
+    // copy everything up to the next tag in one go, this is where big chunks of data are
+    for (;;)
+    {
+        char c;
+        if (! peekChar(c))
+            return;
+
+        const char* const start = fBuffer + fBufferPos;
+        const char* const tag = static_cast<const char*>(std::memchr(start, '<', static_cast<std::size_t>(fBufferSize - fBufferPos)));
+        const std::size_t size = tag != nullptr ? static_cast<std::size_t>(tag - start)
+                                                : static_cast<std::size_t>(fBufferSize - fBufferPos);
+
+        if (fElementSize + size > fElementData.getSize())
+            fElementData.setSize(std::max(fElementSize + size, fElementData.getSize() * 2));
+
+        std::memcpy(static_cast<char*>(fElementData.getData()) + fElementSize, start, size);
+        fElementSize += size;
+        fBufferPos += static_cast<int>(size);
+
+        if (tag != nullptr)
+            return;
+    }
+}
+
+bool CarlaXmlStreamReader::skipUntil(const char* const terminator, const bool append)
+{
+    const std::size_t terminatorLen = std::strlen(terminator);
+    CARLA_SAFE_ASSERT_RETURN(terminatorLen > 0 && terminatorLen <= 3, false);
+
+    char window[3] = { '\0', '\0', '\0' };
+    std::size_t count = 0;
+    char c;
+
+    while (readChar(c))
+    {
+        if (append)
+            appendChar(c);
+
+        window[0] = window[1];
+        window[1] = window[2];
+        window[2] = c;
+
+        if (++count >= terminatorLen && std::memcmp(window + 3 - terminatorLen, terminator, terminatorLen) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool CarlaXmlStreamReader::readTag(bool& selfClosing)
+{
+    char quote = '\0';
+    char last = '\0';
+    char c;
+
+    while (readChar(c))
+    {
+        appendChar(c);
+
+        if (quote != '\0')
+        {
+            if (c == quote)
+                quote = '\0';
+            continue;
+        }
+
+        if (c == '"' || c == '\'')
+        {
+            quote = c;
+            continue;
+        }
+
+        if (c == '>')
+        {
+            selfClosing = last == '/';
+            return true;
+        }
+
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n')
+            last = c;
+    }
+
+    return false;
+}
+
+water::XmlElement* CarlaXmlStreamReader::parseElementData()
+{
+    water::XmlDocument xml(water::String::fromUTF8(static_cast<const char*>(fElementData.getData()),
+                                                   static_cast<int>(fElementSize)));
+
+    if (water::XmlElement* const elem = xml.getDocumentElement())
+        return elem;
+
+    carla_stderr2("CarlaXmlStreamReader::parseElementData() - %s", xml.getLastParseError().toRawUTF8());
+
+    fLastError = "Failed to parse document";
+    fInsideRoot = false;
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2011-2025 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef CARLA_XML_STREAM_UTILS_HPP_INCLUDED
+#define CARLA_XML_STREAM_UTILS_HPP_INCLUDED
+
+#include "CarlaUtils.hpp"
+
+#include "extra/ScopedPointer.hpp"
+
+#include "water/memory/MemoryBlock.h"
+
+namespace water {
+class File;
+class InputStream;
+class XmlElement;
+}
+
+// -----------------------------------------------------------------------
+// CarlaXmlStreamReader
+//
+// Pull-style reader for documents made of a root element with many large children, like Carla projects.
+// Instead of building the DOM of the whole document, each direct child of the root element is parsed
+// on its own when requested, so that only one of them needs to be in memory at a time.
+//
+// The document is read in small chunks as needed.
+// Text, comments and processing instructions between children of the root element are skipped.
+
+class CarlaXmlStreamReader
+{
+public:
+    explicit CarlaXmlStreamReader(const water::File& file);
+    CarlaXmlStreamReader(const void* data, std::size_t dataSize);
+    ~CarlaXmlStreamReader();
+
+    // read everything up to and including the start tag of the root element
+    // returns an element with the tag name and attributes of the root, but no children, caller takes ownership
+    water::XmlElement* readRootElement();
+
+    // read and parse the next direct child of the root element, caller takes ownership
+    // returns null once the end of the root element is reached, or on errors (see getLastError())
+    water::XmlElement* readNextElement();
+
+    // read all remaining children of the root element, adding them to the given element
+    bool readAllElements(water::XmlElement& root);
+
+    const char* getLastError() const noexcept;
+
+private:
+    ScopedPointer<water::InputStream> fStream;
+
+    char fBuffer[16384];
+    int fBufferPos;
+    int fBufferSize;
+
+    water::MemoryBlock fElementData;
+    std::size_t fElementSize;
+
+    bool fInsideRoot;
+    const char* fLastError;
+
+    bool readChar(char& c);
+    bool peekChar(char& c);
+    void appendChar(char c);
+    void appendText();
+
+    bool skipUntil(const char* terminator, bool append);
+    bool readTag(bool& selfClosing);
+
+    water::XmlElement* parseElementData();
+
+    CARLA_DECLARE_NON_COPYABLE(CarlaXmlStreamReader)
+};
+
+// -----------------------------------------------------------------------
+
+#endif // CARLA_XML_STREAM_UTILS_HPP_INCLUDED